@@ -0,0 +1,134 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/filesystem/async_io.h>
+#include <magic/futures/get.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Random 4 KiB reads: blocking pread on one thread vs AsyncIo backends
+// with a fixed number of reads in flight (queue depth)
+
+// O_DIRECT bypasses the page cache when the filesystem supports it,
+// otherwise the file is read through the cache and the run measures
+// the per-operation overhead of each path rather than the device
+
+static const char* kPath = "async_io_benchmark.bin";
+static const size_t kFileSize = 256 << 20;
+static const size_t kBlock = 4096;
+static const size_t kReads = 100'000;
+
+//////////////////////////////////////////////////////////////////////
+
+static void GenerateFile(const char* path, size_t size) {
+  const int fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  WHEELS_VERIFY(fd >= 0, "Cannot create the file");
+  std::vector<char> chunk(1 << 20);
+  std::mt19937 engine(42);
+  for (auto& c : chunk) {
+    c = static_cast<char>(engine());
+  }
+  for (size_t written = 0; written < size; written += chunk.size()) {
+    WHEELS_VERIFY(::write(fd, chunk.data(), chunk.size()) == ssize_t(chunk.size()), "Short write");
+  }
+  ::fsync(fd);
+  ::close(fd);
+}
+
+static std::vector<uint64_t> RandomOffsets() {
+  std::mt19937_64 engine(7);
+  std::uniform_int_distribution<uint64_t> block(0, kFileSize / kBlock - 1);
+  std::vector<uint64_t> offsets(kReads);
+  for (auto& offset : offsets) {
+    offset = block(engine) * kBlock;
+  }
+  return offsets;
+}
+
+// Aligned for O_DIRECT
+static std::unique_ptr<char, decltype(&std::free)> AllocateBuffers(size_t count) {
+  return {static_cast<char*>(std::aligned_alloc(kBlock, count * kBlock)), &std::free};
+}
+
+static double BlockingIops(int fd, const std::vector<uint64_t>& offsets) {
+  auto buffer = AllocateBuffers(1);
+  Stopwatch stopwatch;
+  for (auto offset : offsets) {
+    WHEELS_VERIFY(::pread(fd, buffer.get(), kBlock, offset) == kBlock, "Short read");
+  }
+  return offsets.size() / stopwatch.Elapsed().count();
+}
+
+// Keeps `depth` reads in flight, a slot is refilled as soon as its read completes
+static double AsyncIops(AsyncIo& io, int fd, const std::vector<uint64_t>& offsets, size_t depth) {
+  auto buffers = AllocateBuffers(depth);
+  std::vector<std::optional<Future<size_t>>> slots(depth);
+
+  Stopwatch stopwatch;
+  size_t next = 0;
+  for (size_t slot = 0; slot < depth && next < offsets.size(); ++slot, ++next) {
+    slots[slot].emplace(io.Read(fd, {buffers.get() + slot * kBlock, kBlock}, offsets[next]));
+  }
+  for (size_t done = 0; done < offsets.size(); ++done) {
+    const size_t slot = done % depth;
+    WHEELS_VERIFY(futures::WaitValue(std::move(*slots[slot])) == kBlock, "Short read");
+    slots[slot].reset();
+    if (next < offsets.size()) {
+      slots[slot].emplace(io.Read(fd, {buffers.get() + slot * kBlock, kBlock}, offsets[next++]));
+    }
+  }
+  return offsets.size() / stopwatch.Elapsed().count();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  GenerateFile(kPath, kFileSize);
+  const auto offsets = RandomOffsets();
+
+  int fd = ::open(kPath, O_RDONLY | O_DIRECT);
+  const bool direct = fd >= 0;
+  if (!direct) {
+    fd = ::open(kPath, O_RDONLY);
+  }
+
+  fmt::println("File: {} MiB, {} random {} B reads, {}", kFileSize >> 20, kReads, kBlock,
+               direct ? "O_DIRECT" : "page cache (O_DIRECT unsupported)");
+  fmt::println("Default backend: {}",
+               AsyncIo::DefaultBackend() == AsyncIo::Backend::IoUring ? "io_uring" : "thread pool");
+  fmt::println("{:>24} | {:>6} | {:>12}", "Path", "Depth", "IOPS");
+
+  fmt::println("{:>24} | {:>6} | {:>12.0f}", "blocking pread", 1, BlockingIops(fd, offsets));
+
+  std::vector<std::pair<const char*, AsyncIo::Backend>> backends = {
+      {"AsyncIo thread pool", AsyncIo::Backend::ThreadPool}};
+  if (AsyncIo::DefaultBackend() == AsyncIo::Backend::IoUring) {
+    backends.insert(backends.begin(), {"AsyncIo io_uring", AsyncIo::Backend::IoUring});
+  }
+
+  for (auto [name, backend] : backends) {
+    AsyncIo io{backend};
+    for (size_t depth : {1, 8, 32, 128}) {
+      fmt::println("{:>24} | {:>6} | {:>12.0f}", name, depth, AsyncIops(io, fd, offsets, depth));
+    }
+  }
+
+  ::close(fd);
+  std::remove(kPath);
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include <fmt/core.h>
+
+#include <magic/common/shared_ptr.h>
+#include <magic/common/stopwatch.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Read-heavy workload: every reader loads the current snapshot,
+// a single writer replaces it every kWriteEveryOps reads
+
+struct Config {
+  size_t version = 0;
+  size_t payload[8] = {};
+};
+
+static const size_t kOpsPerReader = 2'000'000;
+static const size_t kWriteEveryOps = 1'000;
+
+//////////////////////////////////////////////////////////////////////
+
+struct MagicAtomic {
+  AtomicSharedPtr<Config> ptr{MakeShared<Config>()};
+
+  size_t Read() {
+    return ptr.Load()->version;
+  }
+
+  void Write(size_t version) {
+    ptr.Store(MakeShared<Config>(Config{.version = version}));
+  }
+};
+
+// libc++ does not provide std::atomic<std::shared_ptr>,
+// the free atomic_load/atomic_store functions are lock-based as well
+struct StdAtomic {
+  std::shared_ptr<Config> ptr = std::make_shared<Config>();
+
+  size_t Read() {
+    return std::atomic_load(&ptr)->version;
+  }
+
+  void Write(size_t version) {
+    std::atomic_store(&ptr, std::make_shared<Config>(Config{.version = version}));
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+template <typename Impl>
+double RunBenchmark(size_t readers) {
+  Impl impl;
+  std::atomic<bool> done{false};
+  std::atomic<size_t> checksum{0};
+
+  Stopwatch stopwatch;
+
+  std::thread writer([&] {
+    size_t version = 0;
+    while (!done.load()) {
+      impl.Write(++version);
+      std::this_thread::yield();
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < readers; ++index) {
+    threads.emplace_back([&] {
+      size_t sum = 0;
+      for (size_t op = 0; op < kOpsPerReader; ++op) {
+        sum += impl.Read();
+        if (op % kWriteEveryOps == 0) {
+          std::this_thread::yield();
+        }
+      }
+      checksum.fetch_add(sum);
+    });
+  }
+
+  for (auto&& t : threads) {
+    t.join();
+  }
+
+  const auto elapsed = stopwatch.Elapsed().count();
+
+  done.store(true);
+  writer.join();
+
+  return (readers * kOpsPerReader) / elapsed / 1'000'000;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+  fmt::println("{:>8} | {:>22} | {:>22}", "Readers", "AtomicSharedPtr Mops/s",
+               "std atomic_load Mops/s");
+
+  for (size_t readers = 1; readers <= max_threads; readers *= 2) {
+    auto magic = RunBenchmark<MagicAtomic>(readers);
+    auto lock_based = RunBenchmark<StdAtomic>(readers);
+    fmt::println("{:>8} | {:>22.2f} | {:>22.2f}", readers, magic, lock_based);
+  }
+
+  return 0;
+}
@@ -1,127 +1,167 @@
 #include <fmt/core.h>
 
 #include <magic/common/stopwatch.h>
+#include <magic/concurrency/adaptive_lock.h>
+#include <magic/concurrency/mcs_lock.h>
+#include <magic/concurrency/spinlock.h>
+#include <magic/concurrency/ticket_lock.h>
 
+#include <wheels/core/assert.hpp>
+
+#include <algorithm>
+#include <limits>
 #include <atomic>
-#include <vector>
-#include <thread>
+#include <mutex>
 #include <numeric>
+#include <thread>
+#include <vector>
 
 using namespace magic;
 
 //////////////////////////////////////////////////////////////////////
 
-class AtomicCounter final {
- public:
-  void Increment() {
-    value_.fetch_add(1);
-  }
+// Lock comparison suite
+// Every thread repeatedly acquires the lock, increments a shared counter and
+// does a little private work outside of the critical section
 
-  size_t Value() const {
-    return value_.load();
-  }
+// Throughput: total acquisitions per second
+// Fairness: spread of per-thread acquisitions (max / min) and
+// Jain's index (1.0 = perfectly even, 1/n = one thread took everything)
 
- private:
-  std::atomic<size_t> value_ = 0;
-};
+static const auto kRunDuration = 1s;
+static const size_t kOutsideWork = 64;
 
 //////////////////////////////////////////////////////////////////////
 
-void Stress() {
-  AtomicCounter counter;
-  Stopwatch stopwatch;
+template <typename Lock>
+struct LockAdapter {
+  Lock lock;
 
-  std::vector<std::thread> threads;
-  for (size_t index = 0; index < 10; ++index) {
-    threads.emplace_back([&counter] {
-      for (size_t index = 0; index < 1'000'000; ++index) {
-        counter.Increment();
-      }
-    });
+  template <typename F>
+  void WithLock(F&& critical_section) {
+    std::lock_guard guard(lock);
+    critical_section();
   }
+};
 
-  for (auto&& t : threads) {
-    t.join();
+template <>
+struct LockAdapter<MCSLock> {
+  MCSLock lock;
+
+  template <typename F>
+  void WithLock(F&& critical_section) {
+    MCSLock::Guard guard(lock);
+    critical_section();
   }
+};
 
-  auto elapsed_ms = stopwatch.ElapsedMs();
+//////////////////////////////////////////////////////////////////////
 
-  fmt::println("Iteration: {}", counter.Value());
-  fmt::println("Elapsed: {} ms", elapsed_ms);
-}
+struct Report {
+  double mops;
+  size_t min;
+  size_t max;
+  double jain_index;
+};
 
-//////////////////////////////////////////////////////////////////////
+struct alignas(64) ThreadStats {
+  size_t acquisitions = 0;
+};
 
-inline void Pause() {
-  asm volatile("pause\n" : : : "memory");
-}
+template <typename Lock>
+Report RunLockBenchmark(size_t threads) {
+  LockAdapter<Lock> lock;
+  size_t counter = 0;  // Guarded by lock
+
+  std::vector<ThreadStats> stats(threads);
+  std::atomic<size_t> ready = 0;
+  std::atomic<bool> stop = false;
+
+  std::vector<std::thread> contenders;
+  for (size_t index = 0; index < threads; ++index) {
+    contenders.emplace_back([&, index] {
+      ready.fetch_add(1);
+      while (ready.load() < threads) {
+        std::this_thread::yield();
+      }
 
-//////////////////////////////////////////////////////////////////////
+      size_t acquisitions = 0;
+      while (!stop.load(std::memory_order::relaxed)) {
+        lock.WithLock([&counter] {
+          ++counter;  // Critical section
+        });
+        ++acquisitions;
 
-class SpinLock final {
- public:
-  void Lock() {
-    while (locked_.exchange(1, std::memory_order::acquire) == 1) {
-      while (locked_.load(std::memory_order::relaxed) == 1) {
-        Pause();
+        for (size_t work = 0; work < kOutsideWork; ++work) {
+          detail::SpinLockPause();
+        }
       }
-    }
+      stats[index].acquisitions = acquisitions;
+    });
   }
 
-  void Unlock() {
-    locked_.store(0, std::memory_order::release);
+  while (ready.load() < threads) {
+    std::this_thread::yield();
   }
 
- private:
-  std::atomic<uint32_t> locked_ = 0;
-};
-
-size_t TestSpinLock() {
   Stopwatch stopwatch;
-  SpinLock spinlock;
-
-  size_t counter = 0;
-
-  std::vector<std::thread> threads;
-  for (size_t index = 0; index < 10; ++index) {
-    threads.emplace_back([&] {
-      // Contender thread
-      for (size_t index = 0; index < 100'500; ++index) {
-        spinlock.Lock();
-        ++counter;  // Critical section
-        spinlock.Unlock();
-      }
-    });
-  }
+  std::this_thread::sleep_for(kRunDuration);
+  stop.store(true);
 
-  for (auto&& t : threads) {
+  for (auto&& t : contenders) {
     t.join();
   }
+  const auto elapsed = stopwatch.Elapsed().count();
+
+  size_t total = 0;
+  double squares = 0;
+  Report report{0, std::numeric_limits<size_t>::max(), 0, 0};
+  for (auto&& s : stats) {
+    total += s.acquisitions;
+    squares += static_cast<double>(s.acquisitions) * s.acquisitions;
+    report.min = std::min(report.min, s.acquisitions);
+    report.max = std::max(report.max, s.acquisitions);
+  }
+  WHEELS_VERIFY(counter == total, "Mutual exclusion violated");
 
-  auto elapsed_ms = stopwatch.ElapsedMs();
-
-  fmt::println("Iteration: {}", counter);
-  fmt::println("Elapsed: {} ms", elapsed_ms);
+  report.mops = total / elapsed / 1'000'000;
+  report.jain_index = squares > 0 ? (double(total) * total) / (threads * squares) : 1.0;
+  return report;
+}
 
-  return elapsed_ms;
+template <typename Lock>
+void CompareAt(const char* name, size_t threads) {
+  auto report = RunLockBenchmark<Lock>(threads);
+  const double spread = report.min > 0 ? double(report.max) / report.min : 0;
+  fmt::println("{:>14} | {:>7} | {:>9.2f} | {:>10} | {:>10} | {:>7.2f} | {:>6.3f}", name, threads,
+               report.mops, report.min, report.max, spread, report.jain_index);
 }
 
 //////////////////////////////////////////////////////////////////////
 
 int main() {
-  fmt::println("Stress test");
+  const size_t cores = std::max(2u, std::thread::hardware_concurrency());
 
-  static const size_t kIteration = 20;
-
-  auto metrics = std::vector<size_t>(kIteration);
-  for (size_t index = 0; index < kIteration; ++index) {
-    //    Stress();
-    auto elapsed_ms = TestSpinLock();
-    metrics.push_back(elapsed_ms);
+  std::vector<size_t> thread_counts;
+  for (size_t threads = 1; threads <= cores; threads *= 2) {
+    thread_counts.push_back(threads);
+  }
+  if (thread_counts.back() != cores) {
+    thread_counts.push_back(cores);
   }
 
-  auto average = std::reduce(metrics.begin(), metrics.end()) / kIteration;
-  fmt::println("\nAverage: {} ms", average);
+  fmt::println("Lock comparison: {}s per run, {} pauses outside of the critical section",
+               kRunDuration.count(), kOutsideWork);
+  fmt::println("{:>14} | {:>7} | {:>9} | {:>10} | {:>10} | {:>7} | {:>6}", "Lock", "Threads",
+               "Mops/s", "Min acq", "Max acq", "Spread", "Jain");
+
+  for (auto threads : thread_counts) {
+    CompareAt<std::mutex>("std::mutex", threads);
+    CompareAt<SpinLock>("SpinLock", threads);
+    CompareAt<TicketLock>("TicketLock", threads);
+    CompareAt<MCSLock>("MCSLock", threads);
+    CompareAt<AdaptiveLock>("AdaptiveLock", threads);
+  }
 
   return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,112 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/filesystem/buffered_writer.h>
+#include <magic/filesystem/file.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <sys/stat.h>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Writing many short lines: the previous File::WriteAllLines
+// (std::ofstream, `file << line << "\n"`) vs the BufferedWriter-based one
+// The time includes close but not fsync, the data may still be in the page cache
+
+static const char* kPath = "buffered_writer_benchmark.txt";
+static const size_t kLines = 5'000'000;
+
+//////////////////////////////////////////////////////////////////////
+
+static File::TextLines MakeLines() {
+  File::TextLines lines;
+  lines.reserve(kLines);
+  for (size_t index = 0; index < kLines; ++index) {
+    lines.push_back(fmt::format("{:08} user{} GET /api/items/{} 200", index, index % 1000,
+                                index * 7 % 100'000));
+  }
+  return lines;
+}
+
+static size_t FileSize(const char* path) {
+  struct stat stat;
+  WHEELS_VERIFY(::stat(path, &stat) == 0, "File must exist");
+  return stat.st_size;
+}
+
+// Previous implementation
+static void WriteWithOfstream(const File::TextLines& lines) {
+  auto file = std::ofstream(kPath);
+  for (auto&& line : lines) {
+    file << line << "\n";
+  }
+}
+
+static void WriteDirect(const File::TextLines& lines, size_t bytes) {
+  auto writer = BufferedWriter::Open(
+                    kPath, {.BufferSize = 4 << 20, .Direct = true, .Preallocate = bytes})
+                    .ValueOrThrow();
+  for (auto&& line : lines) {
+    writer.WriteLine(line).ThrowIfError();
+  }
+  writer.Close().ThrowIfError();
+}
+
+template <typename F>
+double MeasureMBps(F&& write, size_t expected_bytes) {
+  std::remove(kPath);
+  Stopwatch stopwatch;
+  write();
+  const auto elapsed = stopwatch.Elapsed().count();
+  WHEELS_VERIFY(FileSize(kPath) == expected_bytes, "Every byte must be written");
+  return expected_bytes / elapsed / 1e6;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  const auto lines = MakeLines();
+  size_t bytes = 0;
+  for (auto&& line : lines) {
+    bytes += line.size() + 1;
+  }
+
+  fmt::println("{} lines, {} MB", kLines, bytes / 1'000'000);
+  fmt::println("{:>34} | {:>8}", "Writer", "MB/s");
+
+  const auto before = MeasureMBps(
+      [&] {
+        WriteWithOfstream(lines);
+      },
+      bytes);
+  fmt::println("{:>34} | {:>8.0f}", "ofstream (before)", before);
+
+  const auto after = MeasureMBps(
+      [&] {
+        File::WriteAllLines(kPath, lines).ThrowIfError();
+      },
+      bytes);
+  fmt::println("{:>34} | {:>8.0f}", "File::WriteAllLines (after)", after);
+
+  // Probe for O_DIRECT support
+  if (BufferedWriter::Open(kPath, {.Direct = true}).IsOk()) {
+    const auto direct = MeasureMBps(
+        [&] {
+          WriteDirect(lines, bytes);
+        },
+        bytes);
+    fmt::println("{:>34} | {:>8.0f}", "BufferedWriter O_DIRECT+fallocate", direct);
+  }
+
+  fmt::println("Speedup: {:.2f}x", after / before);
+
+  std::remove(kPath);
+  return 0;
+}
@@ -0,0 +1,111 @@
+#include <fmt/core.h>
+
+#include <magic/common/cpu_time.h>
+#include <magic/common/stopwatch.h>
+#include <magic/common/tsc_clock.h>
+#include <magic/executors/execute.h>
+#include <magic/executors/thread_pool.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <ctime>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Cost of a single clock read: steady_clock (vDSO), the thread CPU clock
+// (a system call), raw counter reads and TscClock, plus the per-task cost
+// of ThreadPool timing
+
+static const size_t kReads = 10'000'000;
+static const size_t kTasks = 2'000'000;
+
+//////////////////////////////////////////////////////////////////////
+
+template <typename F>
+double MeasureNsPerOp(F&& read, size_t iterations) {
+  uint64_t checksum = 0;
+  Stopwatch stopwatch;
+  for (size_t index = 0; index < iterations; ++index) {
+    checksum += read();
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+  // Keep the results observable
+  WHEELS_VERIFY(checksum > 0, "Clocks must produce something");
+  return elapsed * 1e9 / iterations;
+}
+
+static uint64_t ClockGettime(clockid_t clock) {
+  struct timespec now;
+  clock_gettime(clock, &now);
+  return now.tv_sec * 1'000'000'000 + now.tv_nsec;
+}
+
+static void Report(const char* name, double ns) {
+  fmt::println("{:>28} | {:>8.1f}", name, ns);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  fmt::println("TSC: {}, {:.3f} GHz", TscClock::IsReliable() ? "invariant" : "fallback",
+               TscClock::TicksPerSecond() / 1e9);
+  fmt::println("{:>28} | {:>8}", "Read", "ns/op");
+
+  Report("steady_clock::now", MeasureNsPerOp(
+                                  [] {
+                                    return Clock::now().time_since_epoch().count();
+                                  },
+                                  kReads));
+  Report("CLOCK_MONOTONIC", MeasureNsPerOp(
+                                [] {
+                                  return ClockGettime(CLOCK_MONOTONIC);
+                                },
+                                kReads));
+  Report("CLOCK_THREAD_CPUTIME_ID", MeasureNsPerOp(
+                                        [] {
+                                          return ClockGettime(CLOCK_THREAD_CPUTIME_ID);
+                                        },
+                                        kReads / 10));
+#if defined(__x86_64__)
+  Report("rdtsc", MeasureNsPerOp(detail::ReadTsc, kReads));
+  Report("lfence; rdtsc; lfence", MeasureNsPerOp(detail::ReadTscFenced, kReads));
+  Report("rdtscp; lfence", MeasureNsPerOp(detail::ReadTscp, kReads));
+#endif
+  Report("TscClock::Ticks", MeasureNsPerOp(TscClock::Ticks, kReads));
+  Report("TscClock::now", MeasureNsPerOp(
+                              [] {
+                                return TscClock::now().time_since_epoch().count();
+                              },
+                              kReads));
+
+  Stopwatch stopwatch;
+  TscStopwatch tsc_stopwatch;
+  Report("Stopwatch::Elapsed", MeasureNsPerOp(
+                                   [&] {
+                                     return stopwatch.Elapsed().count() > 0;
+                                   },
+                                   kReads));
+  Report("TscStopwatch::Elapsed", MeasureNsPerOp(
+                                      [&] {
+                                        return tsc_stopwatch.Elapsed().count() > 0;
+                                      },
+                                      kReads));
+
+  // Empty tasks on a single worker: the timing is part of this figure
+  ThreadPool pool{1};
+  Stopwatch pool_stopwatch;
+  for (size_t index = 0; index < kTasks; ++index) {
+    Execute(pool, [] {});
+  }
+  pool.WaitIdle();
+  const auto elapsed = pool_stopwatch.Elapsed().count();
+  const auto metrics = pool.GetMetrics();
+  pool.Stop();
+  Report("ThreadPool empty task", elapsed * 1e9 / kTasks);
+  fmt::println("{:>28}   {} tasks, busy {:.3f} s", "", metrics.CompletedTasks,
+               metrics.BusyTime.count());
+
+  return 0;
+}
@@ -0,0 +1,187 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/concurrency/atomic_counter.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/fibers/api.h>
+#include <magic/net/socket.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+// Loopback TCP echo over fiber sockets
+// Every connection is a client fiber doing request/response round trips
+// with a fixed-size message, the server echoes on a fiber per connection
+
+static const auto kRunDuration = 2s;
+static const size_t kMessageSize = 64;
+
+struct Report {
+  size_t connections;
+  double messages_per_second;
+  double p50_us;
+  double p99_us;
+  double p999_us;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Both ends of every connection live in this process
+static size_t RaiseDescriptorLimit() {
+  rlimit limit{};
+  getrlimit(RLIMIT_NOFILE, &limit);
+  limit.rlim_cur = limit.rlim_max;
+  setrlimit(RLIMIT_NOFILE, &limit);
+  return limit.rlim_cur;
+}
+
+static double Percentile(std::vector<double>& samples, double p) {
+  if (samples.empty()) {
+    return 0;
+  }
+  const auto index = static_cast<size_t>(p * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
+
+static bool ReadExactly(net::Socket& socket, char* buffer, size_t size) {
+  size_t filled = 0;
+  while (filled < size) {
+    auto bytes = socket.ReadSome(buffer + filled, size - filled);
+    if (bytes.HasError() || *bytes == 0) {
+      return false;
+    }
+    filled += *bytes;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static Report Run(size_t connections, size_t threads) {
+  ThreadPool server_scheduler{threads};
+  ThreadPool client_scheduler{threads};
+
+  net::Acceptor acceptor;
+  acceptor.Listen("127.0.0.1", 0, 4096).ThrowIfError();
+
+  AtomicCounter server_fibers;
+  server_fibers.Add();
+  Go(server_scheduler, [&] {
+    while (true) {
+      auto socket = acceptor.Accept();
+      if (socket.HasError()) {
+        break;
+      }
+      server_fibers.Add();
+      Go([&server_fibers, socket = std::move(*socket)]() mutable {
+        char buffer[kMessageSize];
+        while (ReadExactly(socket, buffer, sizeof(buffer))) {
+          if (socket.WriteAll({buffer, sizeof(buffer)}).HasError()) {
+            break;
+          }
+        }
+        socket.Close();
+        server_fibers.Done();
+      });
+    }
+    server_fibers.Done();
+  });
+
+  // Connect everything first, then start the clock
+  std::atomic<size_t> connected = 0;
+  std::atomic<bool> start = false;
+  std::atomic<bool> stop = false;
+  std::atomic<size_t> messages = 0;
+
+  std::mutex mutex;
+  std::vector<double> latencies;  // Guarded by mutex
+
+  AtomicCounter clients;
+  for (size_t index = 0; index < connections; ++index) {
+    clients.Add();
+    Go(client_scheduler, [&] {
+      auto socket = net::Socket::Connect("127.0.0.1", acceptor.Port()).ValueOrThrow();
+      connected.fetch_add(1);
+      while (!start.load()) {
+        self::Yield();
+      }
+
+      std::string message(kMessageSize, 'm');
+      char buffer[kMessageSize];
+      std::vector<double> local;
+
+      while (!stop.load(std::memory_order::relaxed)) {
+        Stopwatch stopwatch;
+        WHEELS_VERIFY(socket.WriteAll(message).IsOk(), "Write failed");
+        WHEELS_VERIFY(ReadExactly(socket, buffer, sizeof(buffer)), "Read failed");
+        local.push_back(std::chrono::duration<double, std::micro>(stopwatch.Elapsed()).count());
+      }
+      messages.fetch_add(local.size());
+
+      socket.Close();
+      std::lock_guard guard(mutex);
+      latencies.insert(latencies.end(), local.begin(), local.end());
+      clients.Done();
+    });
+  }
+
+  while (connected.load() < connections) {
+    std::this_thread::sleep_for(10ms);
+  }
+
+  Stopwatch stopwatch;
+  start.store(true);
+  std::this_thread::sleep_for(kRunDuration);
+  stop.store(true);
+  clients.WaitZero();
+  const auto elapsed = stopwatch.Elapsed().count();
+
+  acceptor.Shutdown();
+  server_fibers.WaitZero();
+  client_scheduler.Stop();
+  server_scheduler.Stop();
+
+  return {connections, messages.load() / elapsed, Percentile(latencies, 0.5),
+          Percentile(latencies, 0.99), Percentile(latencies, 0.999)};
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+  const size_t max_connections = (RaiseDescriptorLimit() - 256) / 2;
+
+  fmt::println("Echo: {}-byte messages, {}s per run, {} server + {} client threads",
+               kMessageSize, kRunDuration.count(), threads, threads);
+  fmt::println("{:>11} | {:>12} | {:>8} | {:>10} | {:>10} | {:>10}", "Connections", "Msgs/s",
+               "MB/s", "p50 us", "p99 us", "p99.9 us");
+
+  for (size_t connections : {1, 100, 1'000, 10'000}) {
+    if (connections > max_connections) {
+      fmt::println("{:>11} | skipped, descriptor limit allows {} connections", connections,
+                   max_connections);
+      continue;
+    }
+    auto report = Run(connections, threads);
+    fmt::println("{:>11} | {:>12.0f} | {:>8.1f} | {:>10.1f} | {:>10.1f} | {:>10.1f}",
+                 report.connections, report.messages_per_second,
+                 report.messages_per_second * kMessageSize * 2 / (1 << 20), report.p50_us,
+                 report.p99_us, report.p999_us);
+  }
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+#include <fmt/core.h>
+
+#include <magic/common/dictionary.h>
+#include <magic/common/flat_hash_map.h>
+#include <magic/common/stopwatch.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Dictionary candidates on string keys:
+// the previous std::unordered_map with std::hash<string_view>,
+// std::unordered_map with the wyhash-based StringHash, and FlatHashMap
+// Lookups go through std::string_view as HttpHeader and the http code do
+
+static const size_t kOperations = 4'000'000;
+
+struct PreviousStringHash {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view str) const {
+    return std::hash<std::string_view>{}(str);
+  }
+};
+
+using PreviousDictionary =
+    std::unordered_map<std::string, std::string, PreviousStringHash, std::equal_to<>>;
+using HashedDictionary =
+    std::unordered_map<std::string, std::string, detail::StringHash, std::equal_to<>>;
+using FlatDictionary = FlatHashMap<std::string, std::string, detail::StringHash>;
+
+//////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> MakeKeys(size_t count, size_t salt) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (size_t index = 0; index < count; ++index) {
+    keys.push_back(fmt::format("session:{:08}:{}", index * 2654435761 % 100'000'000, salt));
+  }
+  return keys;
+}
+
+struct Timings {
+  double insert;
+  double hit;
+  double miss;
+  double iterate;
+};
+
+template <typename Map>
+Timings Measure(const std::vector<std::string>& keys, const std::vector<std::string>& missing,
+                const std::vector<std::string_view>& order) {
+  const size_t rounds = std::max<size_t>(1, kOperations / keys.size());
+  Timings timings{};
+  size_t checksum = 0;
+
+  Stopwatch stopwatch;
+  auto lap = [&stopwatch] {
+    const auto elapsed = stopwatch.Elapsed().count();
+    stopwatch.Reset();
+    return elapsed;
+  };
+
+  std::vector<Map> maps(rounds);
+  stopwatch.Reset();
+  for (auto& map : maps) {
+    for (auto&& key : keys) {
+      map.emplace(key, "value");
+    }
+  }
+  timings.insert = lap() * 1e9 / (rounds * keys.size());
+
+  // Lookups and iteration repeat on one map: cache-resident up to 1k entries
+  maps.resize(1);
+  const auto& map = maps.front();
+  lap();
+
+  for (size_t round = 0; round < rounds; ++round) {
+    for (auto key : order) {
+      checksum += map.find(key)->second.size();
+    }
+  }
+  timings.hit = lap() * 1e9 / (rounds * keys.size());
+
+  for (size_t round = 0; round < rounds; ++round) {
+    for (auto&& key : missing) {
+      checksum += map.count(std::string_view{key});
+    }
+  }
+  timings.miss = lap() * 1e9 / (rounds * keys.size());
+
+  for (size_t round = 0; round < rounds; ++round) {
+    for (auto&& [key, value] : map) {
+      checksum += key.size();
+    }
+  }
+  timings.iterate = lap() * 1e9 / (rounds * keys.size());
+
+  // Keep the results observable
+  WHEELS_VERIFY(checksum >= rounds * keys.size(), "Lookups must hit");
+  return timings;
+}
+
+static void Report(size_t size, const char* name, const Timings& timings) {
+  fmt::println("{:>9} | {:>24} | {:>8.1f} | {:>8.1f} | {:>8.1f} | {:>8.1f}", size, name,
+               timings.insert, timings.hit, timings.miss, timings.iterate);
+}
+
+template <typename H>
+double MeasureHash(size_t length) {
+  const std::string data(length + 64, 'k');
+  const size_t iterations = kOperations * 4;
+  H hash;
+  size_t checksum = 0;
+  Stopwatch stopwatch;
+  for (size_t index = 0; index < iterations; ++index) {
+    // Shifting window: the compiler can not hoist the hash out of the loop
+    checksum += hash(std::string_view(data.data() + index % 64, length));
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+  WHEELS_VERIFY(checksum != 0, "Hashes must be observable");
+  return elapsed * 1e9 / iterations;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  fmt::println("ns per hash");
+  fmt::println("{:>9} | {:>14} | {:>14}", "Length", "std::hash", "wyhash");
+  for (size_t length : {8, 18, 64, 256}) {
+    fmt::println("{:>9} | {:>14.2f} | {:>14.2f}", length, MeasureHash<PreviousStringHash>(length),
+                 MeasureHash<detail::StringHash>(length));
+  }
+
+  fmt::println("");
+  fmt::println("ns per entry");
+  fmt::println("{:>9} | {:>24} | {:>8} | {:>8} | {:>8} | {:>8}", "Entries", "Map", "Insert",
+               "Hit", "Miss", "Iterate");
+
+  for (size_t size : {10, 1'000, 1'000'000}) {
+    const auto keys = MakeKeys(size, 1);
+    const auto missing = MakeKeys(size, 2);
+
+    // Lookups in random order
+    std::vector<std::string_view> order(keys.begin(), keys.end());
+    std::shuffle(order.begin(), order.end(), std::mt19937{42});
+
+    Report(size, "unordered_map std::hash", Measure<PreviousDictionary>(keys, missing, order));
+    Report(size, "unordered_map wyhash", Measure<HashedDictionary>(keys, missing, order));
+    Report(size, "FlatHashMap wyhash", Measure<FlatDictionary>(keys, missing, order));
+  }
+
+  return 0;
+}
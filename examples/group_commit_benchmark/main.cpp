@@ -0,0 +1,82 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/filesystem/buffered_writer.h>
+#include <magic/filesystem/log_writer.h>
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Durable appends from many threads: a shared writer doing write + fdatasync
+// per record under a mutex vs LogWriter group commit
+// Every append has returned only once its record is durable in both cases
+
+static const char* kPath = "group_commit_benchmark.log";
+static const size_t kRecords = 4000;
+static const std::string kRecord = "2024-01-01T00:00:00Z user42 GET /api/items/1234 200\n";
+
+//////////////////////////////////////////////////////////////////////
+
+template <typename F>
+double MeasureAppendsPerSecond(size_t threads, F&& append) {
+  std::vector<std::thread> workers;
+  Stopwatch stopwatch;
+  for (size_t thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&] {
+      for (size_t index = 0; index < kRecords / threads; ++index) {
+        append();
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return kRecords / threads * threads / stopwatch.Elapsed().count();
+}
+
+static double PerWriteSync(size_t threads) {
+  std::remove(kPath);
+  auto writer = BufferedWriter::Open(kPath, {.Append = true}).ValueOrThrow();
+  std::mutex mutex;
+  return MeasureAppendsPerSecond(threads, [&] {
+    std::lock_guard guard(mutex);
+    writer.Write(kRecord).ThrowIfError();
+    writer.Sync().ThrowIfError();
+  });
+}
+
+static double GroupCommit(size_t threads, uint64_t& commits) {
+  std::remove(kPath);
+  auto log = LogWriter::Open(kPath).ValueOrThrow();
+  const auto rate = MeasureAppendsPerSecond(threads, [&] {
+    log->Append(kRecord).ThrowIfError();
+  });
+  commits = log->Commits();
+  return rate;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  fmt::println("{} records of {} bytes", kRecords, kRecord.size());
+  fmt::println("{:>8} | {:>16} | {:>17} | {:>14} | {:>8}", "Threads", "fsync/write op/s",
+               "group commit op/s", "records/commit", "Speedup");
+
+  for (size_t threads : {1, 4, 16, 64}) {
+    const auto before = PerWriteSync(threads);
+    uint64_t commits = 0;
+    const auto after = GroupCommit(threads, commits);
+    fmt::println("{:>8} | {:>16.0f} | {:>17.0f} | {:>14.1f} | {:>7.2f}x", threads, before, after,
+                 double(kRecords / threads * threads) / commits, after / before);
+  }
+
+  std::remove(kPath);
+  return 0;
+}
@@ -0,0 +1,185 @@
+#include <fmt/core.h>
+
+#include <magic/common/dictionary.h>
+#include <magic/common/stopwatch.h>
+#include <magic/concurrency/concurrent_hash_map.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// YCSB-style workloads over string keys
+// A: 50% reads / 50% updates
+// B: 95% reads / 5% updates
+// C: 100% reads
+
+static const size_t kRecords = 100'000;
+static const size_t kOpsPerThread = 500'000;
+static const size_t kValueSize = 100;
+
+struct Workload {
+  const char* name;
+  double read_proportion;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Zipfian distribution over [0, items), from the YCSB ZipfianGenerator
+// (Gray et al., "Quickly Generating Billion-Record Synthetic Databases")
+
+class ZipfianGenerator final {
+ public:
+  explicit ZipfianGenerator(size_t items, double theta = 0.99, size_t seed = 42)
+      : items_(items), theta_(theta), engine_(seed) {
+    zeta2_ = Zeta(2);
+    zetan_ = Zeta(items_);
+    alpha_ = 1.0 / (1.0 - theta_);
+    eta_ = (1 - std::pow(2.0 / items_, 1 - theta_)) / (1 - zeta2_ / zetan_);
+  }
+
+  size_t Next() {
+    const double u = uniform_(engine_);
+    const double uz = u * zetan_;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + std::pow(0.5, theta_)) {
+      return 1;
+    }
+    return static_cast<size_t>(items_ * std::pow(eta_ * u - eta_ + 1, alpha_));
+  }
+
+ private:
+  double Zeta(size_t n) const {
+    double sum = 0;
+    for (size_t i = 1; i <= n; ++i) {
+      sum += 1 / std::pow(i, theta_);
+    }
+    return sum;
+  }
+
+ private:
+  const size_t items_;
+  const double theta_;
+  double zeta2_, zetan_, alpha_, eta_;
+  std::mt19937_64 engine_;
+  std::uniform_real_distribution<double> uniform_{0.0, 1.0};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+struct LockedDictionary {
+  std::mutex mutex;
+  Dictionary dictionary;
+
+  bool Read(std::string_view key) {
+    std::lock_guard lock(mutex);
+    auto it = dictionary.find(key);
+    return it != dictionary.end() && !it->second.empty();
+  }
+
+  void Update(std::string key, std::string value) {
+    std::lock_guard lock(mutex);
+    dictionary.insert_or_assign(std::move(key), std::move(value));
+  }
+};
+
+struct Concurrent {
+  ConcurrentDictionary dictionary;
+
+  bool Read(std::string_view key) {
+    return dictionary.Visit(key, [](const std::string& value) {
+      return !value.empty();
+    });
+  }
+
+  void Update(std::string key, std::string value) {
+    dictionary.Insert(std::move(key), std::move(value));
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+std::string MakeKey(size_t index) {
+  return fmt::format("user{:012}", index);
+}
+
+template <typename Map>
+double RunWorkload(const Workload& workload, size_t threads) {
+  Map map;
+  const auto value = std::string(kValueSize, 'x');
+  for (size_t index = 0; index < kRecords; ++index) {
+    map.Update(MakeKey(index), value);
+  }
+
+  // Pre-generate keys, the generator must not dominate
+  std::vector<std::vector<std::string>> keys(threads);
+  for (size_t thread = 0; thread < threads; ++thread) {
+    ZipfianGenerator zipfian(kRecords, 0.99, thread);
+    for (size_t op = 0; op < kOpsPerThread; ++op) {
+      keys[thread].push_back(MakeKey(zipfian.Next()));
+    }
+  }
+
+  std::atomic<size_t> hits = 0;
+  Stopwatch stopwatch;
+
+  std::vector<std::thread> workers;
+  for (size_t thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&, thread] {
+      std::mt19937 engine(thread);
+      std::uniform_real_distribution<double> coin{0.0, 1.0};
+
+      size_t found = 0;
+      for (auto&& key : keys[thread]) {
+        if (coin(engine) < workload.read_proportion) {
+          found += map.Read(key);
+        } else {
+          map.Update(key, value);
+        }
+      }
+      // Keep the reads observable
+      hits.fetch_add(found, std::memory_order::relaxed);
+    });
+  }
+
+  for (auto&& worker : workers) {
+    worker.join();
+  }
+
+  const auto elapsed = stopwatch.Elapsed().count();
+  WHEELS_VERIFY(hits.load() > 0, "Reads must hit the loaded records");
+  return (threads * kOpsPerThread) / elapsed / 1'000'000;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  const auto workloads = std::vector<Workload>{{"A (50/50)", 0.5}, {"B (95/5)", 0.95},
+                                               {"C (100/0)", 1.0}};
+  const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+  fmt::println("Records: {}, ops/thread: {}, zipfian theta 0.99", kRecords, kOpsPerThread);
+  fmt::println("{:>10} | {:>8} | {:>24} | {:>24}", "Workload", "Threads",
+               "mutex + Dictionary Mops/s", "ConcurrentDictionary Mops/s");
+
+  for (auto&& workload : workloads) {
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+      auto locked = RunWorkload<LockedDictionary>(workload, threads);
+      auto concurrent = RunWorkload<Concurrent>(workload, threads);
+      fmt::println("{:>10} | {:>8} | {:>24.2f} | {:>24.2f}", workload.name, threads, locked,
+                   concurrent);
+    }
+  }
+
+  return 0;
+}
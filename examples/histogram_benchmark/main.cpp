@@ -0,0 +1,98 @@
+#include <fmt/core.h>
+
+#include <magic/common/histogram.h>
+#include <magic/common/stopwatch.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Record overhead with several threads recording at once: the sharded
+// Histogram, the same histogram with a single shared shard, and samples
+// appended to a vector under a mutex
+
+static const size_t kRecordsPerThread = 2'000'000;
+
+//////////////////////////////////////////////////////////////////////
+
+class MutexSamples {
+ public:
+  void Record(uint64_t value) {
+    std::lock_guard guard(mutex_);
+    samples_.push_back(value);
+  }
+
+  size_t Count() const {
+    return samples_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<uint64_t> samples_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Wall time over the records of one thread: stays flat as long as the
+// threads run in parallel and do not contend
+template <typename Recorder>
+double MeasureNsPerRecord(Recorder& recorder, size_t threads) {
+  std::vector<std::thread> workers;
+  Stopwatch stopwatch;
+  for (size_t thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&recorder, thread] {
+      uint64_t value = thread + 1;
+      for (size_t index = 0; index < kRecordsPerThread; ++index) {
+        // Latency-like spread of values
+        value = value * 6364136223846793005ull + 1442695040888963407ull;
+        recorder.Record(value >> 44);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return stopwatch.Elapsed().count() * 1e9 / kRecordsPerThread;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  fmt::println("{:>8} | {:>14} | {:>14} | {:>14}", "Threads", "Histogram", "1 shard",
+               "mutex+vector");
+
+  for (size_t threads : {1, 2, 4, 8}) {
+    Histogram sharded;
+    Histogram shared{1};
+    MutexSamples samples;
+
+    const auto sharded_ns = MeasureNsPerRecord(sharded, threads);
+    const auto shared_ns = MeasureNsPerRecord(shared, threads);
+    const auto mutex_ns = MeasureNsPerRecord(samples, threads);
+
+    WHEELS_VERIFY(sharded.Snapshot().Count() == threads * kRecordsPerThread, "Lost records");
+    WHEELS_VERIFY(shared.Snapshot().Count() == threads * kRecordsPerThread, "Lost records");
+    WHEELS_VERIFY(samples.Count() == threads * kRecordsPerThread, "Lost records");
+
+    fmt::println("{:>8} | {:>11.1f} ns | {:>11.1f} ns | {:>11.1f} ns", threads, sharded_ns,
+                 shared_ns, mutex_ns);
+  }
+
+  Histogram histogram;
+  for (uint64_t value = 1; value <= 1'000'000; ++value) {
+    histogram.Record(value);
+  }
+  Stopwatch stopwatch;
+  const auto snapshot = histogram.Snapshot();
+  const auto text = snapshot.ToString();
+  fmt::println("\nSnapshot + ToString: {:.1f} us", stopwatch.Elapsed().count() * 1e6);
+  fmt::println("{}", text);
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+
+// Minimal keep-alive HTTP/1.1 stand-in backend on 127.0.0.1
+// One thread per connection, answers every request with a fixed body
+
+class LocalServer final {
+ public:
+  explicit LocalServer(std::string body = "ok") : body_(std::move(body)) {
+    listener_ = socket(AF_INET, SOCK_STREAM, 0);
+    int enable = 1;
+    setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;  // Any free port
+    bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    listen(listener_, 4096);
+
+    socklen_t length = sizeof(address);
+    getsockname(listener_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    acceptor_ = std::thread([this] {
+      AcceptLoop();
+    });
+  }
+
+  ~LocalServer() {
+    stop_.store(true);
+    shutdown(listener_, SHUT_RDWR);
+    close(listener_);
+    acceptor_.join();
+    {
+      // Wake up connections parked in read, e.g. pooled keep-alive ones
+      std::lock_guard lock(mutex_);
+      for (int fd : open_) {
+        shutdown(fd, SHUT_RDWR);
+      }
+    }
+    for (auto&& connection : connections_) {
+      connection.join();
+    }
+  }
+
+  std::string Url() const {
+    return "http://127.0.0.1:" + std::to_string(port_) + "/";
+  }
+
+  size_t AcceptedConnections() const {
+    return accepted_.load();
+  }
+
+ private:
+  void AcceptLoop() {
+    while (!stop_.load()) {
+      int fd = accept(listener_, nullptr, nullptr);
+      if (fd < 0) {
+        return;
+      }
+      accepted_.fetch_add(1);
+      {
+        std::lock_guard lock(mutex_);
+        open_.insert(fd);
+      }
+      int enable = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+      connections_.emplace_back([this, fd] {
+        Serve(fd);
+      });
+    }
+  }
+
+  void Serve(int fd) {
+    const auto response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: " +
+                          std::to_string(body_.size()) + "\r\n\r\n" + body_;
+
+    std::string buffer;
+    char chunk[4096];
+    while (true) {
+      auto bytes = read(fd, chunk, sizeof(chunk));
+      if (bytes <= 0) {
+        break;
+      }
+      buffer.append(chunk, bytes);
+
+      // Requests without bodies only
+      size_t end;
+      while ((end = buffer.find("\r\n\r\n")) != std::string::npos) {
+        buffer.erase(0, end + 4);
+        if (write(fd, response.data(), response.size()) < 0) {
+          Close(fd);
+          return;
+        }
+      }
+    }
+    Close(fd);
+  }
+
+  void Close(int fd) {
+    std::lock_guard lock(mutex_);
+    open_.erase(fd);
+    close(fd);
+  }
+
+ private:
+  const std::string body_;
+  int listener_;
+  uint16_t port_;
+  std::atomic<bool> stop_ = false;
+  std::atomic<size_t> accepted_ = 0;
+  std::thread acceptor_;
+  std::vector<std::thread> connections_;
+  std::mutex mutex_;
+  std::set<int> open_;
+};
@@ -0,0 +1,120 @@
+#include "local_server.h"
+
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/futures/execute.h>
+#include <magic/futures/get.h>
+#include <magic/net/http.h>
+#include <magic/net/http/client.h>
+#include <magic/net/http/request.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// 1. Sequential GET latency against a local keep-alive backend:
+//    a fresh easy handle per request (new connection every time)
+//    vs Http::Get on the pooled handles
+// 2. Concurrent GETs, kInFlight at a time: blocking Http::Get on a
+//    thread pool vs the event-driven HttpClient
+
+static const size_t kRequests = 5'000;
+static const size_t kInFlight = 500;
+static const size_t kPoolThreads = 16;
+
+//////////////////////////////////////////////////////////////////////
+
+void FreshHandleGet(const std::string& url) {
+  std::string content;
+
+  CURL* curl = curl_easy_init();
+  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, detail::WriteFunction);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &content);
+
+  const auto result = curl_easy_perform(curl);
+  curl_easy_cleanup(curl);
+
+  WHEELS_VERIFY(result == CURLE_OK, curl_easy_strerror(result));
+}
+
+void PooledGet(const std::string& url) {
+  auto response = Http::Get(url);
+  WHEELS_VERIFY(response.IsOk(), "Unexpected status");
+}
+
+template <typename F>
+void Measure(const char* name, const LocalServer& server, F&& get) {
+  const auto url = server.Url();
+  const auto connections_before = server.AcceptedConnections();
+
+  Stopwatch stopwatch;
+  for (size_t index = 0; index < kRequests; ++index) {
+    get(url);
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+
+  fmt::println("{:>14} | {:>10.0f} | {:>10.1f} | {:>11}", name, kRequests / elapsed,
+               elapsed * 1'000'000 / kRequests,
+               server.AcceptedConnections() - connections_before);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+template <typename F>
+void MeasureConcurrent(const char* name, const std::string& url, F&& submit) {
+  Stopwatch stopwatch;
+  for (size_t sent = 0; sent < kRequests; sent += kInFlight) {
+    std::vector<Future<HttpResponse>> in_flight;
+    for (size_t index = 0; index < kInFlight; ++index) {
+      in_flight.push_back(submit(url));
+    }
+    for (auto&& f : in_flight) {
+      WHEELS_VERIFY(futures::WaitValue(std::move(f)).IsOk(), "Unexpected status");
+    }
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+
+  fmt::println("{:>14} | {:>10.0f} | {:>10}", name, kRequests / elapsed, kInFlight);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  LocalServer server;
+
+  fmt::println("Requests: {}, backend: {}", kRequests, server.Url());
+  fmt::println("{:>14} | {:>10} | {:>10} | {:>11}", "Client", "Req/s", "Avg us", "Connections");
+
+  Measure("fresh handle", server, FreshHandleGet);
+  Measure("pooled handle", server, PooledGet);
+
+  fmt::println("");
+  fmt::println("{:>14} | {:>10} | {:>10}", "Engine", "Req/s", "In flight");
+
+  ThreadPool pool{kPoolThreads};
+  MeasureConcurrent("thread pool", server.Url(), [&pool](const std::string& url) {
+    return futures::Execute(pool, [url] {
+      return Http::Get(url);
+    });
+  });
+  pool.Stop();
+
+  MeasureConcurrent("curl multi", server.Url(), [](const std::string& url) {
+    return HttpClient::Default().Get(url);
+  });
+
+  auto metrics = Http::GetPoolMetrics();
+  fmt::println("Pool: {} hits, {} misses, {} evictions", metrics.Hits, metrics.Misses,
+               metrics.Evictions);
+
+  return 0;
+}
@@ -0,0 +1,158 @@
+#include <fmt/core.h>
+
+#include <magic/common/dictionary.h>
+#include <magic/common/stopwatch.h>
+#include <magic/common/string_reader.h>
+#include <magic/net/http/header.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Parse + lookup of response headers:
+// Dictionary of owned strings (the previous HttpHeader) vs
+// offset/length fields over a single raw block
+
+// Every iteration parses the block and looks up kLookups fields the way
+// a client reads a response (status-relevant fields, one miss)
+
+static const size_t kIterations = 200'000;
+
+struct HeaderSet {
+  const char* name;
+  std::string raw;
+};
+
+static const std::vector<std::string_view> kLookups = {"content-type", "Content-Length", "ETag",
+                                                       "X-Request-Id", "Retry-After"};
+
+//////////////////////////////////////////////////////////////////////
+
+static std::string MakeBlock(const std::vector<std::string>& fields) {
+  std::string raw = "HTTP/1.1 200 OK\r\n";
+  for (auto&& field : fields) {
+    raw += field + "\r\n";
+  }
+  return raw + "\r\n";
+}
+
+static std::vector<HeaderSet> MakeHeaderSets() {
+  return {
+      {"minimal", MakeBlock({
+                      "Content-Type: application/json",
+                      "Content-Length: 27",
+                      "Date: Mon, 17 Apr 2023 18:32:32 GMT",
+                  })},
+      {"express api", MakeBlock({
+                          "X-Powered-By: Express",
+                          "Content-Type: application/json; charset=utf-8",
+                          "Content-Length: 388",
+                          "ETag: W/\"184-btA3qP8tg9Wrq1KC5bpgvj92E8w\"",
+                          "Date: Mon, 17 Apr 2023 18:32:32 GMT",
+                          "Connection: keep-alive",
+                          "Keep-Alive: timeout=5",
+                      })},
+      {"cdn", MakeBlock({
+                  "Server: GitHub.com",
+                  "Date: Mon, 17 Apr 2023 18:32:32 GMT",
+                  "Content-Type: application/json; charset=utf-8",
+                  "Cache-Control: public, max-age=60, s-maxage=60",
+                  "Vary: Accept, Accept-Encoding, Accept, X-Requested-With",
+                  "ETag: W/\"7a1b3e0a5f0d4b7d9a9c3b1e2f4d6c8a\"",
+                  "Last-Modified: Sun, 16 Apr 2023 10:11:12 GMT",
+                  "X-GitHub-Media-Type: github.v3; format=json",
+                  "x-github-api-version-selected: 2022-11-28",
+                  "Access-Control-Expose-Headers: ETag, Link, Location, Retry-After",
+                  "Access-Control-Allow-Origin: *",
+                  "Strict-Transport-Security: max-age=31536000; includeSubdomains; preload",
+                  "X-Frame-Options: deny",
+                  "X-Content-Type-Options: nosniff",
+                  "X-XSS-Protection: 0",
+                  "Referrer-Policy: origin-when-cross-origin, strict-origin-when-cross-origin",
+                  "Content-Security-Policy: default-src 'none'",
+                  "Content-Encoding: gzip",
+                  "Accept-Ranges: bytes",
+                  "Content-Length: 1544",
+                  "X-RateLimit-Limit: 60",
+                  "X-RateLimit-Remaining: 59",
+                  "X-RateLimit-Reset: 1681759952",
+                  "X-RateLimit-Resource: core",
+                  "X-RateLimit-Used: 1",
+                  "X-Request-Id: 8F1C:2E3A:4B5C6D:7E8F90:643D8F10",
+              })},
+  };
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Previous HttpHeader::Parse, exact-case keys
+static Dictionary ParseDictionary(std::string_view s) {
+  auto dictionary = Dictionary();
+  auto reader = StringReader(s);
+
+  reader.SkipUntil("HTTP").SkipLine();
+
+  while (reader.SkipSpaces().HasNext()) {
+    auto key = reader.ReadUntil(':');
+    auto value = reader.SkipOne().SkipSpaces().ReadToEndLine();
+    dictionary[std::string(key)] = value;
+  }
+
+  return dictionary;
+}
+
+template <typename F>
+double MeasureNsPerOp(F&& iteration) {
+  size_t checksum = 0;
+  Stopwatch stopwatch;
+  for (size_t index = 0; index < kIterations; ++index) {
+    checksum += iteration();
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+  // Keep the results observable
+  WHEELS_VERIFY(checksum > 0, "Lookups must hit");
+  return elapsed * 1e9 / kIterations;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  fmt::println("Iterations: {}, lookups per parse: {}", kIterations, kLookups.size());
+  fmt::println("{:>12} | {:>7} | {:>17} | {:>17} | {:>8}", "Headers", "Fields",
+               "Dictionary ns/op", "HttpHeader ns/op", "Speedup");
+
+  for (auto&& set : MakeHeaderSets()) {
+    const auto fields = HttpHeader::Parse(set.raw).Size();
+
+    const auto dictionary = MeasureNsPerOp([&set] {
+      auto parsed = ParseDictionary(set.raw);
+      size_t found = 0;
+      for (auto name : kLookups) {
+        // Case-insensitive lookups are not possible without normalizing keys,
+        // count exact hits only
+        auto it = parsed.find(name);
+        found += (it != parsed.end()) ? it->second.size() : 0;
+      }
+      return found + parsed.size();
+    });
+
+    const auto flat = MeasureNsPerOp([&set] {
+      auto parsed = HttpHeader::Parse(set.raw);
+      size_t found = 0;
+      for (auto name : kLookups) {
+        found += parsed[name].size();
+      }
+      return found + parsed.Size();
+    });
+
+    fmt::println("{:>12} | {:>7} | {:>17.1f} | {:>17.1f} | {:>7.2f}x", set.name, fields,
+                 dictionary, flat, dictionary / flat);
+  }
+
+  return 0;
+}
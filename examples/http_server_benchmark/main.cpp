@@ -0,0 +1,163 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/concurrency/atomic_counter.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/fibers/api.h>
+#include <magic/net/http/server.h>
+#include <magic/net/socket.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+// wrk-style load against the fiber HTTP server over loopback:
+// every connection is a client fiber that keeps `depth` pipelined GETs
+// in flight for the whole run and records the latency of each batch
+
+static const auto kRunDuration = 2s;
+static const size_t kClientThreads = 2;
+
+struct Scenario {
+  size_t server_threads;
+  size_t connections;
+  size_t depth;
+};
+
+struct Report {
+  double requests_per_second;
+  double p50_us;
+  double p99_us;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Removes complete responses from the front of the buffer, returns their number
+static size_t ConsumeResponses(std::string& buffer) {
+  size_t responses = 0;
+  size_t offset = 0;
+  while (true) {
+    const auto header_end = buffer.find("\r\n\r\n", offset);
+    if (header_end == std::string::npos) {
+      break;
+    }
+    const auto length_at = buffer.find("Content-Length: ", offset) + 16;
+    size_t length = 0;
+    std::from_chars(buffer.data() + length_at, buffer.data() + header_end, length);
+    if (buffer.size() < header_end + 4 + length) {
+      break;
+    }
+    offset = header_end + 4 + length;
+    ++responses;
+  }
+  buffer.erase(0, offset);
+  return responses;
+}
+
+static double Percentile(std::vector<double>& samples, double p) {
+  if (samples.empty()) {
+    return 0;
+  }
+  const auto index = static_cast<size_t>(p * (samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples[index];
+}
+
+//////////////////////////////////////////////////////////////////////
+
+static Report Run(const Scenario& scenario) {
+  ThreadPool server_scheduler{scenario.server_threads};
+  HttpServer server{server_scheduler, [](const HttpServerRequest&) {
+                      return HttpServerResponse{.Body = "Hello, World!"};
+                    }};
+  server.Start("127.0.0.1", 0).ThrowIfError();
+
+  std::string batch;
+  for (size_t index = 0; index < scenario.depth; ++index) {
+    batch += "GET /plaintext HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  }
+
+  std::atomic<bool> stop = false;
+  std::atomic<size_t> completed = 0;
+  std::mutex mutex;
+  std::vector<double> latencies;  // Guarded by mutex
+
+  ThreadPool clients{kClientThreads};
+  AtomicCounter running;
+
+  for (size_t index = 0; index < scenario.connections; ++index) {
+    running.Add();
+    Go(clients, [&] {
+      auto socket = net::Socket::Connect("127.0.0.1", server.Port()).ValueOrThrow();
+      std::string in;
+      char buffer[16 * 1024];
+      std::vector<double> local;
+
+      while (!stop.load(std::memory_order::relaxed)) {
+        Stopwatch stopwatch;
+        WHEELS_VERIFY(socket.WriteAll(batch).IsOk(), "Write failed");
+
+        size_t received = 0;
+        while (received < scenario.depth) {
+          auto bytes = socket.ReadSome(buffer, sizeof(buffer));
+          WHEELS_VERIFY(bytes.IsOk() && *bytes > 0, "Read failed");
+          in.append(buffer, *bytes);
+          received += ConsumeResponses(in);
+        }
+        local.push_back(std::chrono::duration<double, std::micro>(stopwatch.Elapsed()).count());
+        completed.fetch_add(received, std::memory_order::relaxed);
+      }
+
+      std::lock_guard guard(mutex);
+      latencies.insert(latencies.end(), local.begin(), local.end());
+      running.Done();
+    });
+  }
+
+  Stopwatch stopwatch;
+  std::this_thread::sleep_for(kRunDuration);
+  stop.store(true);
+  running.WaitZero();
+  const auto elapsed = stopwatch.Elapsed().count();
+
+  server.Stop();
+  clients.Stop();
+  server_scheduler.Stop();
+
+  return {completed.load() / elapsed, Percentile(latencies, 0.5), Percentile(latencies, 0.99)};
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+
+  const std::vector<Scenario> scenarios = {
+      {1, 64, 1}, {1, 64, 16}, {cores, 64, 1}, {cores, 256, 1}, {cores, 256, 16},
+  };
+
+  fmt::println("Run: {}s per scenario, client threads: {}", kRunDuration.count(),
+               kClientThreads);
+  fmt::println("{:>8} | {:>11} | {:>8} | {:>10} | {:>10} | {:>10}", "Threads", "Connections",
+               "Pipeline", "Req/s", "p50 us", "p99 us");
+
+  for (auto&& scenario : scenarios) {
+    auto report = Run(scenario);
+    fmt::println("{:>8} | {:>11} | {:>8} | {:>10.0f} | {:>10.1f} | {:>10.1f}",
+                 scenario.server_threads, scenario.connections, scenario.depth,
+                 report.requests_per_second, report.p50_us, report.p99_us);
+  }
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/filesystem/file.h>
+#include <magic/filesystem/mapped_file.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <sys/resource.h>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Line-by-line read of a large generated text file:
+// File::ReadAllLines (ifstream + getline, one std::string per line) vs
+// MappedFile::Lines (string_views into the mapping, memchr scan)
+
+// The file is read once to warm up the page cache, so both runs measure
+// the parsing and the copying, not the disk
+
+static const char* kPath = "mapped_file_benchmark.txt";
+static const size_t kFileSize = 512 << 20;
+
+//////////////////////////////////////////////////////////////////////
+
+// Log-like lines of 20..200 bytes
+static void GenerateFile(const char* path, size_t size) {
+  std::ofstream file(path);
+  std::mt19937_64 engine(42);
+  std::uniform_int_distribution<size_t> length(20, 200);
+  std::uniform_int_distribution<int> letter('a', 'z');
+
+  std::string line;
+  size_t written = 0;
+  while (written < size) {
+    line.assign(length(engine), ' ');
+    for (auto& c : line) {
+      c = letter(engine);
+    }
+    file << line << '\n';
+    written += line.size() + 1;
+  }
+}
+
+// Peak resident set size so far
+static size_t MaxRssMiB() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss / 1024;
+}
+
+struct Report {
+  double seconds;
+  size_t lines;
+  size_t bytes;
+};
+
+template <typename F>
+Report Measure(F&& read) {
+  Stopwatch stopwatch;
+  auto [lines, bytes] = read();
+  return {stopwatch.Elapsed().count(), lines, bytes};
+}
+
+static void Print(const char* name, const Report& report) {
+  const double mib = report.bytes / double(1 << 20);
+  fmt::println("{:>22} | {:>10} | {:>8.3f} | {:>10.1f} | {:>12}", name, report.lines,
+               report.seconds, mib / report.seconds, MaxRssMiB());
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  GenerateFile(kPath, kFileSize);
+
+  // Warm up the page cache
+  {
+    auto file = MappedFile::Open(kPath).ValueOrThrow();
+    size_t checksum = 0;
+    for (size_t offset = 0; offset < file.Size(); offset += 4096) {
+      checksum += file.Data()[offset];
+    }
+    WHEELS_VERIFY(checksum > 0, "Pages must be touched");
+  }
+
+  fmt::println("File: {} MiB", kFileSize >> 20);
+  fmt::println("{:>22} | {:>10} | {:>8} | {:>10} | {:>12}", "Reader", "Lines", "Seconds",
+               "MiB/s", "Max RSS MiB");
+
+  // The mapping does not count towards the peak of ReadAllLines: run it first
+  auto mapped = Measure([] {
+    auto file = MappedFile::Open(kPath).ValueOrThrow();
+    size_t lines = 0, bytes = 0;
+    for (auto line : file.Lines()) {
+      ++lines;
+      bytes += line.size() + 1;
+    }
+    return std::pair{lines, bytes};
+  });
+  Print("MappedFile::Lines", mapped);
+
+  auto read_all = Measure([] {
+    auto lines = File::ReadAllLines(kPath).ValueOrThrow();
+    size_t bytes = 0;
+    for (auto&& line : lines) {
+      bytes += line.size() + 1;
+    }
+    return std::pair{lines.size(), bytes};
+  });
+  Print("File::ReadAllLines", read_all);
+
+  WHEELS_VERIFY(mapped.lines == read_all.lines && mapped.bytes == read_all.bytes,
+                "Readers must see the same lines");
+  fmt::println("Speedup: {:.2f}x", read_all.seconds / mapped.seconds);
+
+  std::remove(kPath);
+  return 0;
+}
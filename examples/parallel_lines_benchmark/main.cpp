@@ -0,0 +1,129 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/filesystem/mapped_file.h>
+#include <magic/filesystem/parallel.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// MapReduceLines scaling over a log-like file in the page cache
+// Every line is parsed as "<level> <status> <payload>": the job counts
+// lines per level and sums the status codes, the result is checked
+// against a single-threaded pass
+
+static const char* kPath = "parallel_lines_benchmark.txt";
+static const size_t kFileSize = 1ull << 30;
+static const size_t kRepeats = 3;
+
+static const std::array<std::string_view, 4> kLevels = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+struct LogStats {
+  std::array<size_t, 4> levels{};
+  size_t status_sum = 0;
+
+  void Add(std::string_view line) {
+    for (size_t index = 0; index < kLevels.size(); ++index) {
+      if (line.starts_with(kLevels[index])) {
+        ++levels[index];
+        auto status = line.substr(kLevels[index].size() + 1, 3);
+        status_sum += (status[0] - '0') * 100 + (status[1] - '0') * 10 + (status[2] - '0');
+        return;
+      }
+    }
+  }
+
+  void Merge(const LogStats& that) {
+    for (size_t index = 0; index < levels.size(); ++index) {
+      levels[index] += that.levels[index];
+    }
+    status_sum += that.status_sum;
+  }
+
+  bool operator==(const LogStats&) const = default;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+static void GenerateFile(const char* path, size_t size) {
+  std::ofstream file(path);
+  std::mt19937_64 engine(42);
+  std::uniform_int_distribution<size_t> level(0, kLevels.size() - 1);
+  std::uniform_int_distribution<int> status(200, 599);
+  std::uniform_int_distribution<size_t> length(20, 160);
+
+  std::string line;
+  size_t written = 0;
+  while (written < size) {
+    line = fmt::format("{} {} {}", kLevels[level(engine)], status(engine),
+                       std::string(length(engine), 'p'));
+    file << line << '\n';
+    written += line.size() + 1;
+  }
+}
+
+static double MeasureGBps(size_t threads, size_t bytes, const LogStats& expected) {
+  ThreadPool pool{threads};
+
+  double best = 0;
+  for (size_t repeat = 0; repeat < kRepeats; ++repeat) {
+    Stopwatch stopwatch;
+    auto stats = MapReduceLines<LogStats>(
+                     kPath, pool,
+                     [](LogStats& stats, std::string_view line) {
+                       stats.Add(line);
+                     },
+                     [](LogStats& total, LogStats partial) {
+                       total.Merge(partial);
+                     })
+                     .ValueOrThrow();
+    const auto elapsed = stopwatch.Elapsed().count();
+
+    WHEELS_VERIFY(stats == expected, "Parallel result must match the sequential one");
+    best = std::max(best, bytes / elapsed / 1e9);
+  }
+
+  pool.Stop();
+  return best;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  GenerateFile(kPath, kFileSize);
+
+  // Sequential reference, also warms up the page cache
+  auto file = MappedFile::Open(kPath).ValueOrThrow();
+  LogStats expected;
+  for (auto line : file.Lines()) {
+    expected.Add(line);
+  }
+
+  const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+  fmt::println("File: {} MiB, best of {} runs, {} hardware threads", file.Size() >> 20, kRepeats,
+               cores);
+  fmt::println("{:>8} | {:>8} | {:>8}", "Threads", "GB/s", "Scaling");
+
+  double single = 0;
+  for (size_t threads = 1; threads <= std::max<size_t>(cores, 2); threads *= 2) {
+    const auto gbps = MeasureGBps(threads, file.Size(), expected);
+    single = (threads == 1) ? gbps : single;
+    fmt::println("{:>8} | {:>8.2f} | {:>7.2f}x", threads, gbps, gbps / single);
+  }
+
+  std::remove(kPath);
+  return 0;
+}
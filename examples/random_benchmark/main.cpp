@@ -0,0 +1,139 @@
+#include <fmt/core.h>
+
+#include <magic/common/generators/data_generator.h>
+#include <magic/common/generators/random_generator.h>
+#include <magic/common/stopwatch.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <random>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Payload generation, bounded integers and seeding: the previous
+// std::mt19937-based generators vs xoshiro256** / wyrand
+
+static const size_t kPayloadBytes = 256 << 20;
+static const size_t kChunkSize = 64 << 10;
+static const size_t kIterations = 20'000'000;
+static const size_t kSeedings = 20'000;
+
+//////////////////////////////////////////////////////////////////////
+
+// Previous implementations
+class PreviousDataGenerator {
+ public:
+  explicit PreviousDataGenerator(size_t bytes) : bytes_left_(bytes) {
+  }
+
+  bool HasNext() const {
+    return bytes_left_ > 0;
+  }
+
+  size_t NextChunk(char* buffer, size_t limit) {
+    auto bytes = std::min(bytes_left_, limit);
+    for (size_t index = 0; index < bytes; ++index) {
+      buffer[index] = 'A' + twister_() % 26;
+    }
+    bytes_left_ -= bytes;
+    return bytes;
+  }
+
+ private:
+  size_t bytes_left_;
+  std::mt19937 twister_{42};
+};
+
+class PreviousRandomGenerator {
+ public:
+  explicit PreviousRandomGenerator(size_t seed) : twister_(seed) {
+  }
+
+  uint32_t Next(uint32_t min_value, uint32_t max_value) {
+    return std::uniform_int_distribution<uint32_t>(min_value, max_value)(twister_);
+  }
+
+ private:
+  std::mt19937_64 twister_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+template <typename Generator>
+double MeasureBytesPerSecond() {
+  std::vector<char> buffer(kChunkSize);
+  Generator generator{kPayloadBytes};
+  size_t checksum = 0;
+  Stopwatch stopwatch;
+  while (generator.HasNext()) {
+    const size_t bytes = generator.NextChunk(buffer.data(), buffer.size());
+    checksum += buffer[bytes - 1];
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+  WHEELS_VERIFY(checksum > 0, "Generators must produce something");
+  return kPayloadBytes / elapsed;
+}
+
+template <typename F>
+double MeasureNsPerOp(F&& iteration, size_t iterations) {
+  uint64_t checksum = 0;
+  Stopwatch stopwatch;
+  for (size_t index = 0; index < iterations; ++index) {
+    checksum += iteration(index);
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+  // Keep the results observable
+  WHEELS_VERIFY(checksum > 0, "Generators must produce something");
+  return elapsed * 1e9 / iterations;
+}
+
+static void Report(const char* name, double before, double after, const char* unit,
+                   double speedup) {
+  fmt::println("{:>22} | {:>12.1f} | {:>12.1f} | {:>6} | {:>7.2f}x", name, before, after, unit,
+               speedup);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  fmt::println("{:>22} | {:>12} | {:>12} | {:>6} | {:>8}", "Workload", "Before", "After", "Unit",
+               "Speedup");
+
+  const auto payload_before = MeasureBytesPerSecond<PreviousDataGenerator>();
+  const auto payload_after = MeasureBytesPerSecond<DataGenerator>();
+  Report("payload, 64 KiB chunks", payload_before / 1e6, payload_after / 1e6, "MB/s",
+         payload_after / payload_before);
+
+  PreviousRandomGenerator previous{42};
+  RandomGenerator current{42};
+  const auto next_before = MeasureNsPerOp(
+      [&](size_t) {
+        return previous.Next(1, 1000);
+      },
+      kIterations);
+  const auto next_after = MeasureNsPerOp(
+      [&](size_t) {
+        return current.Next(1u, 1000u);
+      },
+      kIterations);
+  Report("Next(1, 1000)", next_before, next_after, "ns/op", next_before / next_after);
+
+  const auto seed_before = MeasureNsPerOp(
+      [&](size_t index) {
+        PreviousRandomGenerator generator{index};
+        return generator.Next(1, 1000);
+      },
+      kSeedings);
+  const auto seed_after = MeasureNsPerOp(
+      [&](size_t index) {
+        RandomGenerator generator{index};
+        return generator.Next(1u, 1000u);
+      },
+      kSeedings);
+  Report("seed + first value", seed_before, seed_after, "ns/op", seed_before / seed_after);
+
+  return 0;
+}
@@ -0,0 +1,163 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/concurrency/seqlock.h>
+#include <magic/concurrency/shared_mutex.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Read-mostly shared snapshot: readers copy it, writers bump every field
+// Mixes: 99% / 1% and 90% / 10% reads / writes
+
+static const size_t kOpsPerThread = 1'000'000;
+
+struct Stats {
+  uint64_t values[8] = {};
+};
+
+struct Mix {
+  const char* name;
+  uint32_t writes_per_mille;
+};
+
+// Cheap per-thread operation selector, must not dominate the measurement
+class XorShift final {
+ public:
+  explicit XorShift(uint64_t seed) : state_(seed * 0x9E3779B97F4A7C15ull + 1) {
+  }
+
+  uint64_t Next() {
+    state_ ^= state_ << 13;
+    state_ ^= state_ >> 7;
+    state_ ^= state_ << 17;
+    return state_;
+  }
+
+ private:
+  uint64_t state_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+template <typename Mutex>
+struct Exclusive {
+  Mutex mutex;
+  Stats stats;
+
+  Stats Read() {
+    std::lock_guard lock(mutex);
+    return stats;
+  }
+
+  void Write() {
+    std::lock_guard lock(mutex);
+    for (auto& value : stats.values) {
+      ++value;
+    }
+  }
+};
+
+template <typename Mutex>
+struct Shared {
+  Mutex mutex;
+  Stats stats;
+
+  Stats Read() {
+    std::shared_lock lock(mutex);
+    return stats;
+  }
+
+  void Write() {
+    std::lock_guard lock(mutex);
+    for (auto& value : stats.values) {
+      ++value;
+    }
+  }
+};
+
+struct Sequenced {
+  SeqLock<Stats> stats;
+
+  Stats Read() {
+    return stats.Load();
+  }
+
+  void Write() {
+    stats.Update([](Stats& stats) {
+      for (auto& value : stats.values) {
+        ++value;
+      }
+    });
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+template <typename Guarded>
+double RunMix(const Mix& mix, size_t threads) {
+  Guarded guarded;
+  std::atomic<uint64_t> checksum = 0;
+
+  Stopwatch stopwatch;
+
+  std::vector<std::thread> workers;
+  for (size_t thread = 0; thread < threads; ++thread) {
+    workers.emplace_back([&, thread] {
+      XorShift random{thread};
+      uint64_t sum = 0;
+      for (size_t op = 0; op < kOpsPerThread; ++op) {
+        if (random.Next() % 1000 < mix.writes_per_mille) {
+          guarded.Write();
+        } else {
+          auto stats = guarded.Read();
+          // Snapshots must be consistent
+          WHEELS_VERIFY(stats.values[0] == stats.values[7], "Torn read");
+          sum += stats.values[0];
+        }
+      }
+      checksum.fetch_add(sum, std::memory_order::relaxed);
+    });
+  }
+
+  for (auto&& worker : workers) {
+    worker.join();
+  }
+
+  return (threads * kOpsPerThread) / stopwatch.Elapsed().count() / 1'000'000;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  const auto mixes = std::vector<Mix>{{"99/1", 10}, {"90/10", 100}};
+  const size_t max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+  fmt::println("Ops/thread: {}, snapshot: {} bytes", kOpsPerThread, sizeof(Stats));
+  fmt::println("{:>6} | {:>7} | {:>10} | {:>17} | {:>11} | {:>7}", "Mix", "Threads", "std::mutex",
+               "std::shared_mutex", "SharedMutex", "SeqLock");
+
+  for (auto&& mix : mixes) {
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+      auto mutex = RunMix<Exclusive<std::mutex>>(mix, threads);
+      auto std_shared = RunMix<Shared<std::shared_mutex>>(mix, threads);
+      auto shared = RunMix<Shared<SharedMutex>>(mix, threads);
+      auto seqlock = RunMix<Sequenced>(mix, threads);
+      fmt::println("{:>6} | {:>7} | {:>10.2f} | {:>17.2f} | {:>11.2f} | {:>7.2f}", mix.name,
+                   threads, mutex, std_shared, shared, seqlock);
+    }
+  }
+  fmt::println("(Mops/s)");
+
+  return 0;
+}
@@ -0,0 +1,162 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/common/string_builder.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Building log lines and JSON documents: the previous std::ostringstream-based
+// StringBuilder vs the growable buffer, appending with << in both cases plus
+// AppendFormat for the new one
+
+static const size_t kIterations = 200'000;
+
+//////////////////////////////////////////////////////////////////////
+
+// Previous implementation
+class PreviousStringBuilder {
+ public:
+  template <typename T>
+  PreviousStringBuilder& operator<<(const T& next) {
+    buffer_ << next;
+    return *this;
+  }
+
+  std::string ToString() const {
+    return buffer_.str();
+  }
+
+ private:
+  std::ostringstream buffer_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+struct Request {
+  uint64_t id;
+  std::string method;
+  std::string path;
+  int status;
+  size_t bytes;
+  double elapsed_ms;
+};
+
+static std::vector<Request> MakeRequests() {
+  std::vector<Request> requests;
+  for (uint64_t index = 0; index < 64; ++index) {
+    requests.push_back({index * 7919, index % 3 == 0 ? "POST" : "GET",
+                        fmt::format("/api/v1/items/{}/details", index * 31), 200 + int(index % 5),
+                        1024 + index * 97, 0.25 + index * 0.5});
+  }
+  return requests;
+}
+
+template <typename Builder>
+std::string LogLine(const Request& request) {
+  Builder builder;
+  builder << "2024-01-01T12:00:00.000Z INFO [http] id=" << request.id << " " << request.method
+          << " " << request.path << " status=" << request.status << " bytes=" << request.bytes
+          << " elapsed_ms=" << request.elapsed_ms << '\n';
+  return builder.ToString();
+}
+
+static std::string LogLineFormat(const Request& request) {
+  StringBuilder builder;
+  builder.AppendFormat("2024-01-01T12:00:00.000Z INFO [http] id={} {} {} status={} bytes={} "
+                       "elapsed_ms={}\n",
+                       request.id, request.method, request.path, request.status, request.bytes,
+                       request.elapsed_ms);
+  return builder.Release();
+}
+
+template <typename Builder>
+std::string Json(const std::vector<Request>& requests) {
+  Builder builder;
+  builder << "{\"requests\":[";
+  for (size_t index = 0; index < requests.size(); ++index) {
+    const auto& request = requests[index];
+    if (index > 0) {
+      builder << ',';
+    }
+    builder << "{\"id\":" << request.id << ",\"method\":\"" << request.method << "\",\"path\":\""
+            << request.path << "\",\"status\":" << request.status << ",\"bytes\":"
+            << request.bytes << '}';
+  }
+  builder << "]}";
+  if constexpr (std::is_same_v<Builder, StringBuilder>) {
+    return builder.Release();
+  } else {
+    return builder.ToString();
+  }
+}
+
+template <typename F>
+double MeasureNsPerOp(F&& iteration, size_t iterations) {
+  size_t checksum = 0;
+  Stopwatch stopwatch;
+  for (size_t index = 0; index < iterations; ++index) {
+    checksum += iteration(index);
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+  // Keep the results observable
+  WHEELS_VERIFY(checksum > 0, "Builders must produce something");
+  return elapsed * 1e9 / iterations;
+}
+
+static void Report(const char* name, double before, double after) {
+  fmt::println("{:>22} | {:>13.0f} | {:>13.0f} | {:>7.2f}x", name, before, after, before / after);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  const auto requests = MakeRequests();
+
+  WHEELS_VERIFY(LogLine<PreviousStringBuilder>(requests[1]) == LogLine<StringBuilder>(requests[1]),
+                "Builders must agree");
+  WHEELS_VERIFY(Json<PreviousStringBuilder>(requests) == Json<StringBuilder>(requests),
+                "Builders must agree");
+
+  fmt::println("{:>22} | {:>13} | {:>13} | {:>8}", "Workload", "Before ns/op", "After ns/op",
+               "Speedup");
+
+  const auto line_before = MeasureNsPerOp(
+      [&](size_t index) {
+        return LogLine<PreviousStringBuilder>(requests[index % requests.size()]).size();
+      },
+      kIterations);
+  const auto line_after = MeasureNsPerOp(
+      [&](size_t index) {
+        return LogLine<StringBuilder>(requests[index % requests.size()]).size();
+      },
+      kIterations);
+  const auto line_format = MeasureNsPerOp(
+      [&](size_t index) {
+        return LogLineFormat(requests[index % requests.size()]).size();
+      },
+      kIterations);
+  Report("log line <<", line_before, line_after);
+  Report("log line AppendFormat", line_before, line_format);
+
+  const auto json_before = MeasureNsPerOp(
+      [&](size_t) {
+        return Json<PreviousStringBuilder>(requests).size();
+      },
+      kIterations / 64);
+  const auto json_after = MeasureNsPerOp(
+      [&](size_t) {
+        return Json<StringBuilder>(requests).size();
+      },
+      kIterations / 64);
+  Report("json, 64 objects", json_before, json_after);
+
+  return 0;
+}
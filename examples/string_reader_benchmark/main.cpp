@@ -0,0 +1,214 @@
+#include <fmt/core.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/common/string_reader.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <cctype>
+#include <string>
+#include <string_view>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// StringReader scanning and number parsing: the previous char-by-char
+// implementation (isspace / isdigit loops, std::stod) vs the vectorized
+// kernels and in-place from_chars
+
+static const size_t kIterations = 20'000;
+
+//////////////////////////////////////////////////////////////////////
+
+// Previous implementation, the methods used below
+class PreviousStringReader {
+ public:
+  PreviousStringReader(std::string_view s) : source_(s) {
+  }
+
+  bool HasNext() const {
+    return !source_.empty();
+  }
+
+  char NextChar() const {
+    return source_[0];
+  }
+
+  bool Next(char ch) const {
+    return NextChar() == ch;
+  }
+
+  PreviousStringReader& SkipOne() {
+    source_.remove_prefix(1);
+    return *this;
+  }
+
+  PreviousStringReader& SkipSpaces() {
+    while (HasNext() && isspace(NextChar()) != 0) {
+      SkipOne();
+    }
+    return *this;
+  }
+
+  PreviousStringReader& SkipDigits() {
+    while (HasNext() && isdigit(NextChar()) != 0) {
+      SkipOne();
+    }
+    return *this;
+  }
+
+  PreviousStringReader& SkipAfter(char ch) {
+    auto offset = source_.find_first_of(ch);
+    offset = (offset == std::string_view::npos) ? source_.length() : offset + 1;
+    source_.remove_prefix(offset);
+    return *this;
+  }
+
+  PreviousStringReader& SkipLine() {
+    SkipAfter('\n');
+    if (HasNext() && Next('\r')) {
+      SkipOne();
+    }
+    return *this;
+  }
+
+  std::string_view ReadUntil(char ch) {
+    if (!HasNext() || NextChar() == ch) {
+      return {};
+    }
+    const auto offset = source_.find_first_of(ch);
+    if (offset == std::string_view::npos) {
+      source_.remove_prefix(source_.length());
+      return {};
+    }
+    auto result = source_.substr(0, offset);
+    source_.remove_prefix(offset);
+    return result;
+  }
+
+  std::string_view ReadToEndLine() {
+    auto result = ReadUntil('\n');
+    SkipLine();
+    return result;
+  }
+
+  double ReadDouble() {
+    auto string = source_;
+    SkipDigits();
+    if (HasNext() && (Next('.') || Next(','))) {
+      SkipOne().SkipDigits();
+    }
+    // Relies on the text after the view to stop the parse
+    return std::stod(string.data());
+  }
+
+ private:
+  std::string_view source_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+static std::string MakeHeaders() {
+  std::string raw = "HTTP/1.1 200 OK\r\n";
+  for (size_t index = 0; index < 40; ++index) {
+    raw += fmt::format("X-Custom-Header-{}: value-{}; max-age=31536000; includeSubdomains\r\n",
+                       index, index * 7919);
+  }
+  return raw + "\r\n";
+}
+
+// Indented lines, as in pretty-printed JSON or YAML
+static std::string MakeIndented() {
+  std::string text;
+  for (size_t index = 0; index < 200; ++index) {
+    text += std::string(4 * (1 + index % 12), ' ') + fmt::format("\"key{}\": {},\n", index, index);
+  }
+  return text;
+}
+
+static std::string MakeNumbers() {
+  std::string text;
+  for (size_t index = 0; index < 200; ++index) {
+    text += fmt::format("{}.{:03} ", index * 104729 % 1'000'000, index % 1000);
+  }
+  return text;
+}
+
+template <typename Reader>
+size_t ParseHeaders(std::string_view raw) {
+  auto reader = Reader(raw);
+  reader.SkipLine();
+
+  size_t total = 0;
+  while (reader.SkipSpaces().HasNext()) {
+    auto key = reader.ReadUntil(':');
+    auto value = reader.SkipOne().SkipSpaces().ReadToEndLine();
+    total += key.size() + value.size();
+  }
+  return total;
+}
+
+template <typename Reader>
+size_t SkipIndents(std::string_view text) {
+  auto reader = Reader(text);
+  size_t total = 0;
+  while (reader.SkipSpaces().HasNext()) {
+    total += reader.ReadToEndLine().size();
+  }
+  return total;
+}
+
+template <typename Reader>
+size_t ParseNumbers(std::string_view text) {
+  auto reader = Reader(text);
+  double total = 0;
+  while (reader.SkipSpaces().HasNext()) {
+    total += reader.ReadDouble();
+  }
+  return static_cast<size_t>(total);
+}
+
+template <typename F>
+double MeasureNsPerOp(F&& iteration) {
+  size_t checksum = 0;
+  Stopwatch stopwatch;
+  for (size_t index = 0; index < kIterations; ++index) {
+    checksum += iteration();
+  }
+  const auto elapsed = stopwatch.Elapsed().count();
+  // Keep the results observable
+  WHEELS_VERIFY(checksum > 0, "Parsing must produce something");
+  return elapsed * 1e9 / kIterations;
+}
+
+template <size_t (*Previous)(std::string_view), size_t (*Current)(std::string_view)>
+void Compare(const char* name, const std::string& input) {
+  WHEELS_VERIFY(Previous(input) == Current(input), "Readers must agree");
+
+  const auto before = MeasureNsPerOp([&] {
+    return Previous(input);
+  });
+  const auto after = MeasureNsPerOp([&] {
+    return Current(input);
+  });
+  fmt::println("{:>16} | {:>8} | {:>13.0f} | {:>13.0f} | {:>7.2f}x", name, input.size(), before,
+               after, before / after);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int main() {
+  fmt::println("Iterations: {}", kIterations);
+  fmt::println("{:>16} | {:>8} | {:>13} | {:>13} | {:>8}", "Workload", "Bytes", "Before ns/op",
+               "After ns/op", "Speedup");
+
+  Compare<ParseHeaders<PreviousStringReader>, ParseHeaders<StringReader>>("http headers",
+                                                                          MakeHeaders());
+  Compare<SkipIndents<PreviousStringReader>, SkipIndents<StringReader>>("indented lines",
+                                                                        MakeIndented());
+  Compare<ParseNumbers<PreviousStringReader>, ParseNumbers<StringReader>>("doubles",
+                                                                          MakeNumbers());
+
+  return 0;
+}
@@ -1,13 +1,12 @@
 #include <fmt/core.h>
 
+#include <magic/common/histogram.h>
 #include <magic/common/stopwatch.h>
 
 #include <magic/executors/thread_pool.h>
 #include <magic/fibers/sync/mutex.h>
 #include <magic/fibers/sync/wait_group.h>
 
-#include <vector>
-#include <numeric>
 
 using namespace magic;
 using namespace magic::fibers;
@@ -53,9 +52,11 @@ void WorkloadMutex() {
 
 ////////////////////////////////////////////////////////////////////////
 
-auto RunBenchmark() {
+// Fiber slices between suspensions run as thread pool tasks
+auto RunBenchmark(Histogram& task_times) {
   Stopwatch stopwatch;
   ThreadPool scheduler(4);
+  scheduler.RecordTaskTimes(&task_times);
 
   Go(scheduler, [] {
     WorkloadMutex();
@@ -65,9 +66,7 @@ auto RunBenchmark() {
   scheduler.Stop();
 
   const auto elapsed = stopwatch.Elapsed();
-
-  //  const auto elapsedMs = stopwatch.ElapsedMs();
-  fmt::println("~({} ms) elapsed", elapsed.Millisecond());
+  fmt::println("~({} ms) elapsed", stopwatch.ElapsedMs());
 
   return elapsed;
 }
@@ -77,14 +76,14 @@ auto RunBenchmark() {
 int main() {
   static const size_t kIteration = 1;
 
-  auto metrics = std::vector<size_t>(kIteration);
+  Histogram run_times;
+  Histogram task_times;
   for (size_t index = 0; index < kIteration; ++index) {
-    auto elapsed = RunBenchmark();
-    metrics.push_back(elapsed.Millisecond());
+    run_times.Record(RunBenchmark(task_times));
   }
 
-  auto average = std::reduce(metrics.begin(), metrics.end()) / kIteration;
-  fmt::println("\nAverage: {} ms", average);
+  fmt::println("\nRun, ns: {}", run_times.Snapshot().ToString());
+  fmt::println("Task, ns: {}", task_times.Snapshot().ToString());
 
   return 0;
 }
\ No newline at end of file
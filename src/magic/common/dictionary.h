@@ -1,5 +1,8 @@
 #pragma once
 
+#include <magic/common/flat_hash_map.h>
+#include <magic/common/hash.h>
+
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -11,22 +14,28 @@ namespace magic {
 namespace detail {
 
 struct StringHash {
-  using hash_type = std::hash<std::string_view>;
   using is_transparent = void;
 
   std::size_t operator()(const char* str) const {
-    return hash_type{}(str);
+    return HashString(str);
   }
   std::size_t operator()(std::string_view str) const {
-    return hash_type{}(str);
+    return HashString(str);
   }
   std::size_t operator()(std::string const& str) const {
-    return hash_type{}(str);
+    return HashString(str);
   }
 };
 
 }  // namespace detail
 
+// Built with MAGIC_FLAT_DICTIONARY, Dictionary is the open-addressing FlatHashMap:
+// faster, but inserts invalidate references and iterators
+
+#if defined(MAGIC_FLAT_DICTIONARY)
+using Dictionary = FlatHashMap<std::string, std::string, detail::StringHash, std::equal_to<>>;
+#else
 using Dictionary = std::unordered_map<std::string, std::string, detail::StringHash, std::equal_to<>>;
+#endif
 
 }  // namespace magic
\ No newline at end of file
@@ -0,0 +1,558 @@
+#pragma once
+
+#include <wheels/core/assert.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// One control byte per slot:
+// full slots keep the low 7 bits of the hash (H2), the sign bit marks
+// empty and deleted slots, so a single compare checks 16 slots at once
+using ControlByte = int8_t;
+
+const ControlByte kEmptySlot = -128;
+const ControlByte kDeletedSlot = -2;
+
+// 16 control bytes probed together, bit i of a mask - slot i of the group
+class ControlGroup {
+ public:
+  static const size_t kWidth = 16;
+
+  explicit ControlGroup(const ControlByte* control) : control_(control) {
+  }
+
+#if defined(__SSE2__)
+  uint32_t Match(ControlByte h2) const {
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(Load(), _mm_set1_epi8(h2)));
+  }
+
+  uint32_t MatchEmpty() const {
+    return Match(kEmptySlot);
+  }
+
+  uint32_t MatchEmptyOrDeleted() const {
+    return _mm_movemask_epi8(Load());
+  }
+
+ private:
+  __m128i Load() const {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(control_));
+  }
+#else
+  uint32_t Match(ControlByte h2) const {
+    uint32_t mask = 0;
+    for (size_t index = 0; index < kWidth; ++index) {
+      mask |= uint32_t(control_[index] == h2) << index;
+    }
+    return mask;
+  }
+
+  uint32_t MatchEmpty() const {
+    return Match(kEmptySlot);
+  }
+
+  uint32_t MatchEmptyOrDeleted() const {
+    uint32_t mask = 0;
+    for (size_t index = 0; index < kWidth; ++index) {
+      mask |= uint32_t(control_[index] < 0) << index;
+    }
+    return mask;
+  }
+#endif
+
+ private:
+  const ControlByte* control_;
+};
+
+// Spreads the entropy of weak hashes (identity std::hash for integers)
+// over the bits used for H1 and H2
+inline uint64_t MixHash(uint64_t hash) {
+  const __uint128_t product = static_cast<__uint128_t>(hash) * 0x9e3779b97f4a7c15ull;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Open-addressing hash map in the SwissTable layout
+// - Keys and values are stored inline in one slot array, no node per entry
+// - A parallel array of control bytes is probed 16 slots per SSE2 compare,
+//   key comparisons happen only for slots whose 7 hash bits match
+// - Groups are probed triangularly, erase leaves a tombstone only if the
+//   group has never had a free slot, the load factor is capped at 7/8
+
+// Differences from std::unordered_map: inserts and rehashes move entries,
+// so references and iterators are invalidated by any insert;
+// value_type is std::pair<Key, Value>, keys must not be modified in place
+
+// Lookups are heterogeneous when Hash and KeyEqual accept the argument type
+
+// Usage:
+// FlatHashMap<std::string, int, StringHash> counts;
+// ++counts["key"];
+// if (auto it = counts.find(std::string_view{"key"}); it != counts.end()) { ... }
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<>>
+class FlatHashMap final {
+  using ControlByte = detail::ControlByte;
+  using Group = detail::ControlGroup;
+
+  static const size_t kGroupWidth = Group::kWidth;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using size_type = size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+
+  //////////////////////////////////////////////////////////////////////
+
+  template <bool Const>
+  class Iterator {
+    friend class FlatHashMap;
+    template <bool>
+    friend class Iterator;
+    using Map = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = FlatHashMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+    using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+    Iterator() = default;
+
+    // iterator -> const_iterator
+    template <bool OtherConst>
+      requires(Const && !OtherConst)
+    Iterator(const Iterator<OtherConst>& that) : map_(that.map_), index_(that.index_) {
+    }
+
+    reference operator*() const {
+      return map_->slots_[index_];
+    }
+
+    pointer operator->() const {
+      return &map_->slots_[index_];
+    }
+
+    Iterator& operator++() {
+      index_ = map_->NextFull(index_ + 1);
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    template <bool OtherConst>
+    bool operator==(const Iterator<OtherConst>& that) const {
+      return index_ == that.index_;
+    }
+
+   private:
+    Iterator(Map* map, size_t index) : map_(map), index_(index) {
+    }
+
+   private:
+    Map* map_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  //////////////////////////////////////////////////////////////////////
+
+  FlatHashMap() = default;
+
+  FlatHashMap(std::initializer_list<value_type> values) {
+    reserve(values.size());
+    for (auto&& value : values) {
+      insert(value);
+    }
+  }
+
+  FlatHashMap(const FlatHashMap& that) : hasher_(that.hasher_), equal_(that.equal_) {
+    reserve(that.size());
+    for (auto&& value : that) {
+      insert(value);
+    }
+  }
+
+  FlatHashMap& operator=(const FlatHashMap& that) {
+    if (this != &that) {
+      FlatHashMap copy(that);
+      Swap(copy);
+    }
+    return *this;
+  }
+
+  FlatHashMap(FlatHashMap&& that) noexcept {
+    Swap(that);
+  }
+
+  FlatHashMap& operator=(FlatHashMap&& that) noexcept {
+    Swap(that);
+    return *this;
+  }
+
+  ~FlatHashMap() {
+    Destroy();
+  }
+
+  // ~ Public Interface
+
+  size_t size() const {
+    return size_;
+  }
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_t capacity() const {
+    return capacity_;
+  }
+
+  iterator begin() {
+    return {this, NextFull(0)};
+  }
+
+  iterator end() {
+    return {this, capacity_};
+  }
+
+  const_iterator begin() const {
+    return {this, NextFull(0)};
+  }
+
+  const_iterator end() const {
+    return {this, capacity_};
+  }
+
+  template <typename K>
+  iterator find(const K& key) {
+    return {this, FindIndex(key, HashOf(key))};
+  }
+
+  template <typename K>
+  const_iterator find(const K& key) const {
+    return {this, FindIndex(key, HashOf(key))};
+  }
+
+  template <typename K>
+  bool contains(const K& key) const {
+    return FindIndex(key, HashOf(key)) != capacity_;
+  }
+
+  template <typename K>
+  size_t count(const K& key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  template <typename K>
+  Value& at(const K& key) {
+    const size_t index = FindIndex(key, HashOf(key));
+    if (index == capacity_) {
+      throw std::out_of_range("FlatHashMap::at");
+    }
+    return slots_[index].second;
+  }
+
+  template <typename K>
+  const Value& at(const K& key) const {
+    return const_cast<FlatHashMap*>(this)->at(key);
+  }
+
+  // Inserts a default-constructed value for a missing key,
+  // the key is converted to Key only then
+  template <typename K>
+  Value& operator[](K&& key) {
+    return try_emplace(std::forward<K>(key)).first->second;
+  }
+
+  // Does nothing if the key is present, the arguments are not consumed then
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    const uint64_t hash = HashOf(key);
+    if (const size_t index = FindIndex(key, hash); index != capacity_) {
+      return {{this, index}, false};
+    }
+    const size_t index = PrepareInsert(hash);
+    new (&slots_[index]) value_type(std::piecewise_construct,
+                                    std::forward_as_tuple(std::forward<K>(key)),
+                                    std::forward_as_tuple(std::forward<Args>(args)...));
+    return {{this, index}, true};
+  }
+
+  template <typename K, typename V>
+  std::pair<iterator, bool> emplace(K&& key, V&& value) {
+    return try_emplace(std::forward<K>(key), std::forward<V>(value));
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return try_emplace(std::move(value.first), std::move(value.second));
+  }
+
+  template <typename K, typename V>
+  std::pair<iterator, bool> insert_or_assign(K&& key, V&& value) {
+    auto [it, inserted] = try_emplace(std::forward<K>(key), std::forward<V>(value));
+    if (!inserted) {
+      it->second = std::forward<V>(value);
+    }
+    return {it, inserted};
+  }
+
+  template <typename K>
+    requires(!std::is_convertible_v<const K&, const_iterator>)
+  size_t erase(const K& key) {
+    const size_t index = FindIndex(key, HashOf(key));
+    if (index == capacity_) {
+      return 0;
+    }
+    EraseAt(index);
+    return 1;
+  }
+
+  // Returns the iterator following the erased entry
+  iterator erase(const_iterator position) {
+    EraseAt(position.index_);
+    return {this, NextFull(position.index_ + 1)};
+  }
+
+  void clear() {
+    Destroy();
+  }
+
+  // Room for `count` entries without rehashing
+  void reserve(size_t count) {
+    size_t capacity = kGroupWidth;
+    while (MaxLoad(capacity) < count) {
+      capacity *= 2;
+    }
+    if (capacity > capacity_) {
+      Rehash(capacity);
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  static size_t MaxLoad(size_t capacity) {
+    return capacity / 8 * 7;
+  }
+
+  static ControlByte H2(uint64_t hash) {
+    return static_cast<ControlByte>(hash & 0x7F);
+  }
+
+  static size_t H1(uint64_t hash) {
+    return hash >> 7;
+  }
+
+  template <typename K>
+  uint64_t HashOf(const K& key) const {
+    return detail::MixHash(hasher_(key));
+  }
+
+  // Triangular probing over groups visits every group once
+  // when the number of groups is a power of two
+  struct ProbeSequence {
+    ProbeSequence(uint64_t hash, size_t group_mask)
+        : group(H1(hash) & group_mask), mask(group_mask) {
+    }
+
+    size_t Offset() const {
+      return group * kGroupWidth;
+    }
+
+    void Next() {
+      ++step;
+      group = (group + step) & mask;
+    }
+
+    size_t group;
+    size_t step = 0;
+    size_t mask;
+  };
+
+  template <typename K>
+  size_t FindIndex(const K& key, uint64_t hash) const {
+    if (capacity_ == 0) {
+      return capacity_;
+    }
+    for (ProbeSequence probe(hash, GroupMask());; probe.Next()) {
+      const Group group(control_.get() + probe.Offset());
+      for (uint32_t match = group.Match(H2(hash)); match != 0; match &= match - 1) {
+        const size_t index = probe.Offset() + __builtin_ctz(match);
+        if (equal_(slots_[index].first, key)) {
+          return index;
+        }
+      }
+      if (group.MatchEmpty() != 0) {
+        return capacity_;
+      }
+    }
+  }
+
+  // First empty or deleted slot on the probe sequence of the hash
+  size_t FindFree(uint64_t hash) const {
+    for (ProbeSequence probe(hash, GroupMask());; probe.Next()) {
+      const uint32_t free = Group(control_.get() + probe.Offset()).MatchEmptyOrDeleted();
+      if (free != 0) {
+        return probe.Offset() + __builtin_ctz(free);
+      }
+    }
+  }
+
+  // Claims a slot for a new entry with the hash, the caller constructs it
+  size_t PrepareInsert(uint64_t hash) {
+    size_t index = (capacity_ > 0) ? FindFree(hash) : 0;
+    if (capacity_ == 0 || (growth_left_ == 0 && control_[index] == detail::kEmptySlot)) {
+      // Tombstones take up a quarter of the table: rehash in place
+      const bool tombstones = capacity_ > 0 && size_ <= MaxLoad(capacity_) * 3 / 4;
+      Rehash(tombstones ? capacity_ : std::max(2 * capacity_, kGroupWidth));
+      index = FindFree(hash);
+    }
+    if (control_[index] == detail::kEmptySlot) {
+      --growth_left_;
+    }
+    control_[index] = H2(hash);
+    ++size_;
+    return index;
+  }
+
+  void EraseAt(size_t index) {
+    slots_[index].~value_type();
+    --size_;
+
+    // A group that still has an empty slot never made a probe go on,
+    // the slot can become empty again instead of a tombstone
+    const size_t group = index / kGroupWidth * kGroupWidth;
+    if (Group(control_.get() + group).MatchEmpty() != 0) {
+      control_[index] = detail::kEmptySlot;
+      ++growth_left_;
+    } else {
+      control_[index] = detail::kDeletedSlot;
+    }
+  }
+
+  size_t NextFull(size_t index) const {
+    while (index < capacity_ && control_[index] < 0) {
+      ++index;
+    }
+    return index;
+  }
+
+  size_t GroupMask() const {
+    return capacity_ / kGroupWidth - 1;
+  }
+
+  void Rehash(size_t capacity) {
+    WHEELS_ASSERT(capacity % kGroupWidth == 0 && (capacity & (capacity - 1)) == 0,
+                  "Capacity must be a power of two of whole groups");
+
+    auto old_control = std::move(control_);
+    auto old_slots = std::move(slots_);
+    const size_t old_capacity = capacity_;
+
+    control_.reset(new ControlByte[capacity]);
+    std::fill_n(control_.get(), capacity, detail::kEmptySlot);
+    slots_ = AllocateSlots(capacity);
+    capacity_ = capacity;
+    growth_left_ = MaxLoad(capacity) - size_;
+
+    for (size_t index = 0; index < old_capacity; ++index) {
+      if (old_control[index] >= 0) {
+        auto& slot = old_slots[index];
+        const uint64_t hash = HashOf(slot.first);
+        const size_t target = FindFree(hash);
+        control_[target] = H2(hash);
+        new (&slots_[target]) value_type(std::move(slot));
+        slot.~value_type();
+      }
+    }
+  }
+
+  void Destroy() {
+    for (size_t index = 0; index < capacity_; ++index) {
+      if (control_[index] >= 0) {
+        slots_[index].~value_type();
+      }
+    }
+    control_.reset();
+    slots_.reset();
+    capacity_ = 0;
+    size_ = 0;
+    growth_left_ = 0;
+  }
+
+  void Swap(FlatHashMap& that) {
+    std::swap(hasher_, that.hasher_);
+    std::swap(equal_, that.equal_);
+    std::swap(control_, that.control_);
+    std::swap(slots_, that.slots_);
+    std::swap(capacity_, that.capacity_);
+    std::swap(size_, that.size_);
+    std::swap(growth_left_, that.growth_left_);
+  }
+
+  struct FreeSlots {
+    void operator()(value_type* slots) const {
+      std::allocator<value_type>().deallocate(slots, capacity);
+    }
+
+    size_t capacity = 0;
+  };
+
+  using Slots = std::unique_ptr<value_type[], FreeSlots>;
+
+  static Slots AllocateSlots(size_t capacity) {
+    return Slots(std::allocator<value_type>().allocate(capacity), FreeSlots{capacity});
+  }
+
+ private:
+  [[no_unique_address]] Hash hasher_;
+  [[no_unique_address]] KeyEqual equal_;
+
+  std::unique_ptr<ControlByte[]> control_;
+  Slots slots_;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  // Empty slots that may still be filled before the load factor is exceeded
+  size_t growth_left_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
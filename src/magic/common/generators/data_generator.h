@@ -1,13 +1,25 @@
 #pragma once
 
+#include <magic/common/generators/wyrand.h>
+
+#include <algorithm>
 #include <cstdint>
-#include <random>
+#include <cstring>
+#include <span>
 #include <string>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace magic {
 
 //////////////////////////////////////////////////////////////////////
 
+// Deterministic payload of uppercase letters
+// Every wyrand output yields 8 letters: a random byte b maps to
+// 'A' + b * 26 / 256, which avoids a division per byte
+
 class DataGenerator final {
  public:
   DataGenerator(size_t bytes) : bytes_left_(bytes) {
@@ -19,23 +31,54 @@ class DataGenerator final {
 
   size_t NextChunk(char* buffer, size_t limit) {
     auto bytes = std::min(bytes_left_, limit);
-    GenerateData(buffer, bytes);
+    Fill({buffer, bytes});
     bytes_left_ -= bytes;
     return bytes;
   }
 
+  // Fills the whole buffer, does not count towards the payload size
+  void Fill(std::span<char> buffer) {
+    char* data = buffer.data();
+    size_t size = buffer.size();
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i letters = _mm_set1_epi16(26);
+    const __m128i letter_a = _mm_set1_epi8('A');
+    for (; size >= 16; data += 16, size -= 16) {
+      const uint64_t first_word = random_();
+      const uint64_t second_word = random_();
+      const __m128i random = _mm_set_epi64x(second_word, first_word);
+      // Widen to 16-bit lanes, scale to [0, 26) and narrow back
+      __m128i low = _mm_mullo_epi16(_mm_unpacklo_epi8(random, zero), letters);
+      __m128i high = _mm_mullo_epi16(_mm_unpackhi_epi8(random, zero), letters);
+      low = _mm_srli_epi16(low, 8);
+      high = _mm_srli_epi16(high, 8);
+      const __m128i result = _mm_add_epi8(_mm_packus_epi16(low, high), letter_a);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(data), result);
+    }
+#endif
+
+    for (; size >= 8; data += 8, size -= 8) {
+      FillWord(data, random_(), 8);
+    }
+    if (size > 0) {
+      FillWord(data, random_(), size);
+    }
+  }
+
  private:
-  void GenerateData(char* buffer, size_t bytes) {
-    for (size_t index = 0; index < bytes; ++index) {
-      buffer[index] = 'A' + twister_() % 26;
+  static void FillWord(char* data, uint64_t random, size_t count) {
+    for (size_t index = 0; index < count; ++index, random >>= 8) {
+      data[index] = static_cast<char>('A' + ((random & 0xff) * 26 >> 8));
     }
   }
 
  private:
   size_t bytes_left_;
-  std::mt19937 twister_{42};
+  WyRand random_{42};
 };
 
 //////////////////////////////////////////////////////////////////////
 
-}  // namespace magic
\ No newline at end of file
+}  // namespace magic
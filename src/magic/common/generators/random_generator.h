@@ -1,6 +1,9 @@
 #pragma once
 
+#include <magic/common/generators/xoshiro.h>
+
 #include <cassert>
+#include <cstdint>
 #include <random>
 
 namespace magic {
@@ -8,57 +11,102 @@ namespace magic {
 //////////////////////////////////////////////////////////////////////
 
 // Represents a pseudo-random number generator
+// xoshiro256** keeps 32 bytes of state and is seeded by a single
+// random_device call, ranges are drawn with Lemire's multiply-shift method
+// without modulo bias and almost always without a division
 
 class RandomGenerator final {
  public:
-  RandomGenerator() : twister_(GenerateSeed()) {
+  RandomGenerator() : engine_(GenerateSeed()) {
   }
 
-  RandomGenerator(size_t seed) : twister_(seed) {
+  RandomGenerator(size_t seed) : engine_(seed) {
   }
 
   // Returns a non-negative random integer
   uint32_t Next() {
-    return twister_();
+    // The high bits of xoshiro256** are the strongest
+    return static_cast<uint32_t>(engine_() >> 32);
   }
 
-  // Returns a random integer that is within a specified range.
+  // Returns a random integer that is within a specified range, bounds included
   uint32_t Next(uint32_t min_value, uint32_t max_value) {
     assert(max_value >= min_value);
-    auto distrib = std::uniform_int_distribution<uint32_t>(min_value, max_value);
-    return distrib(twister_);
+    const uint32_t range = max_value - min_value + 1;
+    if (range == 0) {
+      return Next();
+    }
+    return min_value + Bounded(range);
   }
 
-  // Returns a non-negative random integer that is less than the specified maximum
+  // Returns a non-negative random integer that is not greater than the specified maximum
   uint32_t Next(uint32_t max_value) {
     return Next(0, max_value);
   }
 
   uint64_t NextInt64() {
-    return twister_();
+    return engine_();
   }
 
-  // Returns a random integer64 that is within a specified range.
+  // Returns a random integer64 that is within a specified range, bounds included
   uint64_t Next(uint64_t min_value, uint64_t max_value) {
     assert(max_value >= min_value);
-    auto distrib = std::uniform_int_distribution<uint64_t>(min_value, max_value);
-    return distrib(twister_);
+    const uint64_t range = max_value - min_value + 1;
+    if (range == 0) {
+      return NextInt64();
+    }
+    return min_value + Bounded(range);
   }
 
-  // Returns a non-negative random integer that is less than the specified maximum
+  // Returns a non-negative random integer that is not greater than the specified maximum
   uint64_t Next(uint64_t max_value) {
-    return Next(0, max_value);
+    return Next(uint64_t{0}, max_value);
+  }
+
+  // Returns a random double in [0, 1)
+  double NextDouble() {
+    return static_cast<double>(engine_() >> 11) * 0x1.0p-53;
   }
 
  private:
-  static std::random_device::result_type GenerateSeed() {
-    return std::random_device{}();
+  // Lemire, "Fast Random Integer Generation in an Interval" (2019):
+  // the high half of random * range is uniform in [0, range) once the few
+  // low halves below 2^N mod range are rejected
+  uint32_t Bounded(uint32_t range) {
+    uint64_t product = uint64_t{Next()} * range;
+    auto low = static_cast<uint32_t>(product);
+    if (low < range) {
+      const uint32_t threshold = -range % range;
+      while (low < threshold) {
+        product = uint64_t{Next()} * range;
+        low = static_cast<uint32_t>(product);
+      }
+    }
+    return static_cast<uint32_t>(product >> 32);
+  }
+
+  uint64_t Bounded(uint64_t range) {
+    __uint128_t product = static_cast<__uint128_t>(engine_()) * range;
+    auto low = static_cast<uint64_t>(product);
+    if (low < range) {
+      const uint64_t threshold = -range % range;
+      while (low < threshold) {
+        product = static_cast<__uint128_t>(engine_()) * range;
+        low = static_cast<uint64_t>(product);
+      }
+    }
+    return static_cast<uint64_t>(product >> 64);
+  }
+
+  static uint64_t GenerateSeed() {
+    std::random_device device;
+    return (uint64_t{device()} << 32) | device();
   }
 
  private:
-  std::mt19937_64 twister_;
+  Xoshiro256StarStar engine_;
 };
 
 //////////////////////////////////////////////////////////////////////
 
-}  // namespace magic
\ No newline at end of file
+}  // namespace magic
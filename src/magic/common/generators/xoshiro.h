@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// SplitMix64: expands a single 64-bit seed into well-mixed state words
+
+class SplitMix64 final {
+ public:
+  using result_type = uint64_t;
+
+  explicit SplitMix64(uint64_t seed) : state_(seed) {
+  }
+
+  uint64_t operator()() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+ private:
+  uint64_t state_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// xoshiro256** (Blackman, Vigna): 32 bytes of state, a few shifts,
+// rotations and two multiplications per 64-bit output, period 2^256 - 1
+// Satisfies UniformRandomBitGenerator, not cryptographically secure
+
+class Xoshiro256StarStar final {
+ public:
+  using result_type = uint64_t;
+
+  explicit Xoshiro256StarStar(uint64_t seed) {
+    SplitMix64 expand{seed};
+    for (auto& word : state_) {
+      word = expand();
+    }
+  }
+
+  // The state must not be all zeros
+  explicit Xoshiro256StarStar(std::array<uint64_t, 4> state) : state_(state) {
+  }
+
+  static constexpr result_type min() {
+    return 0;
+  }
+
+  static constexpr result_type max() {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  uint64_t operator()() {
+    const uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+    const uint64_t t = state_[1] << 17;
+
+    state_[2] ^= state_[0];
+    state_[3] ^= state_[1];
+    state_[1] ^= state_[2];
+    state_[0] ^= state_[3];
+    state_[2] ^= t;
+    state_[3] = RotateLeft(state_[3], 45);
+
+    return result;
+  }
+
+ private:
+  static uint64_t RotateLeft(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+ private:
+  std::array<uint64_t, 4> state_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+inline uint64_t HashMultiply(uint64_t a, uint64_t b) {
+  // 64x64 -> 128 bit product folded back to 64 bits
+  const __uint128_t product = static_cast<__uint128_t>(a) * b;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+inline uint64_t HashRead8(const uint8_t* p) {
+  uint64_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+inline uint64_t HashRead4(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// wyhash (final 4): a multiply-fold per 16 bytes, short keys are read
+// with at most two overlapping loads and no loop
+// Not a cryptographic hash, do not expose to untrusted keys without a seed
+
+inline uint64_t HashBytes(const void* data, size_t length, uint64_t seed = 0) {
+  static const uint64_t kSecret[4] = {0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+                                      0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull};
+
+  using detail::HashMultiply;
+  using detail::HashRead4;
+  using detail::HashRead8;
+
+  auto p = static_cast<const uint8_t*>(data);
+  seed ^= HashMultiply(seed ^ kSecret[0], kSecret[1]);
+
+  uint64_t a = 0;
+  uint64_t b = 0;
+  if (length <= 16) {
+    if (length >= 4) {
+      const size_t shift = (length >> 3) << 2;
+      a = (HashRead4(p) << 32) | HashRead4(p + shift);
+      b = (HashRead4(p + length - 4) << 32) | HashRead4(p + length - 4 - shift);
+    } else if (length > 0) {
+      a = (uint64_t(p[0]) << 16) | (uint64_t(p[length >> 1]) << 8) | p[length - 1];
+    }
+  } else {
+    size_t rest = length;
+    if (rest > 48) {
+      uint64_t seed1 = seed;
+      uint64_t seed2 = seed;
+      do {
+        seed = HashMultiply(HashRead8(p) ^ kSecret[1], HashRead8(p + 8) ^ seed);
+        seed1 = HashMultiply(HashRead8(p + 16) ^ kSecret[2], HashRead8(p + 24) ^ seed1);
+        seed2 = HashMultiply(HashRead8(p + 32) ^ kSecret[3], HashRead8(p + 40) ^ seed2);
+        p += 48;
+        rest -= 48;
+      } while (rest > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (rest > 16) {
+      seed = HashMultiply(HashRead8(p) ^ kSecret[1], HashRead8(p + 8) ^ seed);
+      p += 16;
+      rest -= 16;
+    }
+    a = HashRead8(p + rest - 16);
+    b = HashRead8(p + rest - 8);
+  }
+
+  a ^= kSecret[1];
+  b ^= seed;
+  const __uint128_t product = static_cast<__uint128_t>(a) * b;
+  a = static_cast<uint64_t>(product);
+  b = static_cast<uint64_t>(product >> 64);
+  return HashMultiply(a ^ kSecret[0] ^ length, b ^ kSecret[1]);
+}
+
+inline uint64_t HashString(std::string_view s) {
+  return HashBytes(s.data(), s.size());
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
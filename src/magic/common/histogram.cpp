@@ -0,0 +1,149 @@
+#include <magic/common/histogram.h>
+#include <magic/common/string_builder.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+const double kReportedPercentiles[] = {50, 90, 99, 99.9};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+uint64_t HistogramSnapshot::Percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  const auto rank = std::max<uint64_t>(1, std::ceil(percentile / 100 * count_));
+
+  uint64_t seen = 0;
+  for (size_t index = 0; index < counts_.size(); ++index) {
+    seen += counts_[index];
+    if (seen >= rank) {
+      return std::clamp(detail::HistogramBucketHighest(index), min_, max_);
+    }
+  }
+  return max_;
+}
+
+void HistogramSnapshot::Merge(const HistogramSnapshot& other) {
+  for (size_t index = 0; index < counts_.size(); ++index) {
+    counts_[index] += other.counts_[index];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+std::string HistogramSnapshot::ToString() const {
+  StringBuilder builder;
+  builder.AppendFormat("count={} min={} mean={:.1f}", Count(), Min(), Mean());
+  for (double percentile : kReportedPercentiles) {
+    builder.AppendFormat(" p{}={}", percentile, Percentile(percentile));
+  }
+  builder.AppendFormat(" max={}", Max());
+  return builder.Release();
+}
+
+std::string HistogramSnapshot::ToJson() const {
+  StringBuilder builder;
+  builder.AppendFormat("{{\"count\":{},\"min\":{},\"mean\":{:.1f}", Count(), Min(), Mean());
+  for (double percentile : kReportedPercentiles) {
+    builder.AppendFormat(",\"p{}\":{}", percentile, Percentile(percentile));
+  }
+  builder.AppendFormat(",\"max\":{}}}", Max());
+  return builder.Release();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Histogram::Histogram(size_t shards)
+    : shards_(std::make_unique<std::atomic<Shard*>[]>(shards)), mask_(shards - 1) {
+  WHEELS_ASSERT(shards > 0 && (shards & mask_) == 0, "Shard count must be a power of two");
+}
+
+Histogram::~Histogram() {
+  for (size_t index = 0; index <= mask_; ++index) {
+    delete shards_[index].load(std::memory_order::relaxed);
+  }
+}
+
+HistogramSnapshot Histogram::Snapshot() const {
+  HistogramSnapshot snapshot;
+  for (size_t index = 0; index <= mask_; ++index) {
+    const Shard* shard = shards_[index].load(std::memory_order::acquire);
+    if (shard == nullptr) {
+      continue;
+    }
+    for (size_t bucket = 0; bucket < detail::kHistogramBuckets; ++bucket) {
+      const uint64_t count = shard->counts[bucket].load(std::memory_order::relaxed);
+      snapshot.counts_[bucket] += count;
+      snapshot.count_ += count;
+    }
+    snapshot.sum_ += shard->sum.load(std::memory_order::relaxed);
+    snapshot.min_ = std::min(snapshot.min_, shard->min.load(std::memory_order::relaxed));
+    snapshot.max_ = std::max(snapshot.max_, shard->max.load(std::memory_order::relaxed));
+  }
+
+  if (snapshot.count_ > 0) {
+    // Relaxed loads may see a bucket count without the extremes of its
+    // value: fall back to the bounds of the outermost buckets, Percentile
+    // clamps to [min, max]
+    size_t first = 0;
+    while (snapshot.counts_[first] == 0) {
+      ++first;
+    }
+    size_t last = snapshot.counts_.size() - 1;
+    while (snapshot.counts_[last] == 0) {
+      --last;
+    }
+    if (snapshot.min_ > detail::HistogramBucketHighest(first)) {
+      snapshot.min_ = detail::HistogramBucketLowest(first);
+    }
+    if (snapshot.max_ < detail::HistogramBucketLowest(last)) {
+      snapshot.max_ = detail::HistogramBucketHighest(last);
+    }
+    snapshot.max_ = std::max(snapshot.max_, snapshot.min_);
+  }
+  return snapshot;
+}
+
+void Histogram::Reset() {
+  for (size_t index = 0; index <= mask_; ++index) {
+    Shard* shard = shards_[index].load(std::memory_order::acquire);
+    if (shard == nullptr) {
+      continue;
+    }
+    for (auto& count : shard->counts) {
+      count.store(0, std::memory_order::relaxed);
+    }
+    shard->sum.store(0, std::memory_order::relaxed);
+    shard->min.store(std::numeric_limits<uint64_t>::max(), std::memory_order::relaxed);
+    shard->max.store(0, std::memory_order::relaxed);
+  }
+}
+
+Histogram::Shard& Histogram::AllocateShard(size_t index) {
+  auto shard = new Shard{};
+  Shard* expected = nullptr;
+  if (shards_[index].compare_exchange_strong(expected, shard, std::memory_order::acq_rel)) {
+    return *shard;
+  }
+  // Another thread of the same shard won
+  delete shard;
+  return *expected;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
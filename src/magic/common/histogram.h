@@ -0,0 +1,233 @@
+#pragma once
+
+#include <magic/common/tsc_clock.h>
+#include <magic/concurrency/sharded_counter.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Log-linear buckets in the spirit of HdrHistogram: values below 2^7 get a
+// bucket each, every further power of two is split into 2^7 equal buckets
+// A bucket is at most 1/128 (< 0.8%) of its values wide, the whole uint64_t
+// range takes 7424 buckets
+
+static const size_t kHistogramSubBucketBits = 7;
+static const size_t kHistogramSubBuckets = size_t{1} << kHistogramSubBucketBits;
+static const size_t kHistogramBuckets = (64 - kHistogramSubBucketBits + 1) * kHistogramSubBuckets;
+
+inline size_t HistogramBucketIndex(uint64_t value) {
+  if (value < kHistogramSubBuckets) {
+    return value;
+  }
+  const size_t shift = 63 - __builtin_clzll(value) - kHistogramSubBucketBits;
+  return ((shift + 1) << kHistogramSubBucketBits) + ((value >> shift) - kHistogramSubBuckets);
+}
+
+// Smallest value that falls into the bucket
+inline uint64_t HistogramBucketLowest(size_t index) {
+  if (index < kHistogramSubBuckets) {
+    return index;
+  }
+  const size_t shift = (index >> kHistogramSubBucketBits) - 1;
+  return uint64_t(kHistogramSubBuckets + (index & (kHistogramSubBuckets - 1))) << shift;
+}
+
+// Largest value that falls into the bucket
+inline uint64_t HistogramBucketHighest(size_t index) {
+  if (index < kHistogramSubBuckets) {
+    return index;
+  }
+  const size_t shift = (index >> kHistogramSubBucketBits) - 1;
+  return HistogramBucketLowest(index) + ((uint64_t{1} << shift) - 1);
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Point-in-time copy of a Histogram, plain values
+// Snapshots of different histograms (hosts, processes, time windows) merge
+// without losing precision
+
+class HistogramSnapshot final {
+  friend class Histogram;
+
+ public:
+  HistogramSnapshot() : counts_(detail::kHistogramBuckets) {
+  }
+
+  // ~ Public Interface
+
+  uint64_t Count() const {
+    return count_;
+  }
+
+  uint64_t Sum() const {
+    return sum_;
+  }
+
+  // 0 if empty
+  uint64_t Min() const {
+    return count_ > 0 ? min_ : 0;
+  }
+
+  uint64_t Max() const {
+    return max_;
+  }
+
+  double Mean() const {
+    return count_ > 0 ? double(sum_) / count_ : 0;
+  }
+
+  // Smallest recorded value that is not less than `percentile` percent of
+  // the values, up to the bucket width; percentile is in [0, 100]
+  uint64_t Percentile(double percentile) const;
+
+  void Merge(const HistogramSnapshot& other);
+
+  // count=1000 min=1 mean=500.5 p50=500 p90=900 p99=990 p99.9=999 max=1000
+  std::string ToString() const;
+
+  // {"count":1000,"min":1,"mean":500.5,"p50":500,...,"max":1000}
+  std::string ToJson() const;
+
+ private:
+  std::vector<uint64_t> counts_;
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t min_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Lock-free log-linear histogram of uint64_t values, durations are recorded
+// in nanoseconds
+
+// Record is O(1): a bucket index from the leading zero count and a relaxed
+// add on the shard of the calling thread. Shards are assigned like in
+// ShardedCounter and allocated on the first record from a thread, so a
+// histogram costs ~60 KiB per recording thread up to the shard count
+
+// Snapshot sums up the shards: concurrent records may or may not be counted,
+// Min <= Percentile <= Max holds regardless
+
+// Usage:
+// Histogram latency;
+// latency.Record(elapsed);
+// fmt::println("{}", latency.Snapshot().ToString());
+
+class Histogram final {
+  struct Shard {
+    std::atomic<uint64_t> counts[detail::kHistogramBuckets] = {};
+    std::atomic<uint64_t> sum = 0;
+    std::atomic<uint64_t> min = std::numeric_limits<uint64_t>::max();
+    std::atomic<uint64_t> max = 0;
+  };
+
+ public:
+  explicit Histogram(size_t shards = ShardedCounter::DefaultShardCount());
+  ~Histogram();
+
+  // Non-copyable
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  // ~ Public Interface
+
+  void Record(uint64_t value, uint64_t count = 1) {
+    Shard& shard = ThisThreadShard();
+    // Extremes first: a snapshot that counts the value usually sees them
+    // too. Read-only once the extremes settle
+    UpdateMin(shard.min, value);
+    UpdateMax(shard.max, value);
+    shard.counts[detail::HistogramBucketIndex(value)].fetch_add(count, std::memory_order::relaxed);
+    shard.sum.fetch_add(value * count, std::memory_order::relaxed);
+  }
+
+  template <typename Rep, typename Period>
+  void Record(std::chrono::duration<Rep, Period> duration) {
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    Record(nanos > 0 ? uint64_t(nanos) : 0);
+  }
+
+  HistogramSnapshot Snapshot() const;
+
+  // Records racing with Reset may survive it
+  void Reset();
+
+ private:
+  Shard& ThisThreadShard() {
+    const size_t index = detail::ThisThreadShard() & mask_;
+    if (auto shard = shards_[index].load(std::memory_order::acquire)) {
+      return *shard;
+    }
+    return AllocateShard(index);
+  }
+
+  Shard& AllocateShard(size_t index);
+
+  static void UpdateMin(std::atomic<uint64_t>& min, uint64_t value) {
+    uint64_t current = min.load(std::memory_order::relaxed);
+    while (value < current && !min.compare_exchange_weak(current, value,
+                                                         std::memory_order::relaxed)) {
+    }
+  }
+
+  static void UpdateMax(std::atomic<uint64_t>& max, uint64_t value) {
+    uint64_t current = max.load(std::memory_order::relaxed);
+    while (value > current && !max.compare_exchange_weak(current, value,
+                                                         std::memory_order::relaxed)) {
+    }
+  }
+
+ private:
+  std::unique_ptr<std::atomic<Shard*>[]> shards_;
+  const size_t mask_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Records the lifetime of the scope in nanoseconds, time a fiber spends
+// suspended included
+
+// Usage:
+// {
+//   HistogramTimer timer{lock_hold_times};
+//   std::lock_guard guard(mutex);
+//   ...
+// }
+
+class HistogramTimer final {
+ public:
+  explicit HistogramTimer(Histogram& histogram)
+      : histogram_(histogram), start_(TscClock::Ticks()) {
+  }
+
+  ~HistogramTimer() {
+    histogram_.Record(TscClock::TicksToDuration(TscClock::Ticks() - start_));
+  }
+
+  // Non-copyable
+  HistogramTimer(const HistogramTimer&) = delete;
+  HistogramTimer& operator=(const HistogramTimer&) = delete;
+
+ private:
+  Histogram& histogram_;
+  const uint64_t start_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
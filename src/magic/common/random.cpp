@@ -25,4 +25,8 @@ uint64_t Random::NextInt64() {
   return generator.NextInt64();
 }
 
+double Random::NextDouble() {
+  return generator.NextDouble();
+}
+
 }  // namespace magic
@@ -7,21 +7,25 @@ namespace magic {
 //////////////////////////////////////////////////////////////////////
 
 // Thread-safe methods that may be used concurrently from any thread
+// Every thread owns a xoshiro256** state, calls never synchronize
 
 struct Random {
 
   // Returns a non-negative random integer
   static uint32_t Next();
 
-  // Returns a non-negative random integer that is less than the specified maximum
+  // Returns a non-negative random integer that is not greater than the specified maximum
   static uint32_t Next(uint32_t max_value);
 
-  // Returns a random integer that is within a specified range
+  // Returns a random integer that is within a specified range, bounds included
   static uint32_t Next(uint32_t min_value, uint32_t max_value);
 
   // Returns a non-negative random integer
   static uint64_t NextInt64();
 
+  // Returns a random double in [0, 1)
+  static double NextDouble();
+
 };
 
 //////////////////////////////////////////////////////////////////////
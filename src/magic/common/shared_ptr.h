@@ -2,8 +2,8 @@
 
 #include <magic/concurrency/lockfree/stamped_ptr.h>
 
-#include <fmt/core.h>
-#include <thread>
+#include <atomic>
+#include <utility>
 
 namespace magic {
 
@@ -11,49 +11,28 @@ namespace magic {
 
 namespace detail {
 
-struct SplitCount {
-  int32_t transient;
-  int32_t strong;  // > 0
-
-  SplitCount operator+(const SplitCount& that) const {
-    return {transient + that.transient, strong + that.strong};
-  }
-
-  SplitCount operator*(int32_t value) const {
-    return {transient * value, strong * value};
-  }
-
-  bool IsZero() const {
-    return transient == 0 && strong == 0;
-  }
-};
-
-static_assert(sizeof(SplitCount) == sizeof(size_t), "Not supported");
+// Split reference counting:
+// - local (transient) count lives in the stamp of AtomicSharedPtr
+// - global count lives in the control block
 
 template <typename T>
 struct ControlBlock {
   T* obj_ptr = nullptr;
-  std::atomic<SplitCount> global;
+  std::atomic<int64_t> global = 0;
 
   ~ControlBlock() {
     delete obj_ptr;
   }
 
-  void IncrementRefCount(SplitCount delta = {1, 1}) {
-    auto current = global.load();
-    auto total = current + delta;
-    while (!global.compare_exchange_weak(current, total)) {
-      total = current + delta;
-    }
+  void IncrementRefCount(int64_t delta = 1) {
+    global.fetch_add(delta, std::memory_order::relaxed);
+  }
 
-    if (total.IsZero()) {
+  void DecrementRefCount(int64_t delta = 1) {
+    if (global.fetch_sub(delta, std::memory_order::acq_rel) == delta) {
       delete this;
     }
   }
-
-  void DecrementRefCount(SplitCount delta = {1, 1}) {
-    IncrementRefCount(delta * -1);
-  }
 };
 
 }  // namespace detail
@@ -76,7 +55,8 @@ class SharedPtr {
     }
   }
 
-  SharedPtr(ControlBlock* cb) : cb_ptr_(cb) {
+  // Adopts a reference that has already been counted
+  explicit SharedPtr(ControlBlock* cb) : cb_ptr_(cb) {
   }
 
   // Copy
@@ -113,10 +93,18 @@ class SharedPtr {
     return *cb_ptr_->obj_ptr;
   }
 
+  T* Get() const {
+    return cb_ptr_ ? cb_ptr_->obj_ptr : nullptr;
+  }
+
   explicit operator bool() const {
     return cb_ptr_ != nullptr;
   }
 
+  bool operator==(const SharedPtr<T>& that) const {
+    return cb_ptr_ == that.cb_ptr_;
+  }
+
   void Reset() {
     if (cb_ptr_) {
       cb_ptr_->DecrementRefCount();
@@ -133,6 +121,11 @@ class SharedPtr {
     std::swap(cb_ptr_, that.cb_ptr_);
   }
 
+  // Gives up ownership without touching the ref count
+  ControlBlock* Release() {
+    return std::exchange(cb_ptr_, nullptr);
+  }
+
  private:
   ControlBlock* cb_ptr_ = nullptr;
 
@@ -146,82 +139,137 @@ SharedPtr<T> MakeShared(Args&&... args) {
 
 //////////////////////////////////////////////////////////////////////
 
+// Lock-free atomic shared pointer
+
+// Readers pay a single CAS on the stamped pointer and never touch the control block:
+// every installed control block is pre-charged with kMaxStamp global references,
+// a Load takes one of them by incrementing the stamp.
+// When the stamp grows past kRefillThreshold a reader recharges the block and resets the stamp.
+// Writers return the unused part of the charge (kMaxStamp - stamp) to the global count.
+
 template <typename T>
 class AtomicSharedPtr final {
   using ControlBlock = detail::ControlBlock<T>;
+  using Stamped = StampedPtr<ControlBlock>;
+
+  static const int64_t kMaxStamp = AtomicStampedPtr<ControlBlock>::kMaxStamp;
+  static const uint64_t kRefillThreshold = kMaxStamp / 2;
 
  public:
   // nullptr
   AtomicSharedPtr() : ptr_(nullptr) {
   }
 
+  explicit AtomicSharedPtr(SharedPtr<T> value) : ptr_(Install(std::move(value))) {
+  }
+
+  // Non-copyable
+  AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+  AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
   ~AtomicSharedPtr() {
+    Uninstall(ptr_.Load());
   }
 
+  // ~ Public Interface
+
   SharedPtr<T> Load() {
-    auto ptr = AcquireRef();
-    return {ptr.raw_ptr};
-  }
+    auto current = ptr_.Load();
+    while (current && !ptr_.CompareExchangeWeak(current, current.IncrementStamp())) {
+    }
 
-  void Store(SharedPtr<T> value) {
-    auto cb = ptr_.Exchange({value.cb_ptr_});
-    value.cb_ptr_->IncrementRefCount();
+    if (!current) {
+      return {};
+    }
 
-    if (!cb) {
-      return;
+    auto acquired = current.IncrementStamp();
+    if (acquired.stamp >= kRefillThreshold) {
+      Refill(acquired.raw_ptr);
     }
-    int32_t ref_count = cb.stamp;
-    cb->DecrementRefCount({ref_count, ref_count});
-  }
 
-  explicit operator SharedPtr<T>() {
-    return Load();
+    // Take one of the pre-charged references
+    return SharedPtr<T>(acquired.raw_ptr);
   }
 
-  bool CompareExchangeWeak(SharedPtr<T>& /*expected*/, SharedPtr<T> /*desired*/) {
-    auto current = AcquireRef();
+  void Store(SharedPtr<T> value) {
+    Exchange(std::move(value));
+  }
 
-    return false;  // Not implemented
+  SharedPtr<T> Exchange(SharedPtr<T> value) {
+    auto old = ptr_.Exchange(Install(std::move(value)));
+    return Uninstall(old);
   }
 
- private:
-  StampedPtr<ControlBlock> AcquireRef() {
+  // Replaces the stored pointer with desired if it points to the same object as expected,
+  // otherwise loads the stored pointer into expected
+  // May fail spuriously if concurrent readers touch the stamp
+  bool CompareExchangeWeak(SharedPtr<T>& expected, SharedPtr<T> desired) {
     auto current = ptr_.Load();
-    auto next = StampedPtr<ControlBlock>();
-
-    if (!current) {
-      return {nullptr};
+    if (current.raw_ptr == expected.cb_ptr_ && TryReplace(current, desired)) {
+      return true;
     }
+    expected = Load();
+    return false;
+  }
 
-    // increment local ref count
-    while (true) {
-      next = current.IncrementStamp();
-      if (next.IsNull() || ptr_.CompareExchangeWeak(current, next)) {
-        break;
+  bool CompareExchange(SharedPtr<T>& expected, SharedPtr<T> desired) {
+    auto current = ptr_.Load();
+    while (current.raw_ptr == expected.cb_ptr_) {
+      if (TryReplace(current, desired)) {
+        return true;
       }
     }
-
-    return next;
+    expected = Load();
+    return false;
   }
 
+  explicit operator SharedPtr<T>() {
+    return Load();
+  }
 
-  void SyncRefCounts() {
-    auto current = ptr_.Load();
-    auto ref_count = current.stamp;
+ private:
+  // Transfers the reference owned by value to this pointer and pre-charges the control block
+  static Stamped Install(SharedPtr<T> value) {
+    auto cb = value.Release();
+    if (cb) {
+      cb->IncrementRefCount(kMaxStamp);
+    }
+    return {cb, 0};
+  }
 
-    if (ref_count == 0) {
-      return;
+  // Returns the unused part of the charge,
+  // the reference owned by this pointer is handed over to the caller
+  static SharedPtr<T> Uninstall(Stamped old) {
+    if (!old) {
+      return {};
+    }
+    const auto unused = kMaxStamp - static_cast<int64_t>(old.stamp);
+    if (unused > 0) {
+      old->DecrementRefCount(unused);
     }
+    return SharedPtr<T>(old.raw_ptr);
+  }
 
-    // increment global ref count
-    auto old_value = current->global.fetch_sub(ref_count);
+  bool TryReplace(Stamped& current, SharedPtr<T>& desired) {
+    auto next = Install(desired);  // copy: desired keeps its reference on failure
+    if (ptr_.CompareExchangeWeak(current, next)) {
+      Uninstall(current);
+      return true;
+    }
+    Uninstall(next);
+    return false;
+  }
 
-    // decrement local ref count
-    while (true) {
-      auto next = current.DecrementStamp(ref_count);
-      if (ptr_.CompareExchangeWeak(current, next)) {
-        break;
+  // Context: the caller owns a reference to cb
+  void Refill(ControlBlock* cb) {
+    auto current = ptr_.Load();
+    while (current.raw_ptr == cb && current.stamp >= kRefillThreshold) {
+      const auto stamp = static_cast<int64_t>(current.stamp);
+      cb->IncrementRefCount(stamp);
+      if (ptr_.CompareExchangeWeak(current, {cb, 0})) {
+        return;
       }
+      cb->DecrementRefCount(stamp);
     }
   }
 
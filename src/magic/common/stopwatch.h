@@ -1,6 +1,7 @@
 #pragma once
 
 #include <magic/common/time.h>
+#include <magic/common/tsc_clock.h>
 
 using namespace std::chrono_literals;
 
@@ -22,18 +23,24 @@ namespace magic {
 // using std::chrono::duration_cast;
 // using std::chrono::milliseconds;
 // spdlog::info("Elapsed {}", duration_cast<milliseconds>(sw.elapsed())); => "Elapsed 5ms"
+//
+// TscStopwatch reads the time stamp counter instead of steady_clock, for timing
+// short sections on hot paths
+
+template <typename ClockType>
+class BasicStopwatch final {
+  using TimePoint = typename ClockType::time_point;
 
-class Stopwatch final {
  public:
-  Stopwatch() : timestamp_{Clock::now()} {
+  BasicStopwatch() : timestamp_{ClockType::now()} {
   }
 
   Duration Elapsed() const {
-    return {Clock::now() - timestamp_};
+    return {ClockType::now() - timestamp_};
   }
 
   TimeSpan ElapsedInterval() const {
-    return TimeSpan{Clock::now() - timestamp_};
+    return TimeSpan{ClockType::now() - timestamp_};
   }
 
   size_t ElapsedMs() const {
@@ -41,13 +48,16 @@ class Stopwatch final {
   }
 
   void Reset() {
-    timestamp_ = Clock::now();
+    timestamp_ = ClockType::now();
   }
 
  private:
-  Timestamp timestamp_;
+  TimePoint timestamp_;
 };
 
+using Stopwatch = BasicStopwatch<Clock>;
+using TscStopwatch = BasicStopwatch<TscClock>;
+
 //////////////////////////////////////////////////////////////////////
 
 }  // namespace magic
\ No newline at end of file
@@ -1,42 +1,223 @@
 #pragma once
 
-#include <sstream>
+#include <wheels/core/assert.hpp>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <sys/uio.h>
 
 namespace magic {
 
 //////////////////////////////////////////////////////////////////////
 
+// Contiguous growable byte buffer
+// Short results stay in the inline buffer, longer ones move to a heap
+// std::string that grows geometrically and is handed out by Release
+// without a copy
+
+// AppendExternal references caller-owned bytes instead of copying them,
+// Iovecs hands the content out for writev as-is
+
+// Usage:
+// StringBuilder builder;
+// builder << "GET " << path << ' ';
+// builder.AppendFormat("{} ms\n", elapsed);
+// auto line = builder.Release();
+
 class StringBuilder final {
  public:
+  static const size_t kInlineCapacity = 256;
+
+  StringBuilder() = default;
+
+  // ~ Public Interface
+
   void Append(std::string_view s) {
-    buffer_ << s;
-    size_ += s.size();
+    Append(s.data(), s.size());
   }
 
   void Append(const char* data, size_t size) {
-    buffer_.write(data, size);
+    if (size_ + size > Capacity()) {
+      Grow(size_ + size);
+    }
+    std::memcpy(Data() + size_, data, size);
     size_ += size;
   }
 
-  std::string ToString() const {
-    return buffer_.str();
+  void Append(char ch) {
+    if (size_ == Capacity()) {
+      Grow(size_ + 1);
+    }
+    Data()[size_++] = ch;
+  }
+
+  // Formats straight into the free space, formats again after growing
+  // if the result does not fit
+  template <typename... Args>
+  StringBuilder& AppendFormat(fmt::format_string<Args...> format, Args&&... args) {
+    const auto arguments = fmt::make_format_args(args...);
+    const size_t free = Capacity() - size_;
+    const auto result = fmt::vformat_to_n(Data() + size_, free, fmt::string_view(format), arguments);
+    if (result.size > free) {
+      Grow(size_ + result.size);
+      fmt::vformat_to_n(Data() + size_, result.size, fmt::string_view(format), arguments);
+    }
+    size_ += result.size;
+    return *this;
+  }
+
+  // References the bytes instead of copying them, they must stay alive and
+  // unchanged while the builder is used
+  // Pays off for large payloads written out with Iovecs
+  void AppendExternal(std::string_view data) {
+    if (!data.empty()) {
+      externals_.push_back({size_, data});
+      external_size_ += data.size();
+    }
+  }
+
+  // Makes room for `size` more bytes
+  void Reserve(size_t size) {
+    if (size_ + size > Capacity()) {
+      Grow(size_ + size);
+    }
   }
 
   template <typename T>
   StringBuilder& operator<<(const T& next) {
-    buffer_ << next;
+    if constexpr (std::same_as<T, char>) {
+      Append(next);
+    } else if constexpr (std::convertible_to<const T&, std::string_view>) {
+      Append(std::string_view(next));
+    } else {
+      AppendFormat("{}", next);
+    }
     return *this;
   }
 
+  size_t Size() const {
+    return size_ + external_size_;
+  }
+
+  bool IsEmpty() const {
+    return Size() == 0;
+  }
+
+  // Content without external parts
+  std::string_view View() const {
+    WHEELS_ASSERT(externals_.empty(), "External parts are not contiguous");
+    return {Data(), size_};
+  }
+
+  // Scatter list of the content in order, for writev / sendmsg
+  // Invalidated by the next Append
+  std::vector<iovec> Iovecs() const {
+    std::vector<iovec> vectors;
+    vectors.reserve(2 * externals_.size() + 1);
+    size_t position = 0;
+    for (const auto& external : externals_) {
+      if (external.position > position) {
+        vectors.push_back({const_cast<char*>(Data()) + position, external.position - position});
+        position = external.position;
+      }
+      vectors.push_back({const_cast<char*>(external.data.data()), external.data.size()});
+    }
+    if (size_ > position) {
+      vectors.push_back({const_cast<char*>(Data()) + position, size_ - position});
+    }
+    return vectors;
+  }
+
+  std::string ToString() const {
+    if (externals_.empty()) {
+      return std::string(Data(), size_);
+    }
+    std::string result;
+    result.reserve(Size());
+    for (const auto& vector : Iovecs()) {
+      result.append(static_cast<const char*>(vector.iov_base), vector.iov_len);
+    }
+    return result;
+  }
+
+  // Moves the content out without copying it once it is on the heap,
+  // the builder is empty afterwards
+  std::string Release() {
+    std::string result;
+    if (!externals_.empty() || !OnHeap()) {
+      result = ToString();
+    } else {
+      heap_.resize(size_);
+      result = std::move(heap_);
+    }
+    Clear();
+    heap_ = std::string();
+    return result;
+  }
+
+  // Keeps the capacity
+  void Clear() {
+    size_ = 0;
+    externals_.clear();
+    external_size_ = 0;
+  }
+
   operator std::string() const {
-    return buffer_.str();
+    return ToString();
+  }
+
+ private:
+  struct External {
+    // Offset in the own bytes the part goes before
+    size_t position;
+    std::string_view data;
+  };
+
+  // The heap string is sized to the whole capacity, size_ bytes are used
+  bool OnHeap() const {
+    return !heap_.empty();
+  }
+
+  char* Data() {
+    return OnHeap() ? heap_.data() : inline_;
+  }
+
+  const char* Data() const {
+    return OnHeap() ? heap_.data() : inline_;
+  }
+
+  size_t Capacity() const {
+    return OnHeap() ? heap_.size() : kInlineCapacity;
+  }
+
+  void Grow(size_t required) {
+    const size_t capacity = std::max(required, 2 * Capacity());
+    if (OnHeap()) {
+      heap_.resize(capacity);
+    } else {
+      std::string heap(capacity, '\0');
+      std::memcpy(heap.data(), inline_, size_);
+      heap_ = std::move(heap);
+    }
   }
 
  private:
-  std::ostringstream buffer_;
+  char inline_[kInlineCapacity];
+  std::string heap_;
   size_t size_ = 0;
+
+  std::vector<External> externals_;
+  size_t external_size_ = 0;
 };
 
 //////////////////////////////////////////////////////////////////////
 
-}  // namespace magic
\ No newline at end of file
+}  // namespace magic
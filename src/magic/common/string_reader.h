@@ -1,14 +1,46 @@
 #pragma once
 
+#include <magic/common/string_scan.h>
+
+#include <algorithm>
 #include <charconv>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
 #include <string_view>
 #include <cassert>
 
+#if !defined(__cpp_lib_to_chars)
+#include <cerrno>
+#include <clocale>
+#if defined(__APPLE__)
+#include <xlocale.h>
+#endif
+#endif
+
 namespace magic {
 
 //////////////////////////////////////////////////////////////////////
 
+#if !defined(__cpp_lib_to_chars)
+
+namespace detail {
+
+// Parsing must not depend on setlocale: "1.5" stays 1.5 under a ',' locale
+inline locale_t ClassicLocale() {
+  static const locale_t locale = ::newlocale(LC_ALL_MASK, "C", nullptr);
+  return locale;
+}
+
+}  // namespace detail
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+
+// Scans with the vectorized kernels of string_scan.h,
+// numbers are parsed in place without reading past the view
+
 class StringReader final {
  public:
   StringReader(std::string_view s) : source_(s) {
@@ -60,30 +92,16 @@ class StringReader final {
   }
 
   StringReader& SkipSpaces() {
-    while (HasNext() && isspace(NextChar()) != 0) {
-      SkipOne();
-    }
-    return *this;
+    return SkipTo(detail::FindNonSpace(Begin(), End()));
   }
 
   StringReader& SkipUntil(char ch) {
-    auto offset = source_.find_first_of(ch);
-    if (offset == std::string_view::npos) {
-      offset = source_.length();
-    }
-    source_.remove_prefix(offset);
-    return *this;
+    return SkipTo(detail::FindChar(Begin(), End(), ch));
   }
 
   StringReader& SkipAfter(char ch) {
-    auto offset = source_.find_first_of(ch);
-    if (offset == std::string_view::npos) {
-      offset = source_.length();
-    } else {
-      offset = std::min(offset + 1, source_.length());
-    }
-    source_.remove_prefix(offset);
-    return *this;
+    auto found = detail::FindChar(Begin(), End(), ch);
+    return SkipTo(found == End() ? found : found + 1);
   }
 
   StringReader& SkipUntilSpace() {
@@ -129,24 +147,20 @@ class StringReader final {
   }
 
   std::string_view ReadUntil(char ch) {
-    if (IsEmpty() || NextChar() == ch) {
-      return {};
-    }
-
-    const auto offset = source_.find_first_of(ch);
-    if (offset == std::string_view::npos) {
+    auto found = detail::FindChar(Begin(), End(), ch);
+    if (found == End()) {
       source_.remove_prefix(source_.length());
       return {};
     }
 
-    auto result = source_.substr(0, offset);
-    source_.remove_prefix(offset);
+    auto result = std::string_view(Begin(), found - Begin());
+    SkipTo(found);
 
     return result;
   }
 
   int ReadInt() {
-    int value;
+    int value = 0;
     const auto result = std::from_chars(source_.data(), source_.data() + source_.size(), value);
     const auto offset = std::distance(source_.data(), result.ptr);
     source_.remove_prefix(offset);
@@ -155,21 +169,79 @@ class StringReader final {
   }
 
   StringReader& SkipDigits() {
-    while (HasNext() && NextDigit()) {
-      SkipOne();
-    }
-    return *this;
+    return SkipTo(detail::FindNonDigit(Begin(), End()));
   }
 
+  // Decimal floating-point number, a ',' decimal separator ends the number
+  // and the fraction after it is skipped
+  // Throws std::invalid_argument if there is no number and
+  // std::out_of_range if it does not fit a double
   double ReadDouble() {
-    auto string = source_;
+    double value = 0;
+    const char* stop = ParseDouble(value);
+    if (stop == Begin()) {
+      throw std::invalid_argument("StringReader::ReadDouble: no number");
+    }
+    SkipTo(stop);
 
-    SkipDigits();
-    if (HasNext() && (Next('.') || Next(','))) {
+    if (HasNext() && Next(',')) {
       SkipOne().SkipDigits();
     }
+    return value;
+  }
+
+ private:
+  const char* Begin() const {
+    return source_.data();
+  }
+
+  const char* End() const {
+    return source_.data() + source_.size();
+  }
+
+  StringReader& SkipTo(const char* position) {
+    source_.remove_prefix(position - Begin());
+    return *this;
+  }
 
-    return std::stod(string.data());
+  // Returns the end of the parsed number, Begin() if there is none
+  // Throws std::out_of_range if the number does not fit a double
+  const char* ParseDouble(double& value) const {
+    // std::from_chars rejects the leading '+' that std::stod took
+    const char* begin = Begin();
+    if (End() - begin > 1 && begin[0] == '+' && begin[1] != '+' && begin[1] != '-') {
+      ++begin;
+    }
+#if defined(__cpp_lib_to_chars)
+    const auto result = std::from_chars(begin, End(), value);
+    if (result.ec == std::errc::invalid_argument) {
+      return Begin();
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+      throw std::out_of_range("StringReader::ReadDouble: out of range");
+    }
+    return result.ptr;
+#else
+    // No floating-point from_chars (libc++ < 20): strtod in the "C" locale
+    // on a bounded null-terminated copy of the number prefix
+    if (begin == End() || detail::IsSpaceChar(*begin)) {
+      return Begin();  // strtod would skip the spaces
+    }
+    char buffer[64];
+    const size_t length = std::min<size_t>(End() - begin, sizeof(buffer) - 1);
+    std::memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+    char* stop = buffer;
+    errno = 0;
+    value = ::strtod_l(buffer, &stop, detail::ClassicLocale());
+    if (stop == buffer) {
+      return Begin();
+    }
+    if (errno == ERANGE) {
+      throw std::out_of_range("StringReader::ReadDouble: out of range");
+    }
+    return begin + (stop - buffer);
+#endif
   }
 
  private:
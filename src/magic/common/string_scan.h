@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace magic::detail {
+
+//////////////////////////////////////////////////////////////////////
+
+// Scanning kernels for StringReader
+// Character classes (spaces, digits) are matched 16 or 32 bytes at a time,
+// a single character is searched with memchr
+// Compile-time dispatch: AVX2 when the target enables it (-mavx2, -march=native),
+// SSE2 on every x86-64 target, scalar elsewhere
+// Only whole vectors inside [begin, end) are loaded, the tail is scanned
+// by the scalar loop, nothing is read past the end
+
+// Every kernel returns the first position in [begin, end) that
+// satisfies the condition, or end
+
+//////////////////////////////////////////////////////////////////////
+
+// Space in the "C" locale: ' ', '\t', '\n', '\v', '\f', '\r'
+inline bool IsSpaceChar(char ch) {
+  return ch == ' ' || static_cast<uint8_t>(ch - '\t') <= '\r' - '\t';
+}
+
+inline bool IsDigitChar(char ch) {
+  return static_cast<uint8_t>(ch - '0') <= 9;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+#if defined(__AVX2__)
+
+// Bit per byte: lowest - first of the 32 bytes
+inline uint32_t InRangeMask32(__m256i chunk, char low, uint8_t width) {
+  // (ch - low) as unsigned <= width
+  const __m256i shifted = _mm256_sub_epi8(chunk, _mm256_set1_epi8(low));
+  const __m256i clamped = _mm256_min_epu8(shifted, _mm256_set1_epi8(static_cast<char>(width)));
+  return _mm256_movemask_epi8(_mm256_cmpeq_epi8(clamped, shifted));
+}
+
+#endif
+
+#if defined(__SSE2__)
+
+inline uint32_t InRangeMask16(__m128i chunk, char low, uint8_t width) {
+  const __m128i shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(low));
+  const __m128i clamped = _mm_min_epu8(shifted, _mm_set1_epi8(static_cast<char>(width)));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(clamped, shifted));
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+
+// glibc memchr is already vectorized and picks the widest instruction set
+// at run time, a hand-written loop only loses to it
+inline const char* FindChar(const char* begin, const char* end, char ch) {
+  // memchr is declared nonnull, an empty default string_view has no data
+  if (begin == end) {
+    return end;
+  }
+  auto found = static_cast<const char*>(std::memchr(begin, ch, end - begin));
+  return (found != nullptr) ? found : end;
+}
+
+inline const char* FindNonSpace(const char* begin, const char* end) {
+  // Runs are often empty or a single space, skip the vector setup then
+  for (size_t index = 0; index < 2; ++index, ++begin) {
+    if (begin == end || !IsSpaceChar(*begin)) {
+      return begin;
+    }
+  }
+#if defined(__AVX2__)
+  const __m256i space32 = _mm256_set1_epi8(' ');
+  for (; end - begin >= 32; begin += 32) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const uint32_t spaces = InRangeMask32(chunk, '\t', '\r' - '\t') |
+                            _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, space32));
+    if (spaces != 0xFFFFFFFF) {
+      return begin + __builtin_ctz(~spaces);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i space16 = _mm_set1_epi8(' ');
+  for (; end - begin >= 16; begin += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const uint32_t spaces = InRangeMask16(chunk, '\t', '\r' - '\t') |
+                            _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, space16));
+    if (spaces != 0xFFFF) {
+      return begin + __builtin_ctz(~spaces);
+    }
+  }
+#endif
+  for (; begin != end; ++begin) {
+    if (!IsSpaceChar(*begin)) {
+      return begin;
+    }
+  }
+  return end;
+}
+
+inline const char* FindNonDigit(const char* begin, const char* end) {
+  // Short numbers do not amortize the vector setup
+  for (size_t index = 0; index < 4; ++index, ++begin) {
+    if (begin == end || !IsDigitChar(*begin)) {
+      return begin;
+    }
+  }
+#if defined(__AVX2__)
+  for (; end - begin >= 32; begin += 32) {
+    const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const uint32_t digits = InRangeMask32(chunk, '0', 9);
+    if (digits != 0xFFFFFFFF) {
+      return begin + __builtin_ctz(~digits);
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  for (; end - begin >= 16; begin += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const uint32_t digits = InRangeMask16(chunk, '0', 9);
+    if (digits != 0xFFFF) {
+      return begin + __builtin_ctz(~digits);
+    }
+  }
+#endif
+  for (; begin != end; ++begin) {
+    if (!IsDigitChar(*begin)) {
+      return begin;
+    }
+  }
+  return end;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::detail
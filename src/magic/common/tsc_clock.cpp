@@ -0,0 +1,99 @@
+#include <magic/common/tsc_clock.h>
+
+#include <thread>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+namespace magic::detail {
+
+//////////////////////////////////////////////////////////////////////
+
+#if defined(__x86_64__)
+
+namespace {
+
+// Ticks at the same instant as the steady_clock read: the middle of the
+// tightest of a few bracketing counter reads
+struct ClockPair {
+  uint64_t ticks;
+  int64_t nanos;
+};
+
+ClockPair ReadClockPair() {
+  ClockPair best{};
+  uint64_t best_window = UINT64_MAX;
+  for (size_t attempt = 0; attempt < 16; ++attempt) {
+    const uint64_t before = ReadTscFenced();
+    const int64_t nanos = SteadyNanos();
+    const uint64_t after = ReadTscFenced();
+    if (after - before < best_window) {
+      best_window = after - before;
+      best = {before + (after - before) / 2, nanos};
+    }
+  }
+  return best;
+}
+
+// CPUID.80000007H:EDX[8]: the counter runs at a constant rate in all
+// power states, so it measures wall time
+bool HasInvariantTsc() {
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007) {
+    return false;
+  }
+  __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+  return (edx & (1u << 8)) != 0;
+}
+
+}  // namespace
+
+TscCalibration CalibrateTsc() {
+  static const auto kWindow = std::chrono::milliseconds(10);
+  static const double kMinTicksPerNano = 0.1;
+  static const double kMaxTicksPerNano = 10;
+
+  if (!HasInvariantTsc()) {
+    return {};
+  }
+
+  const auto start = ReadClockPair();
+  std::this_thread::sleep_for(kWindow);
+  const auto end = ReadClockPair();
+
+  if (end.ticks <= start.ticks || end.nanos <= start.nanos) {
+    return {};
+  }
+  const double ticks_per_nano = double(end.ticks - start.ticks) / double(end.nanos - start.nanos);
+  if (ticks_per_nano < kMinTicksPerNano || ticks_per_nano > kMaxTicksPerNano) {
+    return {};
+  }
+
+  return {.Reliable = true,
+          .Multiplier = static_cast<uint64_t>(double(1ull << 32) / ticks_per_nano),
+          .BaseTicks = end.ticks,
+          .BaseNanos = end.nanos};
+}
+
+#else
+
+TscCalibration CalibrateTsc() {
+  return {};
+}
+
+#endif
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Calibrate during static initialization, so that the first timed task or
+// lock hold does not pay for the measurement window
+[[maybe_unused]] const TscCalibration& eager_calibration = GetTscCalibration();
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::detail
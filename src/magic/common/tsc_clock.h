@@ -0,0 +1,141 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+#if defined(__x86_64__)
+
+// Raw time stamp counter reads, a few ns each and no system call
+
+// May be reordered with the surrounding instructions: fine for intervals
+// much longer than the pipeline (tasks, lock holds, requests)
+inline uint64_t ReadTsc() {
+  return __rdtsc();
+}
+
+// Waits for the preceding instructions and keeps the following ones from
+// starting early: use at the start of a short measured section
+inline uint64_t ReadTscFenced() {
+  _mm_lfence();
+  const uint64_t ticks = __rdtsc();
+  _mm_lfence();
+  return ticks;
+}
+
+// Waits for the preceding instructions to complete: use at the end of a
+// short measured section
+inline uint64_t ReadTscp() {
+  unsigned int cpu;
+  const uint64_t ticks = __rdtscp(&cpu);
+  _mm_lfence();
+  return ticks;
+}
+
+#endif
+
+struct TscCalibration {
+  // False if the counter is missing, not invariant or failed calibration,
+  // TscClock reads steady_clock then
+  bool Reliable = false;
+  // Nanoseconds per tick in 32.32 fixed point
+  uint64_t Multiplier = 0;
+  // The same instant on both clocks
+  uint64_t BaseTicks = 0;
+  int64_t BaseNanos = 0;
+};
+
+// Measures the counter against steady_clock for a few milliseconds
+TscCalibration CalibrateTsc();
+
+// Computed at startup by tsc_clock.cpp, or by the first call if that
+// comes from another static initializer
+inline const TscCalibration& GetTscCalibration() {
+  static const TscCalibration calibration = CalibrateTsc();
+  return calibration;
+}
+
+inline int64_t SteadyNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Clock on top of the invariant time stamp counter, calibrated against
+// steady_clock at startup and aligned to its epoch
+// A single rdtsc plus a multiply-shift per read, no vDSO call; falls back to
+// steady_clock where the counter is unreliable
+
+// Hot paths may keep raw Ticks() and convert differences later:
+// auto start = TscClock::Ticks();
+// ...
+// busy += TscClock::TicksToDuration(TscClock::Ticks() - start);
+
+class TscClock final {
+ public:
+  using rep = int64_t;
+  using period = std::nano;
+  using duration = std::chrono::nanoseconds;
+  using time_point = std::chrono::time_point<TscClock>;
+  static constexpr bool is_steady = true;
+
+  static time_point now() noexcept {
+    const auto& calibration = detail::GetTscCalibration();
+#if defined(__x86_64__)
+    if (calibration.Reliable) {
+      const auto ticks = static_cast<int64_t>(detail::ReadTsc() - calibration.BaseTicks);
+      return time_point{duration{calibration.BaseNanos + Scale(ticks, calibration)}};
+    }
+#endif
+    return time_point{duration{detail::SteadyNanos()}};
+  }
+
+  // Raw counter value, nanoseconds of steady_clock in fallback mode
+  static uint64_t Ticks() {
+#if defined(__x86_64__)
+    if (detail::GetTscCalibration().Reliable) {
+      return detail::ReadTsc();
+    }
+#endif
+    return detail::SteadyNanos();
+  }
+
+  static duration TicksToDuration(uint64_t ticks) {
+    const auto& calibration = detail::GetTscCalibration();
+    const auto signed_ticks = static_cast<int64_t>(ticks);
+    return duration{calibration.Reliable ? Scale(signed_ticks, calibration) : signed_ticks};
+  }
+
+  // Whether the time stamp counter is used
+  static bool IsReliable() {
+    return detail::GetTscCalibration().Reliable;
+  }
+
+  static double TicksPerSecond() {
+    const auto& calibration = detail::GetTscCalibration();
+    return calibration.Reliable ? 1e9 * (1ull << 32) / calibration.Multiplier : 1e9;
+  }
+
+ private:
+  // Signed: another core may read a slightly smaller counter value
+  static int64_t Scale(int64_t ticks, const detail::TscCalibration& calibration) {
+    return static_cast<int64_t>((static_cast<__int128_t>(ticks) * calibration.Multiplier) >> 32);
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
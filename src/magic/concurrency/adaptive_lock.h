@@ -0,0 +1,81 @@
+#pragma once
+
+#include <magic/concurrency/spinlock.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Spin-then-park mutex
+// Spins for a bounded number of iterations hoping for a short critical
+// section, then sleeps in the kernel via atomic wait (futex on Linux)
+
+// Unlock issues a wake-up only if some thread may be parked
+
+class AdaptiveLock final {
+  enum State : uint32_t {
+    Free = 0,
+    Locked = 1,
+    // Locked, waiters may be parked
+    Contended = 2,
+  };
+
+ public:
+  static const size_t kDefaultSpinBudget = 128;
+
+  explicit AdaptiveLock(size_t spin_budget = kDefaultSpinBudget) : spin_budget_(spin_budget) {
+  }
+
+  // ~ Public Interface
+
+  void Lock() {
+    for (size_t spin = 0; spin < spin_budget_; ++spin) {
+      if (state_.load(std::memory_order::relaxed) == Free && TryLock()) {
+        return;
+      }
+      detail::SpinLockPause();
+    }
+
+    // Slow path: announce contention and park
+    while (state_.exchange(Contended, std::memory_order::acquire) != Free) {
+      state_.wait(Contended, std::memory_order::relaxed);
+    }
+  }
+
+  bool TryLock() {
+    uint32_t expected = Free;
+    return state_.compare_exchange_strong(expected, Locked, std::memory_order::acquire,
+                                          std::memory_order::relaxed);
+  }
+
+  void Unlock() {
+    if (state_.exchange(Free, std::memory_order::release) == Contended) {
+      state_.notify_one();
+    }
+  }
+
+  // Lockable
+
+  void lock() {
+    Lock();
+  }
+
+  bool try_lock() {
+    return TryLock();
+  }
+
+  void unlock() {
+    Unlock();
+  }
+
+ private:
+  std::atomic<uint32_t> state_ = Free;
+  const size_t spin_budget_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -1,38 +1,69 @@
 #pragma once
 
+#include <magic/concurrency/sharded_counter.h>
+
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
 
 namespace magic {
 
+//////////////////////////////////////////////////////////////////////
+
+// Outstanding work counter
+// Add and Done touch only the slots of the calling thread
+
+// Zero detection: started and finished work are counted separately and
+// only ever grow. Finished is summed up before started, and every Done
+// happens after its Add, so started == finished can only be observed
+// when every started item whose completion has been seen is accounted for,
+// including work added by the items themselves before they finished
+
+// Not a destruction barrier: Done keeps reading the counters, waiters_ and
+// mutex_ after its increment, so WaitZero may return while the last Done
+// is still running. Fine for waiting on work whose threads outlive the
+// counter (ThreadPool joins its workers before destruction); to free the
+// owner after the wait use BlockingWaitGroup
+
 class AtomicCounter final {
  public:
-
   // ~ Public Interface
 
-  void Add(size_t count = 1){
-    counter_.fetch_add(count, std::memory_order::relaxed);
+  void Add(size_t count = 1) {
+    started_.Add(count, std::memory_order::seq_cst);
   }
 
   void Done() {
-    if (counter_.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+    finished_.Add(1, std::memory_order::seq_cst);
+    // Pairs with the increment of waiters_ in WaitZero
+    if (waiters_.load(std::memory_order::seq_cst) > 0 && IsZero()) {
       std::lock_guard lock(mutex_);
       all_done_.notify_all();
     }
   }
 
+  bool IsZero() const {
+    const auto finished = finished_.Sum(std::memory_order::seq_cst);
+    return started_.Sum(std::memory_order::seq_cst) == finished;
+  }
+
   void WaitZero() {
     std::unique_lock lock(mutex_);
-    while (counter_.load() > 0) {
+    waiters_.fetch_add(1, std::memory_order::seq_cst);
+    while (!IsZero()) {
       all_done_.wait(lock);
     }
+    waiters_.fetch_sub(1, std::memory_order::relaxed);
   }
 
  private:
-  std::atomic<size_t> counter_ = 0;
+  ShardedCounter started_;
+  ShardedCounter finished_;
+  std::atomic<size_t> waiters_ = 0;
   std::mutex mutex_;
   std::condition_variable all_done_;
 };
 
-}  // namespace magic
\ No newline at end of file
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
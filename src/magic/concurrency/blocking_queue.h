@@ -80,4 +80,82 @@ class UnboundedBlockingQueue final {
 
 //////////////////////////////////////////////////////////////////////
 
+// Bounded Blocking Multi-Producer / Multi-Consumer Queue (MPMC)
+// Producers block while the queue is full, which throttles them
+// to the pace of the consumers
+
+template <typename T>
+class BoundedBlockingQueue final {
+ public:
+  explicit BoundedBlockingQueue(size_t capacity) : capacity_(capacity) {
+    WHEELS_VERIFY(capacity > 0, "Capacity must be positive");
+  }
+
+  // Thread role: producer
+  // Blocks while the queue is full, returns false once cancelled
+  bool Put(T value) {
+    std::unique_lock lock(mutex_);
+
+    while (!cancelled_ && buffer_.size() >= capacity_) {
+      not_full_.wait(lock);
+    }
+    if (closed_ || cancelled_) {
+      return false;
+    }
+    buffer_.emplace_back(std::move(value));
+    not_empty_.notify_one();
+
+    return true;
+  }
+
+  // Thread role: consumer
+  // Returns std::nullopt once the queue is closed and drained, or cancelled
+  std::optional<T> Take() {
+    std::unique_lock lock(mutex_);
+
+    while (buffer_.empty()) {
+      if (closed_ || cancelled_) {
+        return std::nullopt;
+      }
+      not_empty_.wait(lock);
+    }
+
+    T value = std::move(buffer_.front());
+    buffer_.pop_front();
+    not_full_.notify_one();
+    return value;
+  }
+
+  // Thread role: producer
+  // No more values, the consumers drain the queued ones
+  void Close() {
+    std::lock_guard guard(mutex_);
+    closed_ = true;
+    not_empty_.notify_all();
+  }
+
+  // Thread role: consumer
+  // Drops the queued values and releases blocked producers
+  void Cancel() {
+    std::lock_guard guard(mutex_);
+    cancelled_ = true;
+    buffer_.clear();
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  const size_t capacity_;
+
+  std::deque<T> buffer_;
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+
+  bool closed_ = false;
+  bool cancelled_ = false;
+};
+
+//////////////////////////////////////////////////////////////////////
+
 }  // namespace name
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Outstanding work counter that doubles as a destruction barrier
+// The last Done signals while holding mutex_ and touches nothing after
+// unlocking it, so the owner may be destroyed as soon as Wait returns
+// Wait blocks the calling thread, fibers use fibers::WaitGroup
+
+// Every Add and Done takes the mutex: use for connections, requests and
+// timers, AtomicCounter for per-task counting
+
+class BlockingWaitGroup final {
+ public:
+  // ~ Public Interface
+
+  void Add(size_t count = 1) {
+    std::lock_guard guard(mutex_);
+    count_ += count;
+  }
+
+  void Done() {
+    std::lock_guard guard(mutex_);
+    if (--count_ == 0) {
+      // Under the lock: the waiter cannot return before the unlock
+      all_done_.notify_all();
+    }
+  }
+
+  void Wait() {
+    std::unique_lock lock(mutex_);
+    all_done_.wait(lock, [this] {
+      return count_ == 0;
+    });
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable all_done_;
+  size_t count_ = 0;  // Guarded by mutex_
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
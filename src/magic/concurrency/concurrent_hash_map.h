@@ -0,0 +1,341 @@
+#pragma once
+
+#include <magic/common/dictionary.h>
+#include <magic/concurrency/epoch.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Concurrent hash map
+// - Lock-free reads: readers traverse bucket chains inside an epoch guard
+//   and never write shared memory
+// - Writers link and unlink nodes under striped locks, values are immutable:
+//   an update replaces the node and retires the old one
+// - Incremental resizing: buckets are copied to the next table one at a time,
+//   by writers touching them and in small batches on every write
+
+// Usage:
+// ConcurrentDictionary cache;
+// cache.Insert("key", "value");
+// if (auto value = cache.Find(std::string_view{"key"})) { ... }
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<>>
+class ConcurrentHashMap final {
+  struct Node {
+    Node(size_t h, Key k, Value v, Node* n)
+        : hash(h), key(std::move(k)), value(std::move(v)), next(n) {
+    }
+
+    // Cached to skip key comparisons and rehashing on resize
+    const size_t hash;
+    const Key key;
+    const Value value;
+    std::atomic<Node*> next;
+  };
+
+  struct Bucket {
+    std::atomic<Node*> head = nullptr;
+    // Set after the chain has been copied to the next table
+    std::atomic<bool> moved = false;
+  };
+
+  struct Table {
+    explicit Table(size_t size) : buckets(new Bucket[size]), mask(size - 1) {
+    }
+
+    size_t Size() const {
+      return mask + 1;
+    }
+
+    Bucket& GetBucket(size_t hash) {
+      return buckets[hash & mask];
+    }
+
+    std::unique_ptr<Bucket[]> buckets;
+    const size_t mask;
+
+    std::atomic<Table*> next = nullptr;
+    std::atomic<size_t> migrate_cursor = 0;
+    std::atomic<size_t> migrated = 0;
+  };
+
+  struct alignas(64) Stripe {
+    std::mutex mutex;
+  };
+
+  static const size_t kStripes = 64;
+  static const size_t kMinBuckets = kStripes;
+  static const size_t kMigrateBatch = 4;
+  static const size_t kMaxLoadFactor = 2;
+
+ public:
+  explicit ConcurrentHashMap(size_t buckets = kMinBuckets) {
+    size_t size = kMinBuckets;
+    while (size < buckets) {
+      size *= 2;
+    }
+    current_.store(new Table(size));
+  }
+
+  // Non-copyable
+  ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+  ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+  // Context: no concurrent accesses
+  ~ConcurrentHashMap() {
+    auto table = current_.load();
+    while (table) {
+      for (size_t index = 0; index < table->Size(); ++index) {
+        DeleteChain(table->buckets[index].head.load());
+      }
+      delete std::exchange(table, table->next.load());
+    }
+  }
+
+  // ~ Public Interface
+
+  // Lock-free, does not block on writers
+  template <typename K>
+  std::optional<Value> Find(const K& key) const {
+    std::optional<Value> result;
+    Visit(key, [&result](const Value& value) {
+      result.emplace(value);
+    });
+    return result;
+  }
+
+  template <typename K>
+  bool Contains(const K& key) const {
+    return Visit(key, [](const Value&) {});
+  }
+
+  // Calls visitor with a reference to the value, valid during the call only
+  template <typename K, typename F>
+  bool Visit(const K& key, F&& visitor) const {
+    const auto hash = hasher_(key);
+
+    epoch::Guard guard;
+
+    Table* table = current_.load(std::memory_order::acquire);
+    while (true) {
+      auto& bucket = table->GetBucket(hash);
+      auto node = FindNode(bucket.head.load(std::memory_order::acquire), hash, key);
+      if (bucket.moved.load(std::memory_order::acquire)) {
+        // The chain may be stale, retry in the next table
+        table = table->next.load(std::memory_order::acquire);
+        continue;
+      }
+      if (node) {
+        visitor(node->value);
+        return true;
+      }
+      return false;
+    }
+  }
+
+  // Inserts a new element or replaces the value of the existing one
+  // Returns true if the element has been inserted
+  bool Insert(Key key, Value value) {
+    const auto hash = hasher_(key);
+
+    epoch::Guard guard;
+    bool inserted = false;
+    {
+      std::lock_guard lock(GetStripe(hash));
+      auto& bucket = LockedBucket(hash);
+
+      auto link = FindLink(bucket, hash, key);
+      if (auto found = link->load(std::memory_order::relaxed)) {
+        auto node = new Node(hash, std::move(key), std::move(value), found->next.load());
+        link->store(node, std::memory_order::release);
+        epoch::Retire(found);
+      } else {
+        auto head = bucket.head.load(std::memory_order::relaxed);
+        auto node = new Node(hash, std::move(key), std::move(value), head);
+        bucket.head.store(node, std::memory_order::release);
+        inserted = true;
+      }
+    }
+
+    if (inserted) {
+      size_.fetch_add(1, std::memory_order::relaxed);
+    }
+    AfterWrite();
+    return inserted;
+  }
+
+  // Returns true if the element has been removed
+  template <typename K>
+  bool Erase(const K& key) {
+    const auto hash = hasher_(key);
+
+    epoch::Guard guard;
+    {
+      std::lock_guard lock(GetStripe(hash));
+      auto& bucket = LockedBucket(hash);
+
+      auto link = FindLink(bucket, hash, key);
+      auto found = link->load(std::memory_order::relaxed);
+      if (!found) {
+        return false;
+      }
+      link->store(found->next.load(), std::memory_order::release);
+      epoch::Retire(found);
+    }
+
+    size_.fetch_sub(1, std::memory_order::relaxed);
+    AfterWrite();
+    return true;
+  }
+
+  size_t Size() const {
+    return size_.load(std::memory_order::relaxed);
+  }
+
+  bool IsEmpty() const {
+    return Size() == 0;
+  }
+
+  // Number of buckets in the current table
+  size_t BucketCount() const {
+    epoch::Guard guard;
+    return current_.load()->Size();
+  }
+
+  bool IsResizing() const {
+    epoch::Guard guard;
+    return current_.load()->next.load() != nullptr;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  template <typename K>
+  const Node* FindNode(const Node* node, size_t hash, const K& key) const {
+    while (node && !(node->hash == hash && equal_(node->key, key))) {
+      node = node->next.load(std::memory_order::acquire);
+    }
+    return node;
+  }
+
+  // Context: stripe of the bucket is locked
+  // Returns the link pointing to the node with the key or the terminating null link
+  template <typename K>
+  std::atomic<Node*>* FindLink(Bucket& bucket, size_t hash, const K& key) {
+    auto link = &bucket.head;
+    while (auto node = link->load(std::memory_order::relaxed)) {
+      if (node->hash == hash && equal_(node->key, key)) {
+        break;
+      }
+      link = &node->next;
+    }
+    return link;
+  }
+
+  static void DeleteChain(Node* node) {
+    while (node) {
+      delete std::exchange(node, node->next.load());
+    }
+  }
+
+  std::mutex& GetStripe(size_t hash) {
+    return stripes_[hash % kStripes].mutex;
+  }
+
+  // Context: epoch guard, stripe of the hash is locked
+  // Migrates the bucket out of the old tables and returns the bucket of the newest one
+  Bucket& LockedBucket(size_t hash) {
+    Table* table = current_.load(std::memory_order::acquire);
+    while (Table* next = table->next.load(std::memory_order::acquire)) {
+      MigrateBucketLocked(table, hash & table->mask);
+      table = next;
+    }
+    return table->GetBucket(hash);
+  }
+
+  // Context: epoch guard, stripe of the bucket is locked
+  // Table sizes are multiples of kStripes, so an old bucket and both of its
+  // new buckets are covered by the same stripe
+  void MigrateBucketLocked(Table* table, size_t index) {
+    auto& bucket = table->buckets[index];
+    if (bucket.moved.load(std::memory_order::relaxed)) {
+      return;
+    }
+
+    Table* next = table->next.load();
+
+    // Readers may still traverse the old chain: copy instead of relinking
+    auto chain = bucket.head.load(std::memory_order::relaxed);
+    for (auto node = chain; node != nullptr; node = node->next.load()) {
+      auto& target = next->GetBucket(node->hash);
+      auto head = target.head.load(std::memory_order::relaxed);
+      auto copy = new Node(node->hash, node->key, node->value, head);
+      target.head.store(copy, std::memory_order::release);
+    }
+
+    bucket.moved.store(true, std::memory_order::release);
+    bucket.head.store(nullptr, std::memory_order::relaxed);
+
+    while (chain) {
+      epoch::Retire(std::exchange(chain, chain->next.load()));
+    }
+
+    if (table->migrated.fetch_add(1) + 1 == table->Size()) {
+      // The last bucket has been moved
+      current_.store(next, std::memory_order::release);
+      epoch::Retire(table);
+    }
+  }
+
+  void AfterWrite() {
+    Table* table = current_.load(std::memory_order::acquire);
+    if (table->next.load(std::memory_order::acquire) != nullptr) {
+      HelpMigrate(table);
+    } else if (Size() > table->Size() * kMaxLoadFactor) {
+      StartResize(table);
+    }
+  }
+
+  void StartResize(Table* table) {
+    Table* expected = nullptr;
+    auto next = new Table(table->Size() * 2);
+    if (!table->next.compare_exchange_strong(expected, next)) {
+      delete next;  // Already started
+    }
+  }
+
+  void HelpMigrate(Table* table) {
+    for (size_t step = 0; step < kMigrateBatch; ++step) {
+      const auto index = table->migrate_cursor.fetch_add(1, std::memory_order::relaxed);
+      if (index >= table->Size()) {
+        return;
+      }
+      std::lock_guard lock(stripes_[index % kStripes].mutex);
+      MigrateBucketLocked(table, index);
+    }
+  }
+
+ private:
+  Hash hasher_;
+  KeyEqual equal_;
+
+  std::atomic<Table*> current_;
+  std::atomic<size_t> size_ = 0;
+  Stripe stripes_[kStripes];
+};
+
+//////////////////////////////////////////////////////////////////////
+
+using ConcurrentDictionary =
+    ConcurrentHashMap<std::string, std::string, detail::StringHash, std::equal_to<>>;
+
+}  // namespace magic
@@ -0,0 +1,200 @@
+#include <magic/concurrency/epoch.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace magic::epoch {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+struct Retired {
+  void* ptr;
+  Deleter deleter;
+
+  void Delete() const {
+    deleter(ptr);
+  }
+};
+
+// Retired objects of one epoch
+struct Limbo {
+  uint64_t epoch = 0;
+  std::vector<Retired> items;
+
+  void Reclaim() {
+    // Deleters may retire more objects
+    auto reclaimed = std::exchange(items, {});
+    for (auto&& item : reclaimed) {
+      item.Delete();
+    }
+  }
+};
+
+struct alignas(64) ThreadRecord {
+  static const uint64_t kUnpinned = 0;
+
+  // Written by the owner, read by threads advancing the epoch
+  std::atomic<uint64_t> pinned = kUnpinned;
+  std::atomic<bool> in_use = true;
+  ThreadRecord* next = nullptr;
+
+  // Owned by the thread holding the record,
+  // retired objects are inherited by the next owner
+  size_t nesting = 0;
+  size_t retired_since_collect = 0;
+  Limbo limbo[3];
+};
+
+class Domain final {
+  static const size_t kCollectThreshold = 64;
+
+ public:
+  static Domain& Instance() {
+    static Domain instance;
+    return instance;
+  }
+
+  ~Domain() {
+    auto record = records_.load();
+    while (record) {
+      for (auto&& limbo : record->limbo) {
+        limbo.Reclaim();
+      }
+      delete std::exchange(record, record->next);
+    }
+  }
+
+  ThreadRecord* Acquire() {
+    for (auto record = records_.load(); record; record = record->next) {
+      bool free = false;
+      if (record->in_use.compare_exchange_strong(free, true)) {
+        return record;
+      }
+    }
+
+    auto record = new ThreadRecord();
+    record->next = records_.load();
+    while (!records_.compare_exchange_weak(record->next, record)) {
+    }
+    return record;
+  }
+
+  void Release(ThreadRecord* record) {
+    WHEELS_ASSERT(record->nesting == 0, "Thread exits inside of an epoch guard");
+    record->in_use.store(false);
+  }
+
+  void Enter(ThreadRecord* record) {
+    if (record->nesting++ == 0) {
+      record->pinned.store(epoch_.load(std::memory_order::relaxed));
+      // Announce the pin before any protected load
+      std::atomic_thread_fence(std::memory_order::seq_cst);
+    }
+  }
+
+  void Exit(ThreadRecord* record) {
+    WHEELS_ASSERT(record->nesting > 0, "Unbalanced epoch guard");
+    if (--record->nesting == 0) {
+      record->pinned.store(ThreadRecord::kUnpinned, std::memory_order::release);
+    }
+  }
+
+  void Retire(ThreadRecord* record, Retired retired) {
+    const auto epoch = epoch_.load();
+    auto& limbo = record->limbo[epoch % 3];
+    if (limbo.epoch != epoch) {
+      // Objects from epoch - 3 or earlier
+      limbo.Reclaim();
+      limbo.epoch = epoch;
+    }
+    limbo.items.push_back(retired);
+
+    if (++record->retired_since_collect >= kCollectThreshold) {
+      Collect(record);
+    }
+  }
+
+  void Collect(ThreadRecord* record) {
+    record->retired_since_collect = 0;
+    TryAdvance();
+
+    const auto epoch = epoch_.load();
+    for (auto&& limbo : record->limbo) {
+      if (limbo.epoch + 2 <= epoch) {
+        limbo.Reclaim();
+      }
+    }
+  }
+
+ private:
+  bool TryAdvance() {
+    auto epoch = epoch_.load();
+    // Pairs with the fence in Enter: either the scan sees the pin, or the
+    // pinned thread sees the unlinks that preceded this call
+    std::atomic_thread_fence(std::memory_order::seq_cst);
+    for (auto record = records_.load(); record; record = record->next) {
+      const auto pinned = record->pinned.load(std::memory_order::acquire);
+      if (pinned != ThreadRecord::kUnpinned && pinned != epoch) {
+        return false;
+      }
+    }
+    return epoch_.compare_exchange_strong(epoch, epoch + 1);
+  }
+
+ private:
+  std::atomic<uint64_t> epoch_ = 1;
+  std::atomic<ThreadRecord*> records_ = nullptr;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class ThreadRecordHolder final {
+ public:
+  ThreadRecord* Get() {
+    if (record_ == nullptr) {
+      record_ = Domain::Instance().Acquire();
+    }
+    return record_;
+  }
+
+  ~ThreadRecordHolder() {
+    if (record_) {
+      Domain::Instance().Release(record_);
+    }
+  }
+
+ private:
+  ThreadRecord* record_ = nullptr;
+};
+
+static thread_local ThreadRecordHolder this_thread_record;
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+Guard::Guard() {
+  detail::Domain::Instance().Enter(detail::this_thread_record.Get());
+}
+
+Guard::~Guard() {
+  detail::Domain::Instance().Exit(detail::this_thread_record.Get());
+}
+
+void Retire(void* ptr, Deleter deleter) {
+  detail::Domain::Instance().Retire(detail::this_thread_record.Get(), {ptr, deleter});
+}
+
+void Collect() {
+  detail::Domain::Instance().Collect(detail::this_thread_record.Get());
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::epoch
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+namespace magic::epoch {
+
+//////////////////////////////////////////////////////////////////////
+
+// Epoch-based memory reclamation
+
+// Readers pin the current epoch for the duration of a critical section
+// and only write their own per-thread record.
+// Unlinked objects are retired and deleted once every pinned thread
+// has moved at least two epochs past the retirement.
+
+// Usage:
+// {
+//   epoch::Guard guard;
+//   auto node = head.load();  // <-- Safe to dereference until the guard is destroyed
+// }
+//
+// head.store(next);  // Unlink
+// epoch::Retire(node);
+
+//////////////////////////////////////////////////////////////////////
+
+using Deleter = void (*)(void*);
+
+// Pins the current thread, guards are reentrant
+class Guard final {
+ public:
+  Guard();
+  ~Guard();
+
+  // Non-copyable
+  Guard(const Guard&) = delete;
+  Guard& operator=(const Guard&) = delete;
+};
+
+// Context: any thread, inside or outside of a guard
+void Retire(void* ptr, Deleter deleter);
+
+template <typename T>
+void Retire(T* ptr) {
+  Retire(ptr, [](void* p) {
+    delete static_cast<T*>(p);
+  });
+}
+
+// Tries to advance the global epoch and reclaim the retired objects of the current thread
+void Collect();
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::epoch
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <magic/concurrency/spinlock.h>
+
+#include <atomic>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// MCS queue spinlock (Mellor-Crummey, Scott)
+// FIFO, each waiter spins on its own node, so a release touches
+// only the cache line of the next owner
+
+// Usage:
+// MCSLock lock;
+// {
+//   MCSLock::Guard guard(lock);
+//   // <-- Critical section
+// }
+
+class MCSLock final {
+ public:
+  struct alignas(64) Node {
+    std::atomic<Node*> next = nullptr;
+    std::atomic<bool> locked = false;
+  };
+
+  // Owns the queue node for the duration of the critical section
+  class Guard final {
+   public:
+    explicit Guard(MCSLock& lock) : lock_(lock) {
+      lock_.Lock(node_);
+    }
+
+    ~Guard() {
+      lock_.Unlock(node_);
+    }
+
+    // Non-copyable
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+   private:
+    MCSLock& lock_;
+    Node node_;
+  };
+
+ public:
+  // ~ Public Interface
+
+  // Node must stay alive and unmoved until the matching Unlock
+  void Lock(Node& node) {
+    node.next.store(nullptr, std::memory_order::relaxed);
+    node.locked.store(true, std::memory_order::relaxed);
+
+    Node* prev = tail_.exchange(&node, std::memory_order::acq_rel);
+    if (prev == nullptr) {
+      return;  // Lock was free
+    }
+
+    prev->next.store(&node, std::memory_order::release);
+    detail::SpinWait spin_wait;
+    while (node.locked.load(std::memory_order::acquire)) {
+      spin_wait();
+    }
+  }
+
+  bool TryLock(Node& node) {
+    node.next.store(nullptr, std::memory_order::relaxed);
+    Node* expected = nullptr;
+    return tail_.compare_exchange_strong(expected, &node, std::memory_order::acquire,
+                                         std::memory_order::relaxed);
+  }
+
+  void Unlock(Node& node) {
+    Node* next = node.next.load(std::memory_order::acquire);
+    if (next == nullptr) {
+      Node* expected = &node;
+      if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order::release,
+                                        std::memory_order::relaxed)) {
+        return;  // No waiters
+      }
+      // Successor is linking itself
+      detail::SpinWait spin_wait;
+      while ((next = node.next.load(std::memory_order::acquire)) == nullptr) {
+        spin_wait();
+      }
+    }
+    next->locked.store(false, std::memory_order::release);
+  }
+
+ private:
+  std::atomic<Node*> tail_ = nullptr;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <magic/concurrency/spinlock.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Sequence lock for small trivially copyable snapshots
+// Readers never write shared memory: they copy the value and retry
+// if a writer has been active in between. Writers are serialized
+// on the sequence number itself
+
+// The value is stored as relaxed atomic words, so a torn read
+// is a well-defined retry rather than a data race
+// (H.-J. Boehm, "Can Seqlocks Get Along With Programming Language Memory Models?")
+
+// Usage:
+// SeqLock<AllocatorMetrics> metrics;
+// metrics.Update([](AllocatorMetrics& m) { ++m.total_allocate; });
+// auto snapshot = metrics.Load();
+
+template <typename T>
+class SeqLock final {
+  static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type");
+
+  using Word = uint64_t;
+  static const size_t kWords = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+ public:
+  SeqLock() : SeqLock(T{}) {
+  }
+
+  explicit SeqLock(const T& value) {
+    StoreWords(value);
+  }
+
+  // Non-copyable
+  SeqLock(const SeqLock&) = delete;
+  SeqLock& operator=(const SeqLock&) = delete;
+
+  // ~ Public Interface
+
+  T Load() const {
+    detail::SpinWait spin_wait;
+    while (true) {
+      const auto before = sequence_.load(std::memory_order::acquire);
+      if ((before & 1) == 0) {
+        T value = LoadWords();
+        std::atomic_thread_fence(std::memory_order::acquire);
+        if (sequence_.load(std::memory_order::relaxed) == before) {
+          return value;
+        }
+      }
+      spin_wait();
+    }
+  }
+
+  void Store(const T& value) {
+    Update([&value](T& current) {
+      current = value;
+    });
+  }
+
+  // Read-modify-write under the writer lock
+  template <typename F>
+  void Update(F&& mutate) {
+    const auto sequence = LockWriter();
+    T value = LoadWords();
+    mutate(value);
+    StoreWords(value);
+    sequence_.store(sequence + 2, std::memory_order::release);
+  }
+
+ private:
+  // Returns the (even) sequence number observed before locking
+  uint64_t LockWriter() {
+    detail::SpinWait spin_wait;
+    auto sequence = sequence_.load(std::memory_order::relaxed);
+    while (true) {
+      if ((sequence & 1) == 0 &&
+          sequence_.compare_exchange_weak(sequence, sequence + 1, std::memory_order::acquire,
+                                          std::memory_order::relaxed)) {
+        // Odd sequence must be visible before any data store
+        std::atomic_thread_fence(std::memory_order::release);
+        return sequence;
+      }
+      spin_wait();
+      sequence = sequence_.load(std::memory_order::relaxed);
+    }
+  }
+
+  T LoadWords() const {
+    Word words[kWords];
+    for (size_t index = 0; index < kWords; ++index) {
+      words[index] = words_[index].load(std::memory_order::relaxed);
+    }
+    T value;
+    std::memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+  void StoreWords(const T& value) {
+    Word words[kWords] = {};
+    std::memcpy(words, &value, sizeof(T));
+    for (size_t index = 0; index < kWords; ++index) {
+      words_[index].store(words[index], std::memory_order::relaxed);
+    }
+  }
+
+ private:
+  std::atomic<uint64_t> sequence_ = 0;
+  std::atomic<Word> words_[kWords];
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <wheels/core/assert.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Counter split into cache-line padded slots
+// Each thread increments its own slot, reads sum up all of them
+
+// Increments never contend as long as there are no more threads than slots,
+// the price is an O(slots) read that is not a snapshot of a single instant
+
+namespace detail {
+
+// Threads are assigned to slots round-robin on first use
+inline size_t ThisThreadShard() {
+  static std::atomic<size_t> next_shard = 0;
+  thread_local const size_t shard = next_shard.fetch_add(1, std::memory_order::relaxed);
+  return shard;
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+class ShardedCounter final {
+  struct alignas(64) Shard {
+    std::atomic<int64_t> value = 0;
+  };
+
+ public:
+  explicit ShardedCounter(size_t shards = DefaultShardCount())
+      : shards_(new Shard[shards]), mask_(shards - 1) {
+    WHEELS_ASSERT(shards > 0 && (shards & mask_) == 0, "Shard count must be a power of two");
+  }
+
+  // Non-copyable
+  ShardedCounter(const ShardedCounter&) = delete;
+  ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+  // ~ Public Interface
+
+  void Add(int64_t delta = 1, std::memory_order order = std::memory_order::relaxed) {
+    shards_[detail::ThisThreadShard() & mask_].value.fetch_add(delta, order);
+  }
+
+  void Increment() {
+    Add(1);
+  }
+
+  void Decrement() {
+    Add(-1);
+  }
+
+  // Concurrent updates may or may not be counted
+  int64_t Sum(std::memory_order order = std::memory_order::relaxed) const {
+    int64_t sum = 0;
+    for (size_t index = 0; index <= mask_; ++index) {
+      sum += shards_[index].value.load(order);
+    }
+    return sum;
+  }
+
+  size_t ShardCount() const {
+    return mask_ + 1;
+  }
+
+  // Power of two not less than the number of hardware threads
+  static size_t DefaultShardCount() {
+    const size_t threads = std::thread::hardware_concurrency();
+    size_t shards = 1;
+    while (shards < threads) {
+      shards *= 2;
+    }
+    return shards;
+  }
+
+ private:
+  std::unique_ptr<Shard[]> shards_;
+  const size_t mask_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
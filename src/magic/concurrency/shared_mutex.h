@@ -0,0 +1,89 @@
+#pragma once
+
+#include <magic/concurrency/sharded_counter.h>
+#include <magic/concurrency/spinlock.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Reader-writer lock for read-mostly data
+// Readers announce themselves in per-thread slots (see ShardedCounter),
+// so concurrent readers do not bounce a shared cache line.
+// A writer raises a flag and waits until every slot drains
+
+// Writers are preferred: new readers back off while a writer is pending.
+// Meets SharedLockable, works with std::shared_lock / std::lock_guard
+
+class SharedMutex final {
+ public:
+  SharedMutex() = default;
+
+  // Non-copyable
+  SharedMutex(const SharedMutex&) = delete;
+  SharedMutex& operator=(const SharedMutex&) = delete;
+
+  // ~ Public Interface
+
+  void LockShared() {
+    while (true) {
+      readers_.Add(1, std::memory_order::seq_cst);
+      // Pairs with the store to writer_ in Lock
+      if (!writer_.load(std::memory_order::seq_cst)) {
+        return;
+      }
+      readers_.Add(-1, std::memory_order::release);
+      writer_.wait(true, std::memory_order::acquire);
+    }
+  }
+
+  void UnlockShared() {
+    readers_.Add(-1, std::memory_order::release);
+  }
+
+  void Lock() {
+    writers_.lock();
+    writer_.store(true, std::memory_order::seq_cst);
+
+    detail::SpinWait spin_wait;
+    while (readers_.Sum(std::memory_order::seq_cst) != 0) {
+      spin_wait();
+    }
+  }
+
+  void Unlock() {
+    writer_.store(false, std::memory_order::release);
+    writer_.notify_all();
+    writers_.unlock();
+  }
+
+  // SharedLockable
+
+  void lock() {
+    Lock();
+  }
+
+  void unlock() {
+    Unlock();
+  }
+
+  void lock_shared() {
+    LockShared();
+  }
+
+  void unlock_shared() {
+    UnlockShared();
+  }
+
+ private:
+  ShardedCounter readers_;
+  std::atomic<bool> writer_ = false;
+  std::mutex writers_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
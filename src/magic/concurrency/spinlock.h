@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <thread>
 
 namespace magic {
 
@@ -8,12 +9,6 @@ namespace magic {
 
 namespace detail {
 
-//inline uint64_t GetCpuCycleCount() {
-//  uint32_t hi, lo;
-//  __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
-//  return (static_cast<uint64_t>(hi) << 32) | lo;
-//}
-
 // Relax in favour of the CPU owning the lock
 
 // https://c9x.me/x86/html/file_module_x86_id_232.html
@@ -29,6 +24,27 @@ inline void SpinLockPause() {
 #endif
 }
 
+// Pauses for a bounded number of iterations, then yields the CPU:
+// a waiter on an oversubscribed machine must let the owner (or the next
+// in the queue) run instead of burning the rest of its time slice
+
+class SpinWait final {
+  static const size_t kYieldThreshold = 1024;
+
+ public:
+  void operator()() {
+    if (iterations_ < kYieldThreshold) {
+      ++iterations_;
+      SpinLockPause();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+ private:
+  size_t iterations_ = 0;
+};
+
 } // namespace detail
 
 //////////////////////////////////////////////////////////////////////
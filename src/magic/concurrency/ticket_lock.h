@@ -0,0 +1,59 @@
+#pragma once
+
+#include <magic/concurrency/spinlock.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Fair (FIFO) spinlock: threads take a ticket and wait for their turn
+// All waiters spin on the same cache line, so every release invalidates it
+// in each waiter's cache
+
+class TicketLock final {
+ public:
+  void Lock() {
+    const auto ticket = next_ticket_.fetch_add(1, std::memory_order::relaxed);
+    detail::SpinWait spin_wait;
+    while (owner_ticket_.load(std::memory_order::acquire) != ticket) {
+      spin_wait();
+    }
+  }
+
+  bool TryLock() {
+    auto owner = owner_ticket_.load(std::memory_order::relaxed);
+    return next_ticket_.compare_exchange_strong(owner, owner + 1, std::memory_order::acquire,
+                                                std::memory_order::relaxed);
+  }
+
+  void Unlock() {
+    // Only the owner writes owner_ticket_
+    const auto next = owner_ticket_.load(std::memory_order::relaxed) + 1;
+    owner_ticket_.store(next, std::memory_order::release);
+  }
+
+  // Lockable
+
+  void lock() {
+    Lock();
+  }
+
+  bool try_lock() {
+    return TryLock();
+  }
+
+  void unlock() {
+    Unlock();
+  }
+
+ private:
+  alignas(64) std::atomic<uint32_t> next_ticket_ = 0;
+  alignas(64) std::atomic<uint32_t> owner_ticket_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
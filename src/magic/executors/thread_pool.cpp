@@ -1,4 +1,5 @@
 #include <magic/executors/thread_pool.h>
+#include <magic/common/tsc_clock.h>
 #include <magic/concurrency/local/ptr.h>
 
 #include <wheels/core/assert.hpp>
@@ -19,7 +20,11 @@ ThreadPool* ThreadPool::Current() {
   return this_thread_pool;
 }
 
-ThreadPool::ThreadPool(size_t threads) {
+ThreadPool::ThreadPool(size_t threads)
+    : worker_count_(threads), metrics_(std::make_unique<WorkerMetrics[]>(threads)) {
+  // A pool constructed during static initialization calibrates here
+  // rather than in the first task
+  TscClock::IsReliable();
   StartWorkerThreads(threads);
 }
 
@@ -52,20 +57,47 @@ void ThreadPool::Stop() {
   workers_.clear();
 }
 
+ThreadPoolMetrics ThreadPool::GetMetrics() const {
+  ThreadPoolMetrics result;
+  uint64_t busy_ticks = 0;
+  for (size_t index = 0; index < worker_count_; ++index) {
+    result.CompletedTasks += metrics_[index].completed_tasks.load(std::memory_order::relaxed);
+    busy_ticks += metrics_[index].busy_ticks.load(std::memory_order::relaxed);
+  }
+  result.BusyTime = TscClock::TicksToDuration(busy_ticks);
+  return result;
+}
+
+void ThreadPool::RecordTaskTimes(Histogram* histogram) {
+  task_times_.store(histogram, std::memory_order::release);
+}
+
 //////////////////////////////////////////////////////////////////////
 
 void ThreadPool::StartWorkerThreads(size_t count) {
   for (size_t index = 0; index < count; ++index) {
-    workers_.emplace_back([this]() {
+    workers_.emplace_back([this, index]() {
       this_thread_pool.Exchange(this);
-      WorkerRoutine();
+      WorkerRoutine(metrics_[index]);
     });
   }
 }
 
-void ThreadPool::WorkerRoutine() {
+void ThreadPool::WorkerRoutine(WorkerMetrics& metrics) {
   while (auto task = tasks_.Take()) {
+    const uint64_t start = TscClock::Ticks();
     task->Run();
+    const uint64_t elapsed = TscClock::Ticks() - start;
+    if (auto task_times = task_times_.load(std::memory_order::acquire)) {
+      task_times->Record(TscClock::TicksToDuration(elapsed));
+    }
+
+    // The only writer: plain stores instead of locked read-modify-writes
+    // Published to WaitIdle by counter_.Done()
+    metrics.busy_ticks.store(metrics.busy_ticks.load(std::memory_order::relaxed) + elapsed,
+                             std::memory_order::relaxed);
+    metrics.completed_tasks.store(metrics.completed_tasks.load(std::memory_order::relaxed) + 1,
+                                  std::memory_order::relaxed);
     counter_.Done();
   }
 }
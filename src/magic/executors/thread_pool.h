@@ -2,9 +2,13 @@
 
 #include <magic/concurrency/intrusive/blocking_queue.h>
 #include <magic/concurrency/atomic_counter.h>
+#include <magic/common/histogram.h>
+#include <magic/common/time.h>
 #include <magic/executors/executor.h>
 #include <magic/executors/task.h>
 
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -12,13 +16,29 @@ namespace magic {
 
 //////////////////////////////////////////////////////////////////////
 
+struct ThreadPoolMetrics {
+  // Tasks run to completion by the workers
+  size_t CompletedTasks = 0;
+  // Time the workers spent running tasks, summed over the workers
+  Duration BusyTime{};
+};
+
+//////////////////////////////////////////////////////////////////////
+
 // Thread pool for independent CPU-bound tasks
 // Fixed pool of worker threads + shared unbounded blocking queue
+// Every task is timed with TscClock, a few ns per task
 
 class ThreadPool final : public IExecutor {
   using Queue = MPMCBlockingQueue<TaskNode>;
   using Workers = std::vector<std::thread>;
 
+  // Written by one worker only, on its own cache line
+  struct alignas(64) WorkerMetrics {
+    std::atomic<uint64_t> completed_tasks{0};
+    std::atomic<uint64_t> busy_ticks{0};
+  };
+
  public:
   explicit ThreadPool(size_t threads);
   ~ThreadPool();
@@ -42,16 +62,26 @@ class ThreadPool final : public IExecutor {
   // Locates the current thread pool from worker thread
   static ThreadPool* Current();
 
+  // Complete up to the last WaitIdle, approximate while tasks are running
+  ThreadPoolMetrics GetMetrics() const;
+
+  // Records the run time of every following task, nullptr stops recording
+  // The histogram must outlive the recording
+  void RecordTaskTimes(Histogram* histogram);
+
   //////////////////////////////////////////////////////////////////////
 
  private:
   void StartWorkerThreads(size_t workers);
-  void WorkerRoutine();
+  void WorkerRoutine(WorkerMetrics& metrics);
 
  private:
   AtomicCounter counter_;
   Queue tasks_;
   Workers workers_;
+  size_t worker_count_;
+  std::unique_ptr<WorkerMetrics[]> metrics_;
+  std::atomic<Histogram*> task_times_{nullptr};
 };
 
 //////////////////////////////////////////////////////////////////////
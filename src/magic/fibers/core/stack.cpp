@@ -1,8 +1,10 @@
 #include <magic/fibers/core/stack.h>
 #include <magic/fibers/core/metrics.h>
+#include <magic/concurrency/seqlock.h>
 
 #include <wheels/core/assert.hpp>
 
+#include <mutex>
 #include <vector>
 
 namespace magic {
@@ -18,26 +20,30 @@ class StackAllocator final {
   Stack Allocate() {
     std::lock_guard lock(mutex_);
 
-    ++metrics_.total_allocate;
+    const bool allocate_new = stack_pool_.empty();
+    metrics_.Update([allocate_new](AllocatorMetrics& metrics) {
+      ++metrics.total_allocate;
+      if (allocate_new) {
+        ++metrics.allocate_new_count;
+        metrics.total_allocate_bytes += 16 * 1024 * 4;
+      }
+    });
 
-    if (stack_pool_.empty()) {
-      ++metrics_.allocate_new_count;
-      metrics_.total_allocate_bytes += 16 * 1024 * 4;
-      return AllocateNew();
-    }
-
-    return TakeFromPool();
+    return allocate_new ? AllocateNew() : TakeFromPool();
   }
 
   void Release(Stack stack) {
     std::lock_guard lock(mutex_);
 
-    ++metrics_.release_count;
+    metrics_.Update([](AllocatorMetrics& metrics) {
+      ++metrics.release_count;
+    });
     stack_pool_.push_back(std::move(stack));
   }
 
-  AllocatorMetrics GetMetrics() {
-    return metrics_;
+  // Does not contend with Allocate / Release
+  AllocatorMetrics GetMetrics() const {
+    return metrics_.Load();
   }
 
  private:
@@ -56,7 +62,7 @@ class StackAllocator final {
  private:
   std::mutex mutex_;
   std::vector<Stack> stack_pool_;
-  AllocatorMetrics metrics_;
+  SeqLock<AllocatorMetrics> metrics_;
 };
 
 } // namespace detail
@@ -0,0 +1,503 @@
+#include <magic/filesystem/async_io.h>
+
+#include <magic/common/result/make.h>
+#include <magic/executors/execute.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/futures/await.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+struct AsyncIoOperation {
+  // IORING_OP_READ / IORING_OP_WRITE / IORING_OP_FSYNC, for both backends
+  int opcode;
+  int fd;
+  char* data;
+  size_t length;
+  uint64_t offset;
+
+  Promise<size_t> promise;
+  std::atomic<size_t>* in_flight;
+};
+
+// Result as returned by io_uring: bytes or -errno
+static void Complete(AsyncIoOperation* operation, int64_t result) {
+  // Before the promise: the continuation may observe InFlight
+  operation->in_flight->fetch_sub(1, std::memory_order::relaxed);
+  if (result >= 0) {
+    std::move(operation->promise).SetValue(static_cast<size_t>(result));
+  } else {
+    std::move(operation->promise).SetError(std::error_code(-result, std::system_category()));
+  }
+  delete operation;
+}
+
+static std::error_code LastError() {
+  return {errno, std::system_category()};
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using detail::AsyncIoOperation;
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring, unsigned to_submit, unsigned min_complete, unsigned flags) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_enter, ring, to_submit, min_complete, flags, nullptr, 0));
+}
+
+// IORING_OP_READ / WRITE and the probe itself appeared in Linux 5.6
+bool SupportsOperations(int ring) {
+  const size_t size = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+  std::vector<char> memory(size, 0);
+  auto probe = reinterpret_cast<io_uring_probe*>(memory.data());
+
+  if (::syscall(__NR_io_uring_register, ring, IORING_REGISTER_PROBE, probe, 256) < 0) {
+    return false;
+  }
+  for (int opcode : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_FSYNC}) {
+    if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+class IoUringBackend final : public detail::IAsyncIoBackend {
+  // user_data of the wakeup read, operations are never at address 0
+  static const uint64_t kWakeupTag = 0;
+
+ public:
+  explicit IoUringBackend(size_t queue_depth) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    ring_fd_ = IoUringSetup(queue_depth, &params);
+    WHEELS_VERIFY(ring_fd_ >= 0, "io_uring_setup failed");
+    MapRings(params);
+
+    wakeup_fd_ = ::eventfd(0, EFD_CLOEXEC);
+    WHEELS_VERIFY(wakeup_fd_ >= 0, "eventfd failed");
+
+    // Every completion has a slot, the wakeup read takes one
+    max_in_flight_ = std::min(sq_entries_, cq_entries_) - 1;
+
+    loop_ = std::thread([this] {
+      EventLoop();
+    });
+  }
+
+  // Waits for the operations in flight
+  ~IoUringBackend() override {
+    {
+      std::lock_guard guard(mutex_);
+      stop_ = true;
+    }
+    Wakeup();
+    loop_.join();
+
+    // Cancels the pending wakeup read
+    ::close(ring_fd_);
+    ::close(wakeup_fd_);
+    ::munmap(sqes_, sqes_size_);
+    if (cq_ring_ != sq_ring_) {
+      ::munmap(cq_ring_, cq_ring_size_);
+    }
+    ::munmap(sq_ring_, sq_ring_size_);
+  }
+
+  void Submit(AsyncIoOperation* operation) override {
+    bool idle;
+    {
+      std::lock_guard guard(mutex_);
+      idle = submitted_.empty();
+      submitted_.push_back(operation);
+    }
+    // The loop takes the whole batch on one wakeup
+    if (idle) {
+      Wakeup();
+    }
+  }
+
+ private:
+  void MapRings(const io_uring_params& params) {
+    sq_entries_ = params.sq_entries;
+    cq_entries_ = params.cq_entries;
+
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+
+    sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+    cq_ring_ = single_mmap ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(Map(sqes_size_, IORING_OFF_SQES));
+
+    sq_head_ = At<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_ = At<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_mask_ = *At<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_array_ = At<unsigned>(sq_ring_, params.sq_off.array);
+
+    cq_head_ = At<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_ = At<unsigned>(cq_ring_, params.cq_off.tail);
+    cq_mask_ = *At<unsigned>(cq_ring_, params.cq_off.ring_mask);
+    cqes_ = At<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+  }
+
+  void* Map(size_t size, off_t offset) {
+    void* memory =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    WHEELS_VERIFY(memory != MAP_FAILED, "Failed to map io_uring rings");
+    return memory;
+  }
+
+  template <typename T>
+  static T* At(void* base, size_t offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+  }
+
+  void Wakeup() {
+    uint64_t one = 1;
+    ::write(wakeup_fd_, &one, sizeof(one));
+  }
+
+  // Event loop thread
+
+  void EventLoop() {
+    PushWakeupRead();
+    unsigned to_submit = 1;
+
+    while (true) {
+      bool stop;
+      {
+        std::lock_guard guard(mutex_);
+        for (auto operation : submitted_) {
+          backlog_.push_back(operation);
+        }
+        submitted_.clear();
+        stop = stop_;
+      }
+
+      if (stop && backlog_.empty() && in_flight_ == 0) {
+        break;
+      }
+
+      while (!backlog_.empty() && in_flight_ < max_in_flight_) {
+        PushOperation(backlog_.front());
+        backlog_.pop_front();
+        ++in_flight_;
+        ++to_submit;
+      }
+
+      const int submitted = IoUringEnter(ring_fd_, to_submit, 1, IORING_ENTER_GETEVENTS);
+      if (submitted >= 0) {
+        to_submit -= submitted;
+      } else {
+        // EINTR, EAGAIN or EBUSY: reap completions and retry the rest
+        WHEELS_VERIFY(errno == EINTR || errno == EAGAIN || errno == EBUSY,
+                      "io_uring_enter failed");
+      }
+
+      to_submit += ReapCompletions();
+    }
+  }
+
+  io_uring_sqe* NextSqe() {
+    const unsigned tail = *sq_tail_;
+    WHEELS_ASSERT(tail - std::atomic_ref(*sq_head_).load(std::memory_order::acquire) < sq_entries_,
+                  "Submission queue overflow");
+    const unsigned index = tail & sq_mask_;
+    auto sqe = &sqes_[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array_[index] = index;
+    return sqe;
+  }
+
+  void CommitSqe() {
+    std::atomic_ref(*sq_tail_).store(*sq_tail_ + 1, std::memory_order::release);
+  }
+
+  void PushWakeupRead() {
+    auto sqe = NextSqe();
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = wakeup_fd_;
+    sqe->addr = reinterpret_cast<uint64_t>(&wakeup_buffer_);
+    sqe->len = sizeof(wakeup_buffer_);
+    sqe->off = 0;
+    sqe->user_data = kWakeupTag;
+    CommitSqe();
+  }
+
+  void PushOperation(AsyncIoOperation* operation) {
+    auto sqe = NextSqe();
+    sqe->opcode = operation->opcode;
+    sqe->fd = operation->fd;
+    if (operation->opcode == IORING_OP_FSYNC) {
+      sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+    } else {
+      sqe->addr = reinterpret_cast<uint64_t>(operation->data);
+      sqe->len = operation->length;
+      sqe->off = operation->offset;
+    }
+    sqe->user_data = reinterpret_cast<uint64_t>(operation);
+    CommitSqe();
+  }
+
+  // Returns the number of new submission queue entries (re-armed wakeups)
+  unsigned ReapCompletions() {
+    unsigned rearmed = 0;
+    unsigned head = *cq_head_;
+    const unsigned tail = std::atomic_ref(*cq_tail_).load(std::memory_order::acquire);
+
+    for (; head != tail; ++head) {
+      const auto& cqe = cqes_[head & cq_mask_];
+      if (cqe.user_data == kWakeupTag) {
+        PushWakeupRead();
+        ++rearmed;
+      } else {
+        --in_flight_;
+        detail::Complete(reinterpret_cast<AsyncIoOperation*>(cqe.user_data), cqe.res);
+      }
+    }
+
+    std::atomic_ref(*cq_head_).store(head, std::memory_order::release);
+    return rearmed;
+  }
+
+ private:
+  int ring_fd_;
+  int wakeup_fd_;
+
+  void* sq_ring_;
+  void* cq_ring_;
+  io_uring_sqe* sqes_;
+  size_t sq_ring_size_;
+  size_t cq_ring_size_;
+  size_t sqes_size_;
+
+  unsigned sq_entries_;
+  unsigned cq_entries_;
+  unsigned* sq_head_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  io_uring_cqe* cqes_;
+
+  std::mutex mutex_;
+  std::vector<AsyncIoOperation*> submitted_;  // Guarded by mutex_
+  bool stop_ = false;                         // Guarded by mutex_
+
+  // Owned by the event loop thread
+  std::deque<AsyncIoOperation*> backlog_;
+  size_t in_flight_ = 0;
+  size_t max_in_flight_;
+  uint64_t wakeup_buffer_ = 0;
+
+  std::thread loop_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class ThreadPoolBackend final : public detail::IAsyncIoBackend {
+ public:
+  explicit ThreadPoolBackend(size_t threads) : pool_(threads) {
+  }
+
+  ~ThreadPoolBackend() override {
+    pool_.WaitIdle();
+    pool_.Stop();
+  }
+
+  void Submit(AsyncIoOperation* operation) override {
+    Execute(pool_, [operation] {
+      detail::Complete(operation, Perform(*operation));
+    });
+  }
+
+ private:
+  static int64_t Perform(const AsyncIoOperation& operation) {
+    ssize_t result;
+    do {
+      switch (operation.opcode) {
+        case IORING_OP_READ:
+          result = ::pread(operation.fd, operation.data, operation.length, operation.offset);
+          break;
+        case IORING_OP_WRITE:
+          result = ::pwrite(operation.fd, operation.data, operation.length, operation.offset);
+          break;
+        default:
+          result = ::fdatasync(operation.fd);
+          break;
+      }
+    } while (result < 0 && errno == EINTR);
+    return result >= 0 ? result : -errno;
+  }
+
+ private:
+  ThreadPool pool_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Blocking I/O threads of the fallback, enough to keep a disk queue busy
+const size_t kFallbackThreads = 16;
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+AsyncIo::AsyncIo(Backend backend, size_t queue_depth) : backend_(backend) {
+  if (backend == Backend::IoUring) {
+    impl_ = std::make_unique<IoUringBackend>(queue_depth);
+  } else {
+    impl_ = std::make_unique<ThreadPoolBackend>(kFallbackThreads);
+  }
+}
+
+AsyncIo::~AsyncIo() {
+  impl_.reset();
+}
+
+AsyncIo& AsyncIo::Instance() {
+  static AsyncIo io;
+  return io;
+}
+
+AsyncIo::Backend AsyncIo::DefaultBackend() {
+  static const Backend backend = [] {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    const int ring = IoUringSetup(1, &params);
+    if (ring < 0) {
+      return Backend::ThreadPool;
+    }
+    const bool supported = SupportsOperations(ring);
+    ::close(ring);
+    return supported ? Backend::IoUring : Backend::ThreadPool;
+  }();
+  return backend;
+}
+
+Future<size_t> AsyncIo::Read(int fd, std::span<char> buffer, uint64_t offset) {
+  return Submit(IORING_OP_READ, fd, buffer.data(), buffer.size(), offset);
+}
+
+Future<size_t> AsyncIo::Write(int fd, std::span<const char> buffer, uint64_t offset) {
+  // Never written through
+  return Submit(IORING_OP_WRITE, fd, const_cast<char*>(buffer.data()), buffer.size(), offset);
+}
+
+Future<size_t> AsyncIo::Sync(int fd) {
+  return Submit(IORING_OP_FSYNC, fd, nullptr, 0, 0);
+}
+
+Future<size_t> AsyncIo::Submit(int opcode, int fd, char* data, size_t length, uint64_t offset) {
+  auto [f, p] = MakeContract<size_t>();
+
+  in_flight_.fetch_add(1, std::memory_order::relaxed);
+  impl_->Submit(new AsyncIoOperation{opcode, fd, data, length, offset, std::move(p), &in_flight_});
+
+  return std::move(f);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+int ToFlags(AsyncFile::Mode mode) {
+  switch (mode) {
+    case AsyncFile::Mode::ReadWrite:
+      return O_RDWR | O_CREAT;
+    case AsyncFile::Mode::Create:
+      return O_RDWR | O_CREAT | O_TRUNC;
+    default:
+      return O_RDONLY;
+  }
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+Result<AsyncFile> AsyncFile::Open(std::string_view path, Mode mode, AsyncIo& io) {
+  const int fd = ::open(std::string(path).c_str(), ToFlags(mode) | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    return Fail(detail::LastError());
+  }
+  return Ok(AsyncFile{io, fd});
+}
+
+AsyncFile::~AsyncFile() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+Future<size_t> AsyncFile::ReadAtAsync(uint64_t offset, std::span<char> buffer) {
+  return io_->Read(fd_, buffer, offset);
+}
+
+Future<size_t> AsyncFile::WriteAtAsync(uint64_t offset, std::span<const char> buffer) {
+  return io_->Write(fd_, buffer, offset);
+}
+
+Future<size_t> AsyncFile::SyncAsync() {
+  return io_->Sync(fd_);
+}
+
+Result<size_t> AsyncFile::ReadAt(uint64_t offset, std::span<char> buffer) {
+  return AwaitResult(ReadAtAsync(offset, buffer));
+}
+
+Result<size_t> AsyncFile::WriteAt(uint64_t offset, std::span<const char> buffer) {
+  return AwaitResult(WriteAtAsync(offset, buffer));
+}
+
+Status AsyncFile::Sync() {
+  auto result = AwaitResult(SyncAsync());
+  if (result.HasError()) {
+    return Fail(result.Error());
+  }
+  return Ok();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <magic/common/result.h>
+#include <magic/futures/core/future.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+struct AsyncIoOperation;
+
+struct IAsyncIoBackend {
+  virtual ~IAsyncIoBackend() = default;
+
+  // Takes ownership of the operation
+  virtual void Submit(AsyncIoOperation* operation) = 0;
+};
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Asynchronous positional file I/O
+
+// io_uring backend: callers enqueue operations and kick a dedicated thread
+// through an eventfd read that sits in the ring itself, the thread fills
+// the submission queue with everything queued so far and submits the batch
+// with the same io_uring_enter call that waits for completions
+
+// ThreadPool backend: blocking pread / pwrite / fdatasync on a pool of
+// I/O threads, used where io_uring is unavailable (old kernels, seccomp)
+
+// Futures complete on the backend thread, attach continuations with Via
+// Buffers must stay alive until the future completes
+
+class AsyncIo final {
+ public:
+  enum class Backend { IoUring, ThreadPool };
+
+  explicit AsyncIo(Backend backend = DefaultBackend(), size_t queue_depth = 256);
+  ~AsyncIo();
+
+  // Non-copyable
+  AsyncIo(const AsyncIo&) = delete;
+  AsyncIo& operator=(const AsyncIo&) = delete;
+
+  // ~ Public Interface
+
+  // Process-wide engine, started on first use
+  static AsyncIo& Instance();
+
+  // IoUring if the kernel allows to set up a ring with the required operations
+  static Backend DefaultBackend();
+
+  Backend GetBackend() const {
+    return backend_;
+  }
+
+  // Bytes read, short at the end of the file
+  Future<size_t> Read(int fd, std::span<char> buffer, uint64_t offset);
+
+  // Bytes written
+  Future<size_t> Write(int fd, std::span<const char> buffer, uint64_t offset);
+
+  // fdatasync, completes with 0
+  Future<size_t> Sync(int fd);
+
+  // Operations submitted but not completed yet
+  size_t InFlight() const {
+    return in_flight_.load(std::memory_order::relaxed);
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  Future<size_t> Submit(int opcode, int fd, char* data, size_t length, uint64_t offset);
+
+ private:
+  const Backend backend_;
+  std::atomic<size_t> in_flight_ = 0;
+  std::unique_ptr<detail::IAsyncIoBackend> impl_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// File opened for AsyncIo
+// *Async methods return futures, the others suspend the calling fiber
+// or block the calling thread outside of fibers
+
+// Usage:
+// auto file = AsyncFile::Open("data.bin").ValueOrThrow();
+// char buffer[4096];
+// auto bytes = file.ReadAt(0, buffer).ValueOrThrow();
+
+class AsyncFile final {
+ public:
+  enum class Mode {
+    Read,
+    ReadWrite,  // Created if missing
+    Create,     // Created or truncated
+  };
+
+  static Result<AsyncFile> Open(std::string_view path, Mode mode = Mode::Read,
+                                AsyncIo& io = AsyncIo::Instance());
+
+  ~AsyncFile();
+
+  // Non-copyable
+  AsyncFile(const AsyncFile&) = delete;
+  AsyncFile& operator=(const AsyncFile&) = delete;
+
+  // Movable
+  AsyncFile(AsyncFile&& that) : io_(that.io_), fd_(std::exchange(that.fd_, -1)) {
+  }
+
+  AsyncFile& operator=(AsyncFile&& that) {
+    std::swap(io_, that.io_);
+    std::swap(fd_, that.fd_);
+    return *this;
+  }
+
+  // ~ Public Interface
+
+  Future<size_t> ReadAtAsync(uint64_t offset, std::span<char> buffer);
+  Future<size_t> WriteAtAsync(uint64_t offset, std::span<const char> buffer);
+  Future<size_t> SyncAsync();
+
+  Result<size_t> ReadAt(uint64_t offset, std::span<char> buffer);
+  Result<size_t> WriteAt(uint64_t offset, std::span<const char> buffer);
+  Status Sync();
+
+  int Fd() const {
+    return fd_;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  AsyncFile(AsyncIo& io, int fd) : io_(&io), fd_(fd) {
+  }
+
+ private:
+  AsyncIo* io_;
+  int fd_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,281 @@
+#include <magic/filesystem/buffered_writer.h>
+#include <magic/common/result/make.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Alignment of buffers, offsets and lengths for O_DIRECT
+const size_t kDirectBlock = 4096;
+
+std::error_code LastError() {
+  return {errno, std::system_category()};
+}
+
+size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+// Writes every byte, retries partial writes and interruptions
+Status WriteFully(int fd, iovec* vectors, int count) {
+  while (count > 0) {
+    const ssize_t written = ::writev(fd, vectors, count);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Fail(LastError());
+    }
+
+    size_t remaining = written;
+    while (count > 0 && remaining >= vectors->iov_len) {
+      remaining -= vectors->iov_len;
+      ++vectors;
+      --count;
+    }
+    if (count > 0) {
+      vectors->iov_base = static_cast<char*>(vectors->iov_base) + remaining;
+      vectors->iov_len -= remaining;
+    }
+  }
+  return Ok();
+}
+
+Status PWriteFully(int fd, const char* data, size_t length, uint64_t offset) {
+  while (length > 0) {
+    const ssize_t written = ::pwrite(fd, data, length, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return Fail(LastError());
+    }
+    data += written;
+    length -= written;
+    offset += written;
+  }
+  return Ok();
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+Result<BufferedWriter> BufferedWriter::Open(std::string_view path, BufferedWriterOptions options) {
+  if (options.Direct && options.Append) {
+    return Fail(std::make_error_code(std::errc::invalid_argument));
+  }
+
+  int flags = O_WRONLY | O_CREAT | O_CLOEXEC;
+  flags |= options.Append ? O_APPEND : O_TRUNC;
+  if (options.Direct) {
+    flags |= O_DIRECT;
+  }
+
+  const int fd = ::open(std::string(path).c_str(), flags, 0644);
+  if (fd < 0) {
+    return Fail(LastError());
+  }
+
+  uint64_t offset = 0;
+  if (options.Append) {
+    struct stat stat;
+    if (::fstat(fd, &stat) != 0) {
+      auto error = LastError();
+      ::close(fd);
+      return Fail(error);
+    }
+    offset = stat.st_size;
+  }
+
+  if (options.Preallocate > 0) {
+    // Only a hint, EOPNOTSUPP on some filesystems
+    ::fallocate(fd, FALLOC_FL_KEEP_SIZE, offset, options.Preallocate);
+  }
+
+  return Ok(BufferedWriter{fd, options, offset});
+}
+
+BufferedWriter::BufferedWriter(int fd, BufferedWriterOptions options, uint64_t offset)
+    : fd_(fd), options_(options), offset_(offset) {
+  options_.BufferSize = std::max<size_t>(options_.BufferSize, 1);
+  if (options_.Direct) {
+    options_.BufferSize = AlignUp(options_.BufferSize, kDirectBlock);
+    buffer_ = {static_cast<char*>(std::aligned_alloc(kDirectBlock, options_.BufferSize)),
+               std::free};
+  } else {
+    buffer_ = {static_cast<char*>(std::malloc(options_.BufferSize)), std::free};
+  }
+}
+
+BufferedWriter::~BufferedWriter() {
+  if (fd_ >= 0) {
+    Close().Ignore();
+  }
+}
+
+BufferedWriter::BufferedWriter(BufferedWriter&& that)
+    : fd_(std::exchange(that.fd_, -1)),
+      options_(that.options_),
+      buffer_(std::move(that.buffer_)),
+      buffered_(std::exchange(that.buffered_, 0)),
+      written_(that.written_),
+      offset_(that.offset_) {
+}
+
+BufferedWriter& BufferedWriter::operator=(BufferedWriter&& that) {
+  std::swap(fd_, that.fd_);
+  std::swap(options_, that.options_);
+  std::swap(buffer_, that.buffer_);
+  std::swap(buffered_, that.buffered_);
+  std::swap(written_, that.written_);
+  std::swap(offset_, that.offset_);
+  return *this;
+}
+
+Status BufferedWriter::Write(std::string_view data) {
+  written_ += data.size();
+  if (options_.Direct) {
+    return WriteDirect(data);
+  }
+
+  const size_t capacity = options_.BufferSize;
+  if (buffered_ + data.size() < capacity) {
+    std::memcpy(buffer_.get() + buffered_, data.data(), data.size());
+    buffered_ += data.size();
+    return Ok();
+  }
+
+  if (data.size() >= capacity) {
+    // Buffered bytes and the data in one syscall, no copy
+    iovec vectors[2] = {{buffer_.get(), buffered_},
+                        {const_cast<char*>(data.data()), data.size()}};
+    buffered_ = 0;
+    return WriteFully(fd_, vectors, 2);
+  }
+
+  // Top up the buffer, write it out as a whole and keep the rest
+  const size_t head = capacity - buffered_;
+  std::memcpy(buffer_.get() + buffered_, data.data(), head);
+  buffered_ = capacity;
+  if (auto status = Flush(); status.HasError()) {
+    return status;
+  }
+  std::memcpy(buffer_.get(), data.data() + head, data.size() - head);
+  buffered_ = data.size() - head;
+  return Ok();
+}
+
+Status BufferedWriter::WriteLine(std::string_view line) {
+  if (!options_.Direct && buffered_ + line.size() + 1 < options_.BufferSize) {
+    // Fast path: both pieces fit
+    std::memcpy(buffer_.get() + buffered_, line.data(), line.size());
+    buffer_.get()[buffered_ + line.size()] = '\n';
+    buffered_ += line.size() + 1;
+    written_ += line.size() + 1;
+    return Ok();
+  }
+  if (auto status = Write(line); status.HasError()) {
+    return status;
+  }
+  return Write("\n");
+}
+
+Status BufferedWriter::Flush() {
+  if (options_.Direct) {
+    return FlushDirect(/*tail=*/false);
+  }
+  if (buffered_ == 0) {
+    return Ok();
+  }
+  iovec vector = {buffer_.get(), buffered_};
+  buffered_ = 0;
+  return WriteFully(fd_, &vector, 1);
+}
+
+Status BufferedWriter::Sync() {
+  auto status = options_.Direct ? FlushDirect(/*tail=*/true) : Flush();
+  if (status.HasError()) {
+    return status;
+  }
+  if (::fdatasync(fd_) != 0) {
+    return Fail(LastError());
+  }
+  return Ok();
+}
+
+Status BufferedWriter::Close() {
+  if (fd_ < 0) {
+    return Ok();
+  }
+  auto status = options_.Direct ? FlushDirect(/*tail=*/true) : Flush();
+  if (::close(std::exchange(fd_, -1)) != 0 && !status.HasError()) {
+    return Fail(LastError());
+  }
+  return status;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Status BufferedWriter::WriteDirect(std::string_view data) {
+  // Every write goes through the aligned buffer
+  while (!data.empty()) {
+    const size_t chunk = std::min(data.size(), options_.BufferSize - buffered_);
+    std::memcpy(buffer_.get() + buffered_, data.data(), chunk);
+    buffered_ += chunk;
+    data.remove_prefix(chunk);
+
+    if (buffered_ == options_.BufferSize) {
+      if (auto status = FlushDirect(/*tail=*/false); status.HasError()) {
+        return status;
+      }
+    }
+  }
+  return Ok();
+}
+
+// Writes the whole blocks, the partial block stays at the front of the buffer
+// With tail = true the partial block is also written padded with zeros and
+// the file is truncated to the logical size, a later flush rewrites that block
+Status BufferedWriter::FlushDirect(bool tail) {
+  const size_t whole = buffered_ / kDirectBlock * kDirectBlock;
+  const size_t rest = buffered_ - whole;
+
+  if (whole > 0) {
+    if (auto status = PWriteFully(fd_, buffer_.get(), whole, offset_); status.HasError()) {
+      return status;
+    }
+    offset_ += whole;
+    std::memmove(buffer_.get(), buffer_.get() + whole, rest);
+    buffered_ = rest;
+  }
+
+  if (tail && rest > 0) {
+    std::memset(buffer_.get() + rest, 0, kDirectBlock - rest);
+    if (auto status = PWriteFully(fd_, buffer_.get(), kDirectBlock, offset_); status.HasError()) {
+      return status;
+    }
+    if (::ftruncate(fd_, offset_ + rest) != 0) {
+      return Fail(LastError());
+    }
+  }
+  return Ok();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <magic/common/result.h>
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct BufferedWriterOptions {
+  size_t BufferSize = 1 << 20;
+  // Appends to the existing content instead of truncating the file
+  bool Append = false;
+  // Bypasses the page cache: the buffer is block-aligned and only whole
+  // blocks are written, the padded tail is truncated away on Close
+  // Not every filesystem supports it, incompatible with Append
+  bool Direct = false;
+  // Reserves disk space up front (fallocate, the file size is kept),
+  // ignored where unsupported
+  size_t Preallocate = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Sequential file writer with a large user-space buffer
+// Data is copied into the buffer and written with one write(2) per full
+// buffer, writes larger than the buffer go straight to the file together
+// with the buffered bytes in a single writev(2)
+
+// Not thread-safe
+
+// Usage:
+// auto writer = BufferedWriter::Open("out.txt").ValueOrThrow();
+// writer.WriteLine("first").ThrowIfError();
+// writer.Close().ThrowIfError();
+
+class BufferedWriter final {
+ public:
+  static Result<BufferedWriter> Open(std::string_view path, BufferedWriterOptions options = {});
+
+  // Closes the file, errors are lost: call Close to observe them
+  ~BufferedWriter();
+
+  // Non-copyable
+  BufferedWriter(const BufferedWriter&) = delete;
+  BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+  // Movable
+  BufferedWriter(BufferedWriter&& that);
+  BufferedWriter& operator=(BufferedWriter&& that);
+
+  // ~ Public Interface
+
+  Status Write(std::string_view data);
+
+  // Writes the line followed by '\n'
+  Status WriteLine(std::string_view line);
+
+  // Hands the buffered bytes to the kernel
+  // In direct mode the last partial block stays in the buffer
+  Status Flush();
+
+  // Flush + fdatasync, in direct mode the partial block is written too
+  Status Sync();
+
+  // Flushes everything and closes the file, the writer is unusable afterwards
+  Status Close();
+
+  // Bytes accepted by Write, buffered ones included
+  uint64_t BytesWritten() const {
+    return written_;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  BufferedWriter(int fd, BufferedWriterOptions options, uint64_t offset);
+
+  Status WriteDirect(std::string_view data);
+  Status FlushDirect(bool tail);
+
+ private:
+  int fd_ = -1;
+  BufferedWriterOptions options_;
+
+  std::unique_ptr<char, void (*)(void*)> buffer_{nullptr, nullptr};
+  size_t buffered_ = 0;
+
+  uint64_t written_ = 0;
+  // Direct mode: file offset of the first buffered byte
+  uint64_t offset_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -1,14 +1,63 @@
 #include <magic/filesystem/file.h>
+#include <magic/filesystem/buffered_writer.h>
 #include <magic/common/result/make.h>
 
+#include <fmt/core.h>
+
+#include <atomic>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace magic {
 
+namespace {
+
+Status SyncDirectory(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    return Fail(std::error_code(errno, std::system_category()));
+  }
+  const int result = ::fsync(fd);
+  const auto error = std::error_code(errno, std::system_category());
+  ::close(fd);
+  if (result != 0) {
+    return Fail(error);
+  }
+  return Ok();
+}
+
+// Creates the temporary file with the mode and owner of the file it replaces,
+// before any data lands in it
+Status CreateTempLike(const std::filesystem::path& temp, const struct stat& target) {
+  const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd < 0) {
+    return Fail(std::error_code(errno, std::system_category()));
+  }
+  // Owner first, chown clears the set-user-ID bits
+  if (::fchown(fd, target.st_uid, target.st_gid) != 0) {
+    // Only a privileged caller may give the file away, the mode is kept regardless
+  }
+  const int result = ::fchmod(fd, target.st_mode & 07777);
+  const auto error = std::error_code(errno, std::system_category());
+  ::close(fd);
+  if (result != 0) {
+    return Fail(error);
+  }
+  return Ok();
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
 Result<File::TextLines> File::ReadAllLines(std::string_view path) {
   auto result = TextLines();
-  auto file = std::ifstream(path);
+  auto file = std::ifstream(std::string(path));
 
   if (file.fail()) {
     return Fail(std::make_error_code(std::errc::invalid_argument));
@@ -23,26 +72,78 @@ Result<File::TextLines> File::ReadAllLines(std::string_view path) {
 }
 
 Status File::WriteAllText(std::string_view path, std::string_view text) {
-  auto file = std::ofstream(path);
-  if (file.fail()) {
-    return Fail(std::make_error_code(std::errc::invalid_argument));
+  // A single write, no buffer needed
+  auto writer = BufferedWriter::Open(path, {.BufferSize = 1});
+  if (writer.HasError()) {
+    return Fail(writer.Error());
   }
-  file << text;
+  if (auto status = writer->Write(text); status.HasError()) {
+    return status;
+  }
+  return writer->Close();
+}
 
-  return Ok();
+Status File::WriteAllTextAtomic(std::string_view path, std::string_view text) {
+  static std::atomic<uint64_t> next_temp = 0;
+
+  const auto target = std::filesystem::path(path);
+  auto temp = target;
+  temp += fmt::format(".tmp.{}.{}", ::getpid(), next_temp.fetch_add(1));
+
+  auto status = [&]() -> Status {
+    struct stat existing;
+    if (::stat(target.c_str(), &existing) == 0) {
+      if (auto created = CreateTempLike(temp, existing); created.HasError()) {
+        return created;
+      }
+    }
+    auto writer = BufferedWriter::Open(temp.native(), {.BufferSize = 1});
+    if (writer.HasError()) {
+      return Fail(writer.Error());
+    }
+    if (auto written = writer->Write(text); written.HasError()) {
+      return written;
+    }
+    if (auto synced = writer->Sync(); synced.HasError()) {
+      return synced;
+    }
+    return writer->Close();
+  }();
+
+  if (status.IsOk() && ::rename(temp.c_str(), target.c_str()) != 0) {
+    status = Fail(std::error_code(errno, std::system_category()));
+  }
+  if (status.HasError()) {
+    ::unlink(temp.c_str());
+    return status;
+  }
+
+  // The rename itself is durable once the directory entry is
+  return SyncDirectory(target.has_parent_path() ? target.parent_path().native() : ".");
+}
+
+Status File::AppendAllText(std::string_view path, std::string_view text) {
+  auto writer = BufferedWriter::Open(path, {.BufferSize = 1, .Append = true});
+  if (writer.HasError()) {
+    return Fail(writer.Error());
+  }
+  if (auto status = writer->Write(text); status.HasError()) {
+    return status;
+  }
+  return writer->Close();
 }
 
 Status File::WriteAllLines(std::string_view path, const File::TextLines& lines) {
-  auto file = std::ofstream(path);
-  if (file.fail()) {
-    return Fail(std::make_error_code(std::errc::invalid_argument));
+  auto writer = BufferedWriter::Open(path);
+  if (writer.HasError()) {
+    return Fail(writer.Error());
   }
   for (auto&& line : lines) {
-    file << line << "\n";
+    if (auto status = writer->WriteLine(line); status.HasError()) {
+      return status;
+    }
   }
-
-  return Ok();
+  return writer->Close();
 }
 
-
 }  // namespace magic
\ No newline at end of file
@@ -21,6 +21,18 @@ struct File {
   // If the target file already exists, it is overwritten
   static Status WriteAllText(std::string_view path, std::string_view text);
 
+  // Crash-safe replacement: readers and a crash in the middle observe either
+  // the old content or the new one, never a torn file
+  // Writes a temporary file next to the target, syncs it, renames it over
+  // the target and syncs the directory, so the new content is durable on success
+  // An existing target keeps its permissions, and its owner where the caller may set it
+  static Status WriteAllTextAtomic(std::string_view path, std::string_view text);
+
+  // Appends the string to the file, creates the file if it does not exist
+  static Status AppendAllText(std::string_view path, std::string_view text);
+
+  // Creates a new file, writes every line followed by '\n', and then closes the file
+  // If the target file already exists, it is overwritten
   static Status WriteAllLines(std::string_view path, const TextLines& lines);
 
 };
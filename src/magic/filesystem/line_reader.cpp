@@ -0,0 +1,243 @@
+#include <magic/filesystem/line_reader.h>
+
+#include <magic/common/result/make.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+std::error_code LastError() {
+  return {errno, std::system_category()};
+}
+
+Result<int> OpenForReading(std::string_view path) {
+  const int fd = ::open(std::string(path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return Fail(LastError());
+  }
+  // Doubles the read-ahead window on Linux
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  return Ok(fd);
+}
+
+// read(2) retried on interruption, 0 at the end of the file
+ssize_t ReadSome(int fd, char* data, size_t length) {
+  while (true) {
+    const ssize_t bytes = ::read(fd, data, length);
+    if (bytes >= 0 || errno != EINTR) {
+      return bytes;
+    }
+  }
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+Result<LineReader> LineReader::Open(std::string_view path, size_t buffer_size) {
+  auto fd = OpenForReading(path);
+  if (fd.HasError()) {
+    return Fail(fd.Error());
+  }
+  return Ok(LineReader{*fd, buffer_size});
+}
+
+LineReader::LineReader(int fd, size_t buffer_size)
+    : fd_(fd), buffer_(std::max<size_t>(buffer_size, 1)) {
+}
+
+LineReader::~LineReader() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+LineReader::LineReader(LineReader&& that)
+    : fd_(std::exchange(that.fd_, -1)),
+      buffer_(std::move(that.buffer_)),
+      begin_(that.begin_),
+      scanned_(that.scanned_),
+      end_(that.end_),
+      eof_(that.eof_),
+      error_(that.error_) {
+}
+
+LineReader& LineReader::operator=(LineReader&& that) {
+  std::swap(fd_, that.fd_);
+  std::swap(buffer_, that.buffer_);
+  std::swap(begin_, that.begin_);
+  std::swap(scanned_, that.scanned_);
+  std::swap(end_, that.end_);
+  std::swap(eof_, that.eof_);
+  std::swap(error_, that.error_);
+  return *this;
+}
+
+std::optional<std::string_view> LineReader::ReadLine() {
+  while (true) {
+    const char* data = buffer_.data();
+    auto newline = static_cast<const char*>(std::memchr(data + scanned_, '\n', end_ - scanned_));
+    if (newline != nullptr) {
+      std::string_view line{data + begin_, static_cast<size_t>(newline - data) - begin_};
+      begin_ = scanned_ = newline - data + 1;
+      return line;
+    }
+    scanned_ = end_;
+
+    if (!Refill()) {
+      break;
+    }
+  }
+
+  if (begin_ == end_) {
+    return std::nullopt;
+  }
+  // The last line without a trailing newline
+  std::string_view line{buffer_.data() + begin_, end_ - begin_};
+  begin_ = scanned_ = end_;
+  return line;
+}
+
+Status LineReader::GetStatus() const {
+  if (error_) {
+    return Fail(error_);
+  }
+  return Ok();
+}
+
+bool LineReader::Refill() {
+  if (eof_ || error_) {
+    return false;
+  }
+
+  // Compact: the partial line moves to the front of the buffer
+  const size_t pending = end_ - begin_;
+  if (begin_ > 0) {
+    std::memmove(buffer_.data(), buffer_.data() + begin_, pending);
+    scanned_ -= begin_;
+    begin_ = 0;
+    end_ = pending;
+  }
+  if (end_ == buffer_.size()) {
+    // The line does not fit
+    buffer_.resize(buffer_.size() * 2);
+  }
+
+  const ssize_t bytes = ReadSome(fd_, buffer_.data() + end_, buffer_.size() - end_);
+  if (bytes < 0) {
+    error_ = LastError();
+    return false;
+  }
+  if (bytes == 0) {
+    eof_ = true;
+    return false;
+  }
+  end_ += bytes;
+  return true;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Result<std::unique_ptr<LineStream>> LineStream::Open(std::string_view path, size_t block_size,
+                                                     size_t queue_depth) {
+  auto fd = OpenForReading(path);
+  if (fd.HasError()) {
+    return Fail(fd.Error());
+  }
+  return Ok(std::unique_ptr<LineStream>(new LineStream(*fd, block_size, queue_depth)));
+}
+
+LineStream::LineStream(int fd, size_t block_size, size_t queue_depth) : blocks_(queue_depth) {
+  reader_ = std::thread([this, fd, block_size] {
+    ReadAhead(fd, std::max<size_t>(block_size, 1));
+    ::close(fd);
+  });
+}
+
+LineStream::~LineStream() {
+  blocks_.Cancel();
+  reader_.join();
+}
+
+std::optional<std::string_view> LineStream::ReadLine() {
+  while (position_ == block_.size()) {
+    auto block = blocks_.Take();
+    if (!block.has_value()) {
+      return std::nullopt;
+    }
+    block_ = std::move(*block);
+    position_ = 0;
+  }
+
+  // Blocks end on a line boundary, except for the last line of the file
+  const char* begin = block_.data() + position_;
+  const size_t rest = block_.size() - position_;
+  auto newline = static_cast<const char*>(std::memchr(begin, '\n', rest));
+  const size_t length = (newline != nullptr) ? newline - begin : rest;
+  position_ = std::min(position_ + length + 1, block_.size());
+  return std::string_view{begin, length};
+}
+
+Status LineStream::GetStatus() const {
+  if (error_) {
+    return Fail(error_);
+  }
+  return Ok();
+}
+
+// Reader thread
+void LineStream::ReadAhead(int fd, size_t block_size) {
+  // The partial last line of the previous block
+  std::string carry;
+
+  while (true) {
+    std::string block = std::move(carry);
+    carry.clear();
+    const size_t head = block.size();
+    block.resize(head + block_size);
+
+    const ssize_t bytes = ReadSome(fd, block.data() + head, block_size);
+    if (bytes < 0) {
+      error_ = LastError();
+      break;
+    }
+    block.resize(head + bytes);
+
+    if (bytes == 0) {
+      if (!block.empty()) {
+        blocks_.Put(std::move(block));
+      }
+      break;
+    }
+
+    // The carried head has no line break
+    auto last = static_cast<const char*>(::memrchr(block.data() + head, '\n', bytes));
+    if (last == nullptr) {
+      // A line longer than the block, keep reading it
+      carry = std::move(block);
+      continue;
+    }
+    const size_t split = last - block.data() + 1;
+    carry.assign(block, split);
+    block.resize(split);
+
+    if (!blocks_.Put(std::move(block))) {
+      return;  // Cancelled
+    }
+  }
+
+  blocks_.Close();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
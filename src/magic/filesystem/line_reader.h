@@ -0,0 +1,234 @@
+#pragma once
+
+#include <magic/common/result.h>
+#include <magic/concurrency/blocking_queue.h>
+#include <magic/coroutine/generator.h>
+
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Input range over anything with `std::optional<std::string_view> ReadLine()`
+// Single pass: each increment consumes a line from the reader
+
+template <typename Reader>
+class ReadLineRange {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    Iterator() = default;
+
+    explicit Iterator(Reader* reader) : reader_(reader) {
+      Advance();
+    }
+
+    reference operator*() const {
+      return line_;
+    }
+
+    pointer operator->() const {
+      return &line_;
+    }
+
+    Iterator& operator++() {
+      Advance();
+      return *this;
+    }
+
+    void operator++(int) {
+      Advance();
+    }
+
+    bool operator==(std::default_sentinel_t) const {
+      return reader_ == nullptr;
+    }
+
+   private:
+    void Advance() {
+      if (auto line = reader_->ReadLine()) {
+        line_ = *line;
+      } else {
+        reader_ = nullptr;
+      }
+    }
+
+   private:
+    Reader* reader_ = nullptr;
+    std::string_view line_;
+  };
+
+  explicit ReadLineRange(Reader& reader) : reader_(&reader) {
+  }
+
+  Iterator begin() const {
+    return Iterator{reader_};
+  }
+
+  std::default_sentinel_t end() const {
+    return {};
+  }
+
+ private:
+  Reader* reader_;
+};
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Streaming line reader with a reusable read buffer
+// Memory stays bounded by the buffer size (grown only for a line longer than
+// the buffer) regardless of the file size, processing starts with the first block
+
+// Lines have std::getline semantics: the '\n' is not included,
+// a trailing newline does not start an empty line
+// A line view is valid until the next ReadLine
+
+// Not thread-safe
+
+// Usage:
+// auto reader = LineReader::Open("huge.log").ValueOrThrow();
+// for (std::string_view line : reader.Lines()) { ... }
+// reader.GetStatus().ThrowIfError();
+
+class LineReader final {
+ public:
+  static const size_t kDefaultBufferSize = 64 * 1024;
+
+  static Result<LineReader> Open(std::string_view path, size_t buffer_size = kDefaultBufferSize);
+
+  ~LineReader();
+
+  // Non-copyable
+  LineReader(const LineReader&) = delete;
+  LineReader& operator=(const LineReader&) = delete;
+
+  // Movable
+  LineReader(LineReader&& that);
+  LineReader& operator=(LineReader&& that);
+
+  // ~ Public Interface
+
+  // std::nullopt at the end of the file or after a read error
+  std::optional<std::string_view> ReadLine();
+
+  // Read error, if any, check after ReadLine has returned std::nullopt
+  Status GetStatus() const;
+
+  detail::ReadLineRange<LineReader> Lines() {
+    return detail::ReadLineRange<LineReader>{*this};
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  LineReader(int fd, size_t buffer_size);
+
+  // Moves the unread bytes to the front and reads more after them
+  // Returns false at the end of the file or on error
+  bool Refill();
+
+ private:
+  int fd_ = -1;
+  std::vector<char> buffer_;
+  // Unread bytes are [begin_, end_), [begin_, scanned_) has no '\n'
+  size_t begin_ = 0;
+  size_t scanned_ = 0;
+  size_t end_ = 0;
+  bool eof_ = false;
+  std::error_code error_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Lines of the reader as a Generator
+// The reader must outlive the generator
+
+inline Generator<std::string_view> GenerateLines(LineReader& reader) {
+  return {[&reader] {
+    while (auto line = reader.ReadLine()) {
+      Send<std::string_view>(*line);
+    }
+  }};
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Line reader with read-ahead on a background thread
+// The thread reads blocks ending on a line boundary into a bounded queue,
+// so parsing on the consumer side overlaps disk reads and at most
+// `queue_depth` blocks are buffered
+
+// Same line semantics as LineReader
+
+// Usage:
+// auto stream = LineStream::Open("huge.log").ValueOrThrow();
+// for (std::string_view line : stream->Lines()) { ... }
+// stream->GetStatus().ThrowIfError();
+
+class LineStream final {
+ public:
+  static Result<std::unique_ptr<LineStream>> Open(
+      std::string_view path, size_t block_size = LineReader::kDefaultBufferSize,
+      size_t queue_depth = 16);
+
+  // Stops reading, the unread blocks are dropped
+  ~LineStream();
+
+  // Non-copyable
+  LineStream(const LineStream&) = delete;
+  LineStream& operator=(const LineStream&) = delete;
+
+  // ~ Public Interface
+
+  // Blocks until the next block is read
+  // std::nullopt at the end of the file or after a read error
+  std::optional<std::string_view> ReadLine();
+
+  // Read error, if any, check after ReadLine has returned std::nullopt
+  Status GetStatus() const;
+
+  detail::ReadLineRange<LineStream> Lines() {
+    return detail::ReadLineRange<LineStream>{*this};
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  LineStream(int fd, size_t block_size, size_t queue_depth);
+
+  void ReadAhead(int fd, size_t block_size);
+
+ private:
+  BoundedBlockingQueue<std::string> blocks_;
+  // Written by the reader thread before it closes the queue
+  std::error_code error_;
+
+  // Consumer side
+  std::string block_;
+  size_t position_ = 0;
+
+  std::thread reader_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,153 @@
+#include <magic/filesystem/log_writer.h>
+
+#include <magic/common/result/make.h>
+#include <magic/futures/await.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <utility>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+Result<std::unique_ptr<LogWriter>> LogWriter::Open(std::string_view path,
+                                                   LogWriterOptions options) {
+  // Every group is written with a single writev, no buffering needed
+  auto writer = BufferedWriter::Open(path, {.BufferSize = 1,
+                                            .Append = true,
+                                            .Preallocate = options.Preallocate});
+  if (writer.HasError()) {
+    return Fail(writer.Error());
+  }
+  std::error_code error;
+  const uint64_t size = std::filesystem::file_size(std::string(path), error);
+  if (error) {
+    return Fail(error);
+  }
+  return Ok(std::unique_ptr<LogWriter>(new LogWriter(std::move(*writer), size, options)));
+}
+
+LogWriter::LogWriter(BufferedWriter writer, uint64_t size, LogWriterOptions options)
+    : options_(options), writer_(std::move(writer)), size_(size) {
+  committer_ = std::thread([this] {
+    CommitLoop();
+  });
+}
+
+LogWriter::~LogWriter() {
+  {
+    std::lock_guard guard(mutex_);
+    stop_ = true;
+  }
+  queued_.notify_one();
+  committer_.join();
+  writer_.Close().Ignore();
+}
+
+Future<uint64_t> LogWriter::AppendAsync(std::string_view record) {
+  auto [future, promise] = MakeContract<uint64_t>();
+
+  std::unique_lock lock(mutex_);
+  if (error_.has_value()) {
+    const auto error = *error_;
+    lock.unlock();
+    std::move(promise).SetError(error);
+    return std::move(future);
+  }
+
+  // Empty records queue a waiter only
+  const bool idle = waiters_.empty();
+  pending_.append(record);
+  size_ += record.size();
+  waiters_.push_back({size_, std::move(promise)});
+  lock.unlock();
+
+  if (idle) {
+    queued_.notify_one();
+  }
+  return std::move(future);
+}
+
+Result<uint64_t> LogWriter::Append(std::string_view record) {
+  return AwaitResult(AppendAsync(record));
+}
+
+uint64_t LogWriter::Size() const {
+  std::lock_guard guard(mutex_);
+  return size_;
+}
+
+uint64_t LogWriter::Commits() const {
+  std::lock_guard guard(mutex_);
+  return commits_;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void LogWriter::CommitLoop() {
+  std::string group;
+  std::vector<Waiter> waiters;
+
+  std::unique_lock lock(mutex_);
+  while (true) {
+    queued_.wait(lock, [this] {
+      return stop_ || !waiters_.empty();
+    });
+    if (waiters_.empty()) {
+      break;  // Stopped and drained
+    }
+
+    if (options_.CommitDelay > Duration::zero() && !stop_) {
+      queued_.wait_for(lock, options_.CommitDelay, [this] {
+        return stop_;
+      });
+    }
+
+    // Records appended from now on form the next group
+    group.clear();
+    std::swap(group, pending_);
+    std::swap(waiters, waiters_);
+    lock.unlock();
+
+    // A group of empty records ends at an offset the previous commit
+    // made durable already
+    Status status = Ok();
+    if (!group.empty()) {
+      status = writer_.Write(group);
+      if (status.IsOk()) {
+        status = writer_.Sync();
+      }
+    }
+
+    lock.lock();
+    if (!group.empty()) {
+      ++commits_;
+    }
+    if (status.HasError()) {
+      // Later appends fail right away, the queued ones can not become durable either
+      error_ = status.Error().ErrorCode();
+      pending_.clear();
+      std::move(waiters_.begin(), waiters_.end(), std::back_inserter(waiters));
+      waiters_.clear();
+    }
+    lock.unlock();
+
+    // Continuations may append again, complete outside of the lock
+    for (auto& waiter : waiters) {
+      if (status.IsOk()) {
+        std::move(waiter.promise).SetValue(waiter.end);
+      } else {
+        std::move(waiter.promise).SetError(status.Error());
+      }
+    }
+    waiters.clear();
+
+    lock.lock();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
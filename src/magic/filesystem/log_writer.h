@@ -0,0 +1,108 @@
+#pragma once
+
+#include <magic/common/result.h>
+#include <magic/common/time.h>
+#include <magic/filesystem/buffered_writer.h>
+#include <magic/futures/core/future.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct LogWriterOptions {
+  // Waits that long after the first record of a group for more records
+  // before committing: trades latency for larger groups under light load
+  Duration CommitDelay = Duration::zero();
+  // Disk space reserved up front, see BufferedWriterOptions::Preallocate
+  size_t Preallocate = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Append-only durable log with group commit
+
+// Records appended concurrently are coalesced by a dedicated committer
+// thread: everything queued while the previous fdatasync was running is
+// written with one write and made durable with one fdatasync, then every
+// record of the group completes at once
+
+// Records are stored as is, callers add their own framing ('\n', length)
+// A failed write or sync poisons the log: the page cache state is unknown
+// afterwards, so that and every later record fail with the same error
+
+// Thread-safe
+
+// Usage:
+// auto log = LogWriter::Open("journal.log").ValueOrThrow();
+// log->Append("event\n").ThrowIfError();  // Durable on return
+
+class LogWriter final {
+ public:
+  static Result<std::unique_ptr<LogWriter>> Open(std::string_view path,
+                                                 LogWriterOptions options = {});
+
+  // Commits the queued records and stops the committer
+  ~LogWriter();
+
+  // Non-copyable
+  LogWriter(const LogWriter&) = delete;
+  LogWriter& operator=(const LogWriter&) = delete;
+
+  // ~ Public Interface
+
+  // Completes with the end offset of the record once it is durable
+  // The future completes on the committer thread, attach continuations with Via
+  Future<uint64_t> AppendAsync(std::string_view record);
+
+  // Suspends the calling fiber or blocks the calling thread until durable
+  Result<uint64_t> Append(std::string_view record);
+
+  // Bytes in the file including the records not committed yet
+  uint64_t Size() const;
+
+  // Number of fdatasync calls issued
+  uint64_t Commits() const;
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  struct Waiter {
+    uint64_t end;
+    Promise<uint64_t> promise;
+  };
+
+  LogWriter(BufferedWriter writer, uint64_t size, LogWriterOptions options);
+
+  void CommitLoop();
+
+ private:
+  const LogWriterOptions options_;
+  // Touched only by the committer thread
+  BufferedWriter writer_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable queued_;
+  // Guarded by mutex_
+  std::string pending_;
+  std::vector<Waiter> waiters_;
+  uint64_t size_;
+  uint64_t commits_ = 0;
+  std::optional<std::error_code> error_;
+  bool stop_ = false;
+
+  std::thread committer_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,123 @@
+#include <magic/filesystem/mapped_file.h>
+#include <magic/common/defer.h>
+#include <magic/common/result/make.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+std::error_code LastError() {
+  return {errno, std::system_category()};
+}
+
+int ToAdvice(MappedFile::Access access) {
+  switch (access) {
+    case MappedFile::Access::Sequential:
+      return MADV_SEQUENTIAL;
+    case MappedFile::Access::Random:
+      return MADV_RANDOM;
+    default:
+      return MADV_NORMAL;
+  }
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+// memchr is vectorized in glibc, the scan runs at memory bandwidth
+void MappedFile::LineIterator::Advance() {
+  if (next_ == end_) {
+    line_ = {};
+    done_ = true;
+    return;
+  }
+
+  auto newline = static_cast<const char*>(std::memchr(next_, '\n', end_ - next_));
+  if (newline == nullptr) {
+    // The last line has no separator
+    line_ = {next_, static_cast<size_t>(end_ - next_)};
+    next_ = end_;
+  } else {
+    line_ = {next_, static_cast<size_t>(newline - next_)};
+    next_ = newline + 1;
+  }
+  done_ = false;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Result<MappedFile> MappedFile::Open(std::string_view path, Access access) {
+  const int fd = ::open(std::string(path).c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return Fail(LastError());
+  }
+  // The mapping keeps its own reference to the file
+  Defer close_fd([fd] {
+    ::close(fd);
+  });
+
+  struct stat stat;
+  if (::fstat(fd, &stat) != 0) {
+    return Fail(LastError());
+  }
+  if (!S_ISREG(stat.st_mode)) {
+    return Fail(std::make_error_code(std::errc::invalid_argument));
+  }
+
+  const auto size = static_cast<size_t>(stat.st_size);
+  if (size == 0) {
+    // Zero-length mappings are not allowed
+    return Ok(MappedFile{});
+  }
+
+  void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    return Fail(LastError());
+  }
+
+  auto file = MappedFile{static_cast<char*>(data), size};
+  file.Advise(access);
+  return Ok(std::move(file));
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+}
+
+void MappedFile::Advise(Access access) const {
+  if (data_ != nullptr) {
+    // Only a hint, failures are ignored
+    ::madvise(data_, size_, ToAdvice(access));
+  }
+}
+
+void MappedFile::WillNeed(size_t offset, size_t length) const {
+  if (data_ == nullptr || offset >= size_) {
+    return;
+  }
+  // madvise requires a page-aligned address
+  static const size_t kPageSize = ::sysconf(_SC_PAGESIZE);
+  const size_t aligned = offset / kPageSize * kPageSize;
+  length = std::min(length, size_ - offset) + (offset - aligned);
+  ::madvise(data_ + aligned, length, MADV_WILLNEED);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
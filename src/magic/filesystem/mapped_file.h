@@ -0,0 +1,164 @@
+#pragma once
+
+#include <magic/common/result.h>
+
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <utility>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Read-only memory-mapped view of a file
+// Pages are loaded on first touch, lines and views point into the mapping
+// and stay valid as long as the MappedFile is alive
+
+// Usage:
+// auto file = MappedFile::Open("input.txt").ValueOrThrow();
+// for (std::string_view line : file.Lines()) { ... }
+
+class MappedFile final {
+ public:
+  // madvise hints
+  enum class Access {
+    Normal,
+    Sequential,  // Aggressive read-ahead, pages may be dropped after use
+    Random,      // No read-ahead
+  };
+
+  //////////////////////////////////////////////////////////////////////
+
+  // Lines separated by '\n', the same lines as std::getline would produce:
+  // the separator is not included, a trailing newline does not start an empty line
+
+  class LineIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = const std::string_view&;
+
+    LineIterator() = default;
+
+    LineIterator(const char* begin, const char* end) : next_(begin), end_(end) {
+      Advance();
+    }
+
+    reference operator*() const {
+      return line_;
+    }
+
+    pointer operator->() const {
+      return &line_;
+    }
+
+    LineIterator& operator++() {
+      Advance();
+      return *this;
+    }
+
+    LineIterator operator++(int) {
+      auto copy = *this;
+      Advance();
+      return copy;
+    }
+
+    bool operator==(const LineIterator& that) const {
+      return line_.data() == that.line_.data() && done_ == that.done_;
+    }
+
+   private:
+    void Advance();
+
+   private:
+    const char* next_ = nullptr;
+    const char* end_ = nullptr;
+    std::string_view line_;
+    bool done_ = true;
+  };
+
+  class LineRange {
+   public:
+    explicit LineRange(std::string_view text) : text_(text) {
+    }
+
+    LineIterator begin() const {
+      return {text_.data(), text_.data() + text_.size()};
+    }
+
+    LineIterator end() const {
+      return {};
+    }
+
+   private:
+    std::string_view text_;
+  };
+
+  //////////////////////////////////////////////////////////////////////
+
+ public:
+  static Result<MappedFile> Open(std::string_view path, Access access = Access::Sequential);
+
+  MappedFile() = default;
+  ~MappedFile();
+
+  // Non-copyable
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Movable
+  MappedFile(MappedFile&& that)
+      : data_(std::exchange(that.data_, nullptr)), size_(std::exchange(that.size_, 0)) {
+  }
+
+  MappedFile& operator=(MappedFile&& that) {
+    std::swap(data_, that.data_);
+    std::swap(size_, that.size_);
+    return *this;
+  }
+
+  // ~ Public Interface
+
+  const char* Data() const {
+    return data_;
+  }
+
+  size_t Size() const {
+    return size_;
+  }
+
+  bool IsEmpty() const {
+    return size_ == 0;
+  }
+
+  std::string_view View() const {
+    return {data_, size_};
+  }
+
+  LineRange Lines() const {
+    return LineRange{View()};
+  }
+
+  // Applies to the whole mapping
+  void Advise(Access access) const;
+
+  // Asks the kernel to start reading the range in the background
+  void WillNeed(size_t offset, size_t length) const;
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  MappedFile(char* data, size_t size) : data_(data), size_(size) {
+  }
+
+ private:
+  char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
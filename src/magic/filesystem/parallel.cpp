@@ -0,0 +1,53 @@
+#include <magic/filesystem/parallel.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+std::vector<std::string_view> SplitAtLines(std::string_view text, size_t chunks) {
+  std::vector<std::string_view> parts;
+  chunks = std::max<size_t>(chunks, 1);
+  parts.reserve(chunks);
+
+  const char* begin = text.data();
+  const char* const end = text.data() + text.size();
+
+  for (size_t index = 1; index <= chunks && begin != end; ++index) {
+    const char* split = end;
+    if (index < chunks) {
+      // Even split point, moved forward past the next line break
+      split = std::max(begin, text.data() + text.size() / chunks * index);
+      auto newline = static_cast<const char*>(std::memchr(split, '\n', end - split));
+      split = (newline != nullptr) ? newline + 1 : end;
+    }
+
+    if (split != begin) {
+      parts.emplace_back(begin, split - begin);
+      begin = split;
+    }
+  }
+  return parts;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+size_t LineChunkCount(size_t size, const LineChunkOptions& options) {
+  size_t max_chunks = options.MaxChunks;
+  if (max_chunks == 0) {
+    max_chunks = 8 * std::max(1u, std::thread::hardware_concurrency());
+  }
+  const size_t by_size = size / std::max<size_t>(options.MinChunkSize, 1);
+  return std::clamp<size_t>(by_size, 1, max_chunks);
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <magic/common/result.h>
+#include <magic/common/result/make.h>
+#include <magic/common/unit.h>
+#include <magic/executors/executor.h>
+#include <magic/filesystem/mapped_file.h>
+#include <magic/futures/execute.h>
+#include <magic/futures/get.h>
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct LineChunkOptions {
+  // Upper bound for the number of chunks, 0 = 8 per hardware thread
+  // More chunks than threads keep the workers busy when lines are uneven
+  size_t MaxChunks = 0;
+  // Smaller files are split into fewer chunks
+  size_t MinChunkSize = 1 << 20;
+};
+
+// Splits the text into at most `chunks` consecutive non-empty parts,
+// every part but the last one ends right after a '\n'
+std::vector<std::string_view> SplitAtLines(std::string_view text, size_t chunks);
+
+namespace detail {
+
+size_t LineChunkCount(size_t size, const LineChunkOptions& options);
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Parallel map-reduce over the lines of a file
+// The file is memory-mapped and split into newline-aligned chunks,
+// every chunk is a task on the executor:
+//   T partial{};  for (line : chunk) { map(partial, line); }
+// and the partial results are merged on the calling thread in file order:
+//   reduce(total, std::move(partial))
+
+// Context: blocks the calling thread until every chunk is processed,
+// must not be called from a thread the executor needs to make progress
+
+// Usage:
+// auto words = MapReduceLines<size_t>(
+//     "access.log", pool,
+//     [](size_t& count, std::string_view line) { count += line.contains("GET"); },
+//     [](size_t& total, size_t count) { total += count; });
+
+template <typename T, typename Map, typename Reduce>
+Result<T> MapReduceLines(std::string_view path, IExecutor& executor, Map map, Reduce reduce,
+                         LineChunkOptions options = {}) {
+  auto file = MappedFile::Open(path, MappedFile::Access::Sequential);
+  if (file.HasError()) {
+    return Fail(file.Error());
+  }
+
+  const auto text = file->View();
+  const auto chunks = SplitAtLines(text, detail::LineChunkCount(text.size(), options));
+
+  std::vector<Future<T>> partials;
+  partials.reserve(chunks.size());
+  for (auto chunk : chunks) {
+    partials.push_back(futures::Execute(executor, [chunk, &map]() {
+      T partial{};
+      for (auto line : MappedFile::LineRange{chunk}) {
+        map(partial, line);
+      }
+      return partial;
+    }));
+  }
+
+  // Every task is awaited even after a failure: they read the mapping
+  T total{};
+  std::optional<Error> error;
+  for (auto& partial : partials) {
+    auto result = futures::WaitResult(std::move(partial));
+    if (result.HasError()) {
+      error.emplace(result.Error());
+    } else if (!error) {
+      reduce(total, std::move(*result));
+    }
+  }
+
+  if (error) {
+    return Fail(*error);
+  }
+  return Ok(std::move(total));
+}
+
+// Calls fn(std::string_view line) concurrently from the executor threads
+template <typename F>
+Status ParallelForEachLine(std::string_view path, IExecutor& executor, F fn,
+                           LineChunkOptions options = {}) {
+  auto result = MapReduceLines<Unit>(
+      path, executor,
+      [&fn](Unit&, std::string_view line) {
+        fn(line);
+      },
+      [](Unit&, Unit) {}, options);
+
+  if (result.HasError()) {
+    return Fail(result.Error());
+  }
+  return Ok();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
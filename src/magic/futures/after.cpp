@@ -0,0 +1,105 @@
+#include <magic/futures/after.h>
+
+#include <condition_variable>
+#include <map>
+#include <system_error>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace magic::futures {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+class TimerQueue final {
+ public:
+  TimerQueue() : thread_([this] {
+      Loop();
+    }) {
+  }
+
+  ~TimerQueue() {
+    {
+      std::lock_guard guard(mutex_);
+      stop_ = true;
+    }
+    changed_.notify_one();
+    thread_.join();
+
+    // Pending timers fail instead of leaking their continuations
+    for (auto& [_, promise] : timers_) {
+      std::move(promise).SetError(std::make_error_code(std::errc::operation_canceled));
+    }
+  }
+
+  static TimerQueue& Instance() {
+    static TimerQueue queue;
+    return queue;
+  }
+
+  void Add(Timestamp deadline, Promise<Unit> promise) {
+    bool earliest = false;
+    {
+      std::lock_guard guard(mutex_);
+      auto it = timers_.emplace(deadline, std::move(promise));
+      earliest = (it == timers_.begin());
+    }
+    if (earliest) {
+      changed_.notify_one();
+    }
+  }
+
+ private:
+  void Loop() {
+    std::unique_lock lock(mutex_);
+    while (!stop_) {
+      if (timers_.empty()) {
+        changed_.wait(lock);
+        continue;
+      }
+
+      const auto deadline = timers_.begin()->first;
+      if (Clock::now() < deadline) {
+        changed_.wait_until(lock, deadline);
+        continue;
+      }
+
+      std::vector<Promise<Unit>> expired;
+      const auto now = Clock::now();
+      while (!timers_.empty() && timers_.begin()->first <= now) {
+        expired.push_back(std::move(timers_.begin()->second));
+        timers_.erase(timers_.begin());
+      }
+
+      lock.unlock();
+      for (auto& promise : expired) {
+        std::move(promise).SetValue(Unit{});
+      }
+      lock.lock();
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  std::multimap<Timestamp, Promise<Unit>> timers_;  // Guarded by mutex_
+  bool stop_ = false;                               // Guarded by mutex_
+  std::thread thread_;
+};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+Future<Unit> After(Duration delay) {
+  auto [f, p] = MakeContract<Unit>();
+  const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(delay);
+  TimerQueue::Instance().Add(deadline, std::move(p));
+  return std::move(f);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::futures
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <magic/common/time.h>
+#include <magic/common/unit.h>
+#include <magic/futures/core/future.h>
+
+namespace magic::futures {
+
+//////////////////////////////////////////////////////////////////////
+
+// Future that completes after the delay
+// Timers run on a single process-wide thread: continuations attached without
+// Via run on it and must be short. Timers pending at exit fail with
+// operation_canceled
+
+// Usage:
+// futures::After(50ms).Via(pool).Then([](Unit) { ... });
+
+Future<Unit> After(Duration delay);
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::futures
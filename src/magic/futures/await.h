@@ -16,4 +16,16 @@ T Await(Future<T>&& future) {
   }
 }
 
+// Same as Await, but the error is returned instead of thrown
+template <typename T>
+Result<T> AwaitResult(Future<T>&& future) {
+  if (self::IsFiber()) {
+    return detail::Await(std::move(future));
+  }
+  else {
+    // Block current thread
+    return futures::WaitResult(std::move(future));
+  }
+}
+
 }  // namespace magic
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <magic/common/histogram.h>
+#include <magic/common/tsc_clock.h>
+#include <magic/futures/core/future.h>
+
+namespace magic::futures {
+
+//////////////////////////////////////////////////////////////////////
+
+// Records the time from the call until the future completes, errors
+// included, in nanoseconds
+// The histogram is updated inline on completion, continuations still run
+// on the executor of the input future
+
+// Usage:
+// auto response = futures::RecordLatency(client.Get(url), request_latency);
+
+template <typename T>
+Future<T> RecordLatency(Future<T> future, Histogram& histogram) {
+  const uint64_t start = TscClock::Ticks();
+  auto [f, p] = MakeContractVia<T>(future.GetExecutor());
+  std::move(future).Via(GetInlineExecutor()).Subscribe(
+      [p = std::move(p), &histogram, start](Result<T> result) mutable {
+        histogram.Record(TscClock::TicksToDuration(TscClock::Ticks() - start));
+        std::move(p).Set(std::move(result));
+      });
+  return std::move(f);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::futures
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <magic/common/unit.h>
+#include <magic/futures/core/future.h>
+
+#include <deque>
+#include <mutex>
+
+namespace magic::futures {
+
+//////////////////////////////////////////////////////////////////////
+
+// Counting semaphore for asynchronous code: Acquire never blocks a thread,
+// it returns a future that completes once a permit has been granted
+// Waiters are served in FIFO order, a released permit is handed over
+// to the oldest waiter directly
+
+// Usage:
+// semaphore.Acquire().Then([&](Unit) {
+//   ...
+//   semaphore.Release();
+// });
+
+class AsyncSemaphore final {
+ public:
+  explicit AsyncSemaphore(size_t permits) : permits_(permits) {
+  }
+
+  // Non-copyable
+  AsyncSemaphore(const AsyncSemaphore&) = delete;
+  AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+  // ~ Public Interface
+
+  // Completes inline if a permit is available
+  Future<Unit> Acquire() {
+    auto [f, p] = MakeContract<Unit>();
+    {
+      std::lock_guard guard(mutex_);
+      if (permits_ == 0) {
+        waiters_.push_back(std::move(p));
+        return std::move(f);
+      }
+      --permits_;
+    }
+    std::move(p).SetValue(Unit{});
+    return std::move(f);
+  }
+
+  bool TryAcquire() {
+    std::lock_guard guard(mutex_);
+    if (permits_ == 0) {
+      return false;
+    }
+    --permits_;
+    return true;
+  }
+
+  void Release() {
+    std::unique_lock lock(mutex_);
+    if (waiters_.empty()) {
+      ++permits_;
+      return;
+    }
+    auto next = std::move(waiters_.front());
+    waiters_.pop_front();
+    lock.unlock();
+
+    std::move(next).SetValue(Unit{});
+  }
+
+  size_t Available() const {
+    std::lock_guard guard(mutex_);
+    return permits_;
+  }
+
+  size_t Waiters() const {
+    std::lock_guard guard(mutex_);
+    return waiters_.size();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  size_t permits_;                    // Guarded by mutex_
+  std::deque<Promise<Unit>> waiters_;  // Guarded by mutex_
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::futures
@@ -1,9 +1,13 @@
 #include <magic/net/http.h>
 #include <magic/net/http/request_builder.h>
+#include <magic/net/http/curl_pool.h>
+#include <magic/net/http/transfer.h>
+#include <magic/net/http/client.h>
+#include <magic/net/http/error.h>
 
-#include <magic/futures/execute.h>
 #include <magic/executors/thread_pool.h>
 #include <magic/common/stopwatch.h>
+#include <magic/common/defer.h>
 
 #include <fmt/core.h>
 #include <fmt/chrono.h>
@@ -15,128 +19,82 @@
 
 namespace magic {
 
-HttpResponse Http::Get(std::string url) {
-  std::string response_header, response_content;
-
-  CURL* curl = curl_easy_init();
-  struct curl_slist* list = nullptr;
-
-  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+namespace detail {
 
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, detail::WriteFunction);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_content);
-
-  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, detail::WriteFunction);
-  curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response_header);
+// Performs the configured transfer, throws on transport errors
+static HttpResponse Perform(CURL* curl) {
+  ResponseBuffers response;
+  SetupTransfer(curl, &response);
 
   const auto result = curl_easy_perform(curl);
 
   if (result != CURLE_OK) {
-    curl_easy_cleanup(curl);
     throw BaseException(curl_easy_strerror(result));
   }
 
-  // HttpResponse
-
-  int64_t response_code;
-  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-
-  double total_time;
-  curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total_time);
-  auto elapsed = ToTimeSpan(total_time);
-
-  char* url_string{nullptr};
-  curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url_string);
-  auto effective_url = std::string(url_string);
-
-  // Metrics
+  return CollectResponse(curl, std::move(response.header), std::move(response.content));
+}
 
-  double downloaded, uploaded, average_download_speed, average_upload_speed;
-  curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD, &downloaded);
-  curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD, &uploaded);
-  curl_easy_getinfo(curl, CURLINFO_SPEED_DOWNLOAD, &average_download_speed);
-  curl_easy_getinfo(curl, CURLINFO_SPEED_UPLOAD, &average_upload_speed);
+}  // namespace detail
 
-  auto metrics = HttpRequestMetrics{.DownloadBytes = downloaded,
-                                    .UploadBytes = uploaded,
-                                    .AverageDownloadSpeed = average_download_speed,
-                                    .AverageUploadSpeed = average_upload_speed,
-                                    .Duration = elapsed};
+//////////////////////////////////////////////////////////////////////
 
-  // Cleanup
+HttpResponse Http::Get(std::string url) {
+  auto handle = CurlHandlePool::Instance().Acquire(url);
+  CURL* curl = handle.Get();
 
-  curl_easy_cleanup(curl);
+  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
 
-  return HttpResponse{HttpStatus::FromStatusCode(response_code), HttpHeader::Parse(response_header),
-                      std::move(metrics), effective_url, std::move(response_content)};
+  return detail::Perform(curl);
 }
 
 HttpResponse Http::PostJson(std::string url, std::string json) {
-  std::string response_header, response_content;
-
-  CURL* curl = curl_easy_init();
-  struct curl_slist* list = nullptr;
+  auto handle = CurlHandlePool::Instance().Acquire(url);
+  CURL* curl = handle.Get();
 
   curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-
-  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, detail::WriteFunction);
-  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response_content);
-
-  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, detail::WriteFunction);
-  curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response_header);
-
   curl_easy_setopt(curl, CURLOPT_POSTFIELDS, json.c_str());
 
+  struct curl_slist* list = nullptr;
   list = curl_slist_append(list, "Content-Type: application/json");
   curl_easy_setopt(curl, CURLOPT_HTTPHEADER, list);
 
-  const auto result = curl_easy_perform(curl);
-  curl_slist_free_all(list);
-
-  if (result != CURLE_OK) {
-    curl_easy_cleanup(curl);
-    throw BaseException(curl_easy_strerror(result));
-  }
-
-  // HttpResponse
+  Defer cleanup([list] {
+    curl_slist_free_all(list);
+  });
 
-  int64_t response_code;
-  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+  return detail::Perform(curl);
+}
 
-  double total_time;
-  curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total_time);
-  auto elapsed = ToTimeSpan(total_time);
+HttpResponse Http::Download(std::string url, IBodySink& sink) {
+  auto handle = CurlHandlePool::Instance().Acquire(url);
+  CURL* curl = handle.Get();
 
-  char* url_string{nullptr};
-  curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url_string);
-  auto effective_url = std::string(url_string);
+  curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
 
-  // Metrics
+  std::string response_header;
+  detail::SetupStreamingTransfer(curl, &response_header, &sink);
 
-  double downloaded, uploaded, average_download_speed, average_upload_speed;
-  curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD, &downloaded);
-  curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD, &uploaded);
-  curl_easy_getinfo(curl, CURLINFO_SPEED_DOWNLOAD, &average_download_speed);
-  curl_easy_getinfo(curl, CURLINFO_SPEED_UPLOAD, &average_upload_speed);
+  const auto result = curl_easy_perform(curl);
+  sink.Close(result == CURLE_OK ? std::error_code{} : curl::easy::make_error_code(result));
 
-  auto metrics = HttpRequestMetrics{.DownloadBytes = downloaded,
-                                    .UploadBytes = uploaded,
-                                    .AverageDownloadSpeed = average_download_speed,
-                                    .AverageUploadSpeed = average_upload_speed,
-                                    .Duration = elapsed};
+  if (result != CURLE_OK) {
+    throw BaseException(curl_easy_strerror(result));
+  }
 
-  // Cleanup
+  return detail::CollectResponse(curl, std::move(response_header), {});
+}
 
-  curl_easy_cleanup(curl);
+CurlPoolMetrics Http::GetPoolMetrics() {
+  return CurlHandlePool::Instance().GetMetrics();
+}
 
-  return HttpResponse{HttpStatus::FromStatusCode(response_code), HttpHeader::Parse(response_header),
-                      std::move(metrics), effective_url, std::move(response_content)};
+HttpLatencySummary Http::GetLatency(std::string_view url) {
+  return HttpLatencyRegistry::Instance().Summary(url);
 }
 
 Future<HttpResponse> Http::PostJsonAsync(IExecutor& executor, std::string url, std::string json) {
-  return futures::Execute(executor, [url = std::move(url), json = std::move(json)]() mutable {
-    return Http::PostJson(std::move(url), std::move(json));
-  });
+  return HttpClient::Default().PostJson(executor, std::move(url), std::move(json));
 }
 
 Future<HttpResponse> Http::PostJsonAsync(std::string url, std::string json) {
@@ -148,9 +106,7 @@ Future<HttpResponse> Http::GetAsync(std::string url) {
 }
 
 Future<HttpResponse> Http::GetAsync(IExecutor& executor, std::string url) {
-  return futures::Execute(executor, [url = std::move(url)]() mutable {
-    return Http::Get(std::move(url));
-  });
+  return HttpClient::Default().Get(executor, std::move(url));
 }
 
 Future<std::string> Http::GetStringAsync(std::string url) {
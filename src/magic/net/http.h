@@ -1,6 +1,9 @@
 #pragma once
 
 #include <magic/net/http/response.h>
+#include <magic/net/http/curl_pool.h>
+#include <magic/net/http/latency.h>
+#include <magic/net/http/sink.h>
 #include <magic/executors/executor.h>
 #include <magic/futures/core/future.h>
 
@@ -9,6 +12,8 @@ namespace magic {
 //////////////////////////////////////////////////////////////////////
 
 // Thread-safe methods that may be used concurrently from any thread
+// Async methods run on the shared event-driven HttpClient and complete
+// on the provided executor (ThreadPool::Current() by default)
 
 struct Http {
 
@@ -18,6 +23,10 @@ struct Http {
   // Send a POST request to the specified Uri with JSON content.
   static HttpResponse PostJson(std::string url, std::string json);
 
+  // Send a GET request and deliver the body to the sink chunk by chunk.
+  // The returned response has an empty content.
+  static HttpResponse Download(std::string url, IBodySink& sink);
+
   // Send a GET request to the specified url as an asynchronous operation.
   static Future<HttpResponse> GetAsync(std::string url);
 
@@ -33,6 +42,12 @@ struct Http {
   // Send a POST request to the specified Uri as an asynchronous operation.
   static Future<HttpResponse> PostJsonAsync(IExecutor& executor, std::string url, std::string json);
 
+  // Hit/miss counters of the shared curl handle pool
+  static CurlPoolMetrics GetPoolMetrics();
+
+  // Latencies of the completed requests to the origin of the url
+  static HttpLatencySummary GetLatency(std::string_view url);
+
 };
 
 //////////////////////////////////////////////////////////////////////
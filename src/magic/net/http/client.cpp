@@ -0,0 +1,324 @@
+#include <magic/net/http/client.h>
+#include <magic/net/http/curl_pool.h>
+#include <magic/net/http/error.h>
+#include <magic/net/http/latency.h>
+#include <magic/net/http/transfer.h>
+
+#include <magic/executors/inline.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct HttpClient::Transfer {
+  Transfer(CurlHandlePool::Handle h, Promise<HttpResponse> p)
+      : handle(std::move(h)), promise(std::move(p)) {
+  }
+
+  ~Transfer() {
+    curl_slist_free_all(headers);
+  }
+
+  CurlHandlePool::Handle handle;
+  Promise<HttpResponse> promise;
+  uint64_t id = 0;
+
+  // Must outlive the transfer
+  std::string url;
+  std::string body;
+  curl_slist* headers = nullptr;
+
+  detail::ResponseBuffers response;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+HttpClient::HttpClient() {
+  // Completed transfers release handles to the pool and record latencies,
+  // including the ones aborted by the destructor: constructing the
+  // singletons first makes them outlive a static client like Default()
+  CurlHandlePool::Instance();
+  HttpLatencyRegistry::Instance();
+
+  multi_ = curl_multi_init();
+  WHEELS_VERIFY(multi_ != nullptr, "Failed to create curl multi handle");
+
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  WHEELS_VERIFY(epoll_fd_ >= 0 && timer_fd_ >= 0 && wakeup_fd_ >= 0,
+                "Failed to create event loop descriptors");
+
+  for (int fd : {timer_fd_, wakeup_fd_}) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  }
+
+  curl_multi_setopt(multi_, CURLMOPT_SOCKETFUNCTION, &HttpClient::OnSocket);
+  curl_multi_setopt(multi_, CURLMOPT_SOCKETDATA, this);
+  curl_multi_setopt(multi_, CURLMOPT_TIMERFUNCTION, &HttpClient::OnTimer);
+  curl_multi_setopt(multi_, CURLMOPT_TIMERDATA, this);
+
+  loop_ = std::thread([this] {
+    EventLoop();
+  });
+}
+
+HttpClient::~HttpClient() {
+  stop_.store(true);
+  Wakeup();
+  loop_.join();
+
+  curl_multi_cleanup(multi_);
+  close(wakeup_fd_);
+  close(timer_fd_);
+  close(epoll_fd_);
+}
+
+HttpClient& HttpClient::Default() {
+  static HttpClient instance;
+  return instance;
+}
+
+Future<HttpResponse> HttpClient::Get(std::string url) {
+  return Get(GetInlineExecutor(), std::move(url));
+}
+
+Future<HttpResponse> HttpClient::Get(IExecutor& executor, std::string url) {
+  return StartGet(executor, std::move(url)).Response;
+}
+
+HttpCall HttpClient::StartGet(IExecutor& executor, std::string url) {
+  auto [f, p] = MakeContractVia<HttpResponse>(executor);
+
+  auto transfer = std::make_unique<Transfer>(CurlHandlePool::Instance().Acquire(url), std::move(p));
+  transfer->url = std::move(url);
+
+  CURL* curl = transfer->handle.Get();
+  curl_easy_setopt(curl, CURLOPT_URL, transfer->url.c_str());
+
+  const auto id = Submit(std::move(transfer));
+  return {id, std::move(f)};
+}
+
+void HttpClient::Cancel(uint64_t call_id) {
+  {
+    std::lock_guard lock(mutex_);
+    cancelled_.push_back(call_id);
+  }
+  Wakeup();
+}
+
+Future<HttpResponse> HttpClient::PostJson(std::string url, std::string json) {
+  return PostJson(GetInlineExecutor(), std::move(url), std::move(json));
+}
+
+Future<HttpResponse> HttpClient::PostJson(IExecutor& executor, std::string url, std::string json) {
+  auto [f, p] = MakeContractVia<HttpResponse>(executor);
+
+  auto transfer = std::make_unique<Transfer>(CurlHandlePool::Instance().Acquire(url), std::move(p));
+  transfer->url = std::move(url);
+  transfer->body = std::move(json);
+  transfer->headers = curl_slist_append(nullptr, "Content-Type: application/json");
+
+  CURL* curl = transfer->handle.Get();
+  curl_easy_setopt(curl, CURLOPT_URL, transfer->url.c_str());
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(transfer->body.size()));
+  curl_easy_setopt(curl, CURLOPT_POSTFIELDS, transfer->body.c_str());
+  curl_easy_setopt(curl, CURLOPT_HTTPHEADER, transfer->headers);
+
+  Submit(std::move(transfer));
+  return std::move(f);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+uint64_t HttpClient::Submit(std::unique_ptr<Transfer> transfer) {
+  const auto id = next_id_.fetch_add(1, std::memory_order::relaxed);
+  transfer->id = id;
+
+  CURL* curl = transfer->handle.Get();
+  detail::SetupTransfer(curl, &transfer->response);
+  curl_easy_setopt(curl, CURLOPT_PRIVATE, transfer.get());
+
+  in_flight_.fetch_add(1, std::memory_order::relaxed);
+  {
+    std::lock_guard lock(mutex_);
+    submitted_.push_back(std::move(transfer));
+  }
+  Wakeup();
+  return id;
+}
+
+void HttpClient::Wakeup() {
+  uint64_t one = 1;
+  [[maybe_unused]] auto bytes = write(wakeup_fd_, &one, sizeof(one));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void HttpClient::EventLoop() {
+  static const int kMaxEvents = 256;
+  epoll_event events[kMaxEvents];
+
+  int running = 0;
+
+  while (!stop_.load()) {
+    const int ready = epoll_wait(epoll_fd_, events, kMaxEvents, -1);
+    if (ready < 0) {
+      WHEELS_VERIFY(errno == EINTR, "epoll_wait failed");
+      continue;
+    }
+
+    for (int index = 0; index < ready; ++index) {
+      const int fd = events[index].data.fd;
+
+      if (fd == wakeup_fd_) {
+        uint64_t count;
+        [[maybe_unused]] auto bytes = read(wakeup_fd_, &count, sizeof(count));
+        AddSubmitted();
+        ProcessCancelled();
+      } else if (fd == timer_fd_) {
+        uint64_t expirations;
+        [[maybe_unused]] auto bytes = read(timer_fd_, &expirations, sizeof(expirations));
+        curl_multi_socket_action(multi_, CURL_SOCKET_TIMEOUT, 0, &running);
+      } else {
+        int action = 0;
+        if (events[index].events & EPOLLIN) {
+          action |= CURL_CSELECT_IN;
+        }
+        if (events[index].events & EPOLLOUT) {
+          action |= CURL_CSELECT_OUT;
+        }
+        if (events[index].events & (EPOLLERR | EPOLLHUP)) {
+          action |= CURL_CSELECT_ERR;
+        }
+        curl_multi_socket_action(multi_, fd, action, &running);
+      }
+    }
+
+    ProcessCompleted();
+  }
+
+  // Fail everything that has not completed
+  AddSubmitted();
+  auto aborted = active_;
+  for (auto [_, transfer] : aborted) {
+    Complete(transfer, CURLE_ABORTED_BY_CALLBACK);
+  }
+}
+
+void HttpClient::AddSubmitted() {
+  std::vector<std::unique_ptr<Transfer>> submitted;
+  {
+    std::lock_guard lock(mutex_);
+    submitted.swap(submitted_);
+  }
+
+  for (auto& transfer : submitted) {
+    // Ownership moves to the multi handle, reclaimed in Complete
+    Transfer* raw = transfer.release();
+    active_.emplace(raw->id, raw);
+    curl_multi_add_handle(multi_, raw->handle.Get());
+  }
+}
+
+void HttpClient::ProcessCancelled() {
+  std::vector<uint64_t> cancelled;
+  {
+    std::lock_guard lock(mutex_);
+    cancelled.swap(cancelled_);
+  }
+
+  for (auto id : cancelled) {
+    // Already completed calls are not found
+    if (auto it = active_.find(id); it != active_.end()) {
+      Complete(it->second, CURLE_ABORTED_BY_CALLBACK);
+    }
+  }
+}
+
+void HttpClient::ProcessCompleted() {
+  CURLMsg* message;
+  int pending;
+  while ((message = curl_multi_info_read(multi_, &pending))) {
+    if (message->msg != CURLMSG_DONE) {
+      continue;
+    }
+    Transfer* transfer;
+    curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &transfer);
+    Complete(transfer, message->data.result);
+  }
+}
+
+void HttpClient::Complete(Transfer* raw, CURLcode result) {
+  std::unique_ptr<Transfer> transfer(raw);
+  active_.erase(raw->id);
+  CURL* curl = transfer->handle.Get();
+  curl_multi_remove_handle(multi_, curl);
+
+  in_flight_.fetch_sub(1, std::memory_order::relaxed);
+
+  if (result != CURLE_OK) {
+    std::move(transfer->promise).SetError(curl::easy::make_error_code(result));
+    return;
+  }
+
+  auto response = detail::CollectResponse(curl, std::move(transfer->response.header),
+                                          std::move(transfer->response.content));
+  std::move(transfer->promise).SetValue(std::move(response));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+int HttpClient::OnSocket(CURL*, curl_socket_t socket, int what, void* client, void*) {
+  auto self = static_cast<HttpClient*>(client);
+
+  if (what == CURL_POLL_REMOVE) {
+    epoll_ctl(self->epoll_fd_, EPOLL_CTL_DEL, socket, nullptr);
+    return 0;
+  }
+
+  epoll_event event{};
+  event.data.fd = socket;
+  if (what & CURL_POLL_IN) {
+    event.events |= EPOLLIN;
+  }
+  if (what & CURL_POLL_OUT) {
+    event.events |= EPOLLOUT;
+  }
+
+  if (epoll_ctl(self->epoll_fd_, EPOLL_CTL_MOD, socket, &event) != 0 && errno == ENOENT) {
+    epoll_ctl(self->epoll_fd_, EPOLL_CTL_ADD, socket, &event);
+  }
+  return 0;
+}
+
+int HttpClient::OnTimer(CURLM*, long timeout_ms, void* client) {
+  auto self = static_cast<HttpClient*>(client);
+
+  itimerspec spec{};
+  if (timeout_ms == 0) {
+    spec.it_value.tv_nsec = 1;  // As soon as possible, zero would disarm
+  } else if (timeout_ms > 0) {
+    spec.it_value.tv_sec = timeout_ms / 1000;
+    spec.it_value.tv_nsec = (timeout_ms % 1000) * 1'000'000;
+  }
+  timerfd_settime(self->timer_fd_, 0, &spec, nullptr);
+  return 0;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <magic/net/http/response.h>
+#include <magic/executors/executor.h>
+#include <magic/futures/core/future.h>
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Event-driven HTTP client on curl multi
+// One event-loop thread drives every transfer with epoll and a timerfd,
+// in-flight requests hold no thread, only a curl handle and a promise
+
+// Futures are bound to the provided executor, by default continuations
+// run inline on the event-loop thread and must not block
+
+// Usage:
+// auto f = HttpClient::Default().Get(pool, "http://localhost:8080/");
+// auto response = Await(std::move(f));
+
+// Request that may be aborted with HttpClient::Cancel
+struct HttpCall {
+  uint64_t Id;
+  Future<HttpResponse> Response;
+};
+
+class HttpClient final {
+  struct Transfer;
+
+ public:
+  HttpClient();
+  ~HttpClient();
+
+  // Non-copyable
+  HttpClient(const HttpClient&) = delete;
+  HttpClient& operator=(const HttpClient&) = delete;
+
+  // ~ Public Interface
+
+  // Process-wide client, started on first use
+  static HttpClient& Default();
+
+  Future<HttpResponse> Get(std::string url);
+  Future<HttpResponse> Get(IExecutor& executor, std::string url);
+
+  HttpCall StartGet(IExecutor& executor, std::string url);
+
+  // Fails the call with CURLE_ABORTED_BY_CALLBACK unless it has already completed
+  void Cancel(uint64_t call_id);
+
+  Future<HttpResponse> PostJson(std::string url, std::string json);
+  Future<HttpResponse> PostJson(IExecutor& executor, std::string url, std::string json);
+
+  // Requests submitted but not completed yet
+  size_t InFlight() const {
+    return in_flight_.load(std::memory_order::relaxed);
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  // Returns the call id
+  uint64_t Submit(std::unique_ptr<Transfer> transfer);
+  void Wakeup();
+
+  // Event loop thread
+  void EventLoop();
+  void AddSubmitted();
+  void ProcessCancelled();
+  void ProcessCompleted();
+  void Complete(Transfer* transfer, CURLcode result);
+
+  static int OnSocket(CURL* curl, curl_socket_t socket, int what, void* client, void* socket_data);
+  static int OnTimer(CURLM* multi, long timeout_ms, void* client);
+
+ private:
+  CURLM* multi_;
+  int epoll_fd_;
+  int timer_fd_;
+  int wakeup_fd_;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Transfer>> submitted_;  // Guarded by mutex_
+  std::vector<uint64_t> cancelled_;                   // Guarded by mutex_
+  std::atomic<uint64_t> next_id_ = 0;
+  std::atomic<bool> stop_ = false;
+  std::atomic<size_t> in_flight_ = 0;
+
+  // Owned by the event loop thread
+  std::unordered_map<uint64_t, Transfer*> active_;
+
+  std::thread loop_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
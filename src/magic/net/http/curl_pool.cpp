@@ -0,0 +1,129 @@
+#include <magic/net/http/curl_pool.h>
+
+#include <wheels/core/assert.hpp>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+std::string_view OriginOf(std::string_view url) {
+  size_t authority = 0;
+  if (auto scheme = url.find("://"); scheme != std::string_view::npos) {
+    authority = scheme + 3;
+  }
+  const auto end = url.find_first_of("/?#", authority);
+  return url.substr(0, end);
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+CurlHandlePool::CurlHandlePool() {
+  curl_global_init(CURL_GLOBAL_ALL);
+
+  share_ = curl_share_init();
+  WHEELS_VERIFY(share_ != nullptr, "Failed to create curl share");
+
+  curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, &CurlHandlePool::LockShared);
+  curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, &CurlHandlePool::UnlockShared);
+  curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+
+  curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+}
+
+CurlHandlePool::~CurlHandlePool() {
+  // Handles must be detached before the share is destroyed
+  for (auto& [_, handles] : idle_) {
+    for (auto curl : handles) {
+      curl_easy_cleanup(curl);
+    }
+  }
+  curl_share_cleanup(share_);
+}
+
+CurlHandlePool& CurlHandlePool::Instance() {
+  static CurlHandlePool instance;
+  return instance;
+}
+
+CurlHandlePool::Handle CurlHandlePool::Acquire(std::string_view url) {
+  auto origin = std::string(detail::OriginOf(url));
+
+  {
+    std::lock_guard lock(mutex_);
+    if (auto it = idle_.find(origin); it != idle_.end() && !it->second.empty()) {
+      CURL* curl = it->second.back();
+      it->second.pop_back();
+      hits_.fetch_add(1, std::memory_order::relaxed);
+      return Handle(*this, curl, std::move(origin));
+    }
+  }
+
+  misses_.fetch_add(1, std::memory_order::relaxed);
+  return Handle(*this, CreateHandle(), std::move(origin));
+}
+
+CurlPoolMetrics CurlHandlePool::GetMetrics() const {
+  return {.Hits = hits_.load(std::memory_order::relaxed),
+          .Misses = misses_.load(std::memory_order::relaxed),
+          .Evictions = evictions_.load(std::memory_order::relaxed)};
+}
+
+size_t CurlHandlePool::IdleCount() const {
+  std::lock_guard lock(mutex_);
+  size_t count = 0;
+  for (auto& [_, handles] : idle_) {
+    count += handles.size();
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+CURL* CurlHandlePool::CreateHandle() {
+  CURL* curl = curl_easy_init();
+  WHEELS_VERIFY(curl != nullptr, "Failed to create curl handle");
+  Attach(curl);
+  return curl;
+}
+
+void CurlHandlePool::Release(std::string origin, CURL* curl) {
+  // Drops options and per-transfer state, keeps live connections and caches
+  curl_easy_reset(curl);
+  Attach(curl);
+
+  {
+    std::lock_guard lock(mutex_);
+    auto& handles = idle_[std::move(origin)];
+    if (handles.size() < kMaxIdlePerOrigin) {
+      handles.push_back(curl);
+      return;
+    }
+  }
+
+  evictions_.fetch_add(1, std::memory_order::relaxed);
+  curl_easy_cleanup(curl);
+}
+
+void CurlHandlePool::Attach(CURL* curl) {
+  curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+  // Handles are used from many threads, signals are process-wide
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+}
+
+void CurlHandlePool::LockShared(CURL*, curl_lock_data data, curl_lock_access, void* pool) {
+  static_cast<CurlHandlePool*>(pool)->share_mutexes_[data].lock();
+}
+
+void CurlHandlePool::UnlockShared(CURL*, curl_lock_data data, void* pool) {
+  static_cast<CurlHandlePool*>(pool)->share_mutexes_[data].unlock();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <curl/curl.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct CurlPoolMetrics {
+  // Acquired an idle handle for the same origin
+  size_t Hits = 0;
+  // Had to create a new handle
+  size_t Misses = 0;
+  // Idle handles destroyed because the origin already had enough of them
+  size_t Evictions = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// scheme://host:port part of the url, keep-alive connections are per origin
+std::string_view OriginOf(std::string_view url);
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Thread-safe pool of reusable curl easy handles
+
+// A handle keeps its live connections after a transfer, so handing it
+// out again for the same origin skips the TCP and TLS handshakes.
+// Every handle is attached to one curl share object, so connection,
+// DNS and TLS session caches are also shared across handles
+
+class CurlHandlePool final {
+  static const size_t kMaxIdlePerOrigin = 16;
+
+ public:
+  // RAII: returns the handle to the pool on destruction
+  class Handle final {
+   public:
+    Handle(CurlHandlePool& pool, CURL* curl, std::string origin)
+        : pool_(&pool), curl_(curl), origin_(std::move(origin)) {
+    }
+
+    ~Handle() {
+      if (curl_ != nullptr) {
+        pool_->Release(std::move(origin_), curl_);
+      }
+    }
+
+    // Non-copyable
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+
+    // Movable
+    Handle(Handle&& that)
+        : pool_(that.pool_),
+          curl_(std::exchange(that.curl_, nullptr)),
+          origin_(std::move(that.origin_)) {
+    }
+
+    CURL* Get() const {
+      return curl_;
+    }
+
+   private:
+    CurlHandlePool* pool_;
+    CURL* curl_;
+    std::string origin_;
+  };
+
+ public:
+  CurlHandlePool();
+  ~CurlHandlePool();
+
+  // Non-copyable
+  CurlHandlePool(const CurlHandlePool&) = delete;
+  CurlHandlePool& operator=(const CurlHandlePool&) = delete;
+
+  // ~ Public Interface
+
+  // Process-wide pool used by Http
+  static CurlHandlePool& Instance();
+
+  // Handle with all options reset except the share attachment
+  Handle Acquire(std::string_view url);
+
+  CurlPoolMetrics GetMetrics() const;
+
+  size_t IdleCount() const;
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  CURL* CreateHandle();
+  void Release(std::string origin, CURL* curl);
+  void Attach(CURL* curl);
+
+  static void LockShared(CURL*, curl_lock_data data, curl_lock_access, void* pool);
+  static void UnlockShared(CURL*, curl_lock_data data, void* pool);
+
+ private:
+  CURLSH* share_;
+  // One mutex per curl_lock_data kind
+  std::mutex share_mutexes_[CURL_LOCK_DATA_LAST];
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::vector<CURL*>> idle_;
+
+  std::atomic<size_t> hits_ = 0;
+  std::atomic<size_t> misses_ = 0;
+  std::atomic<size_t> evictions_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
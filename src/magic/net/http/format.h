@@ -46,7 +46,8 @@ struct fmt::formatter<magic::HttpRequestMetrics> {
 
   template <typename FormatContext>
   auto format(magic::HttpRequestMetrics m, FormatContext& ctx) const {  // NOLINT
-    return fmt::format_to(ctx.out(), "[{} Bytes] (~{}ms)", m.DownloadBytes, m.Duration.Milleseconds());
+    return fmt::format_to(ctx.out(), "[{} Bytes] (~{}ms, ttfb ~{}ms)", m.DownloadBytes,
+                          m.Duration.Milleseconds(), m.StartTransfer.Milleseconds());
   }
 };
 
@@ -59,11 +60,11 @@ struct fmt::formatter<magic::HttpHeader> {
   }
 
   template <typename FormatContext>
-  auto format(magic::HttpHeader header, FormatContext& ctx) const {  // NOLINT
+  auto format(const magic::HttpHeader& header, FormatContext& ctx) const {  // NOLINT
     auto builder = magic::StringBuilder();
     for (auto&& [key, value] : header) {
       builder << key << ": " << value << '\n';
     }
-    return fmt::format_to(ctx.out(), "{}", builder.ToString());
+    return fmt::format_to(ctx.out(), "{}", builder.View());
   }
 };
\ No newline at end of file
@@ -1,21 +1,78 @@
-#include <magic/common/string_reader.h>
 #include <magic/net/http/header.h>
 
 namespace magic {
 
-HttpHeader HttpHeader::Parse(std::string_view s) {
-  auto dictionary = Dictionary();
-  auto reader = StringReader(s);
+//////////////////////////////////////////////////////////////////////
 
-  reader.SkipUntil("HTTP").SkipLine();
+namespace {
 
-  while (reader.SkipSpaces().HasNext()) {
-    auto key = reader.ReadUntil(':');
-    auto value = reader.SkipOne().SkipSpaces().ReadToEndLine();
-    dictionary[std::string(key)] = value;
+bool IsBlank(char ch) {
+  return ch == ' ' || ch == '\t' || ch == '\r';
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+HttpHeader HttpHeader::Parse(std::string raw) {
+  auto header = HttpHeader(std::move(raw));
+  const std::string_view source = header.raw_;
+
+  size_t line_begin = 0;
+  while (line_begin < source.size()) {
+    auto line_end = source.find('\n', line_begin);
+    if (line_end == std::string_view::npos) {
+      line_end = source.size();
+    }
+
+    auto begin = line_begin;
+    auto end = line_end;
+    line_begin = line_end + 1;
+
+    while (begin < end && IsBlank(source[begin])) {
+      ++begin;
+    }
+    while (end > begin && IsBlank(source[end - 1])) {
+      --end;
+    }
+
+    const auto line = source.substr(begin, end - begin);
+    if (line.starts_with("HTTP/")) {
+      // Status line of the next response in the block
+      header.fields_.clear();
+      continue;
+    }
+
+    const auto colon = line.find(':');
+    if (colon == std::string_view::npos || colon == 0) {
+      continue;
+    }
+
+    auto value_begin = begin + colon + 1;
+    while (value_begin < end && IsBlank(source[value_begin])) {
+      ++value_begin;
+    }
+
+    header.fields_.push_back(Field{static_cast<uint32_t>(begin), static_cast<uint32_t>(colon),
+                                   static_cast<uint32_t>(value_begin),
+                                   static_cast<uint32_t>(end - value_begin)});
   }
 
-  return HttpHeader(std::move(dictionary));
+  return header;
 }
 
+std::optional<std::string_view> HttpHeader::Find(std::string_view name) const {
+  // Backwards: the last of the repeated fields wins
+  for (auto it = fields_.rbegin(); it != fields_.rend(); ++it) {
+    const auto& field = *it;
+    if (field.name_length == name.size() &&
+        detail::EqualsIgnoreCase(Slice(field.name_offset, field.name_length), name)) {
+      return Slice(field.value_offset, field.value_length);
+    }
+  }
+  return std::nullopt;
+}
+
+//////////////////////////////////////////////////////////////////////
+
 }  // namespace magic
@@ -1,37 +1,146 @@
 #pragma once
 
-#include <magic/common/dictionary.h>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace magic {
 
 //////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+inline char ToLowerAscii(char ch) {
+  return (ch >= 'A' && ch <= 'Z') ? static_cast<char>(ch | 0x20) : ch;
+}
+
+// Header names are ASCII tokens
+inline bool EqualsIgnoreCase(std::string_view lhs, std::string_view rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t index = 0; index < lhs.size(); ++index) {
+    if (lhs[index] != rhs[index] && ToLowerAscii(lhs[index]) != ToLowerAscii(rhs[index])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace detail
+
+//////////////////////////////////////////////////////////////////////
+
+// Response header fields over a single copy of the raw header block
+// Fields are offset/length pairs into the block, names are matched
+// case-insensitively by a linear scan: responses carry a couple of dozen
+// fields at most, comparing lengths first rejects almost all of them
+
+// Only the fields of the last response are kept, the header block of
+// a redirected or 100-continue transfer contains several of them
+
 class HttpHeader final {
+  struct Field {
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint32_t value_offset;
+    uint32_t value_length;
+  };
+
+  static const size_t kExpectedFields = 16;
+
  public:
-  static HttpHeader Parse(std::string_view s);
+  using Entry = std::pair<std::string_view, std::string_view>;
+
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Entry;
+
+    Iterator(const HttpHeader* header, size_t index) : header_(header), index_(index) {
+    }
+
+    Entry operator*() const {
+      return header_->EntryAt(index_);
+    }
+
+    Iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      auto copy = *this;
+      ++index_;
+      return copy;
+    }
 
-  std::string_view operator[](std::string_view value) {
-    const auto it = dictionary_.find(value);
-    if (it != dictionary_.end()) {
-      return it->second;
+    bool operator==(const Iterator& that) const {
+      return index_ == that.index_;
     }
-    return {};
+
+   private:
+    const HttpHeader* header_;
+    size_t index_;
+  };
+
+  static HttpHeader Parse(std::string raw);
+
+  // Value of the last field with the name, empty if there is none
+  // A repeated field overrides the earlier ones, iterate to see them all
+  std::string_view operator[](std::string_view name) const {
+    return Find(name).value_or(std::string_view{});
   }
 
-  auto begin() {
-    return dictionary_.begin();
+  std::optional<std::string_view> Find(std::string_view name) const;
+
+  bool Contains(std::string_view name) const {
+    return Find(name).has_value();
   }
 
-  auto end() {
-    return dictionary_.end();
+  size_t Size() const {
+    return fields_.size();
+  }
+
+  bool IsEmpty() const {
+    return fields_.empty();
+  }
+
+  Iterator begin() const {
+    return {this, 0};
+  }
+
+  Iterator end() const {
+    return {this, fields_.size()};
   }
 
  private:
-  explicit HttpHeader(Dictionary dictionary) : dictionary_(std::move(dictionary)) {
+  explicit HttpHeader(std::string raw) : raw_(std::move(raw)) {
+    fields_.reserve(kExpectedFields);
+  }
+
+  std::string_view Slice(uint32_t offset, uint32_t length) const {
+    return std::string_view(raw_).substr(offset, length);
+  }
+
+  Entry EntryAt(size_t index) const {
+    const auto& field = fields_[index];
+    return {Slice(field.name_offset, field.name_length),
+            Slice(field.value_offset, field.value_length)};
   }
 
  private:
-  Dictionary dictionary_;
+  std::string raw_;
+  std::vector<Field> fields_;
 };
 
+//////////////////////////////////////////////////////////////////////
+
 }  // namespace magic
@@ -0,0 +1,98 @@
+#include <magic/net/http/latency.h>
+#include <magic/net/http/curl_pool.h>
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+Duration FromNanos(double nanos) {
+  return Duration(nanos / 1e9);
+}
+
+HttpLatencySummary Summarize(const HistogramSnapshot& snapshot) {
+  if (snapshot.Count() == 0) {
+    return {};
+  }
+  return {.Count = snapshot.Count(),
+          .Mean = FromNanos(snapshot.Mean()),
+          .P50 = FromNanos(snapshot.Percentile(50)),
+          .P90 = FromNanos(snapshot.Percentile(90)),
+          .P99 = FromNanos(snapshot.Percentile(99)),
+          .Max = FromNanos(snapshot.Max())};
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+HttpLatencyRegistry& HttpLatencyRegistry::Instance() {
+  static HttpLatencyRegistry registry;
+  return registry;
+}
+
+void HttpLatencyRegistry::Record(std::string_view url, Duration latency) {
+  GetHistogram(detail::OriginOf(url)).Record(latency);
+}
+
+HttpLatencySummary HttpLatencyRegistry::Summary(std::string_view url) const {
+  return Summarize(Snapshot(url));
+}
+
+HistogramSnapshot HttpLatencyRegistry::Snapshot(std::string_view url) const {
+  const Histogram* histogram = nullptr;
+  {
+    std::shared_lock guard(mutex_);
+    auto it = hosts_.find(detail::OriginOf(url));
+    if (it == hosts_.end()) {
+      return {};
+    }
+    histogram = it->second.get();
+  }
+  // Histograms are never removed, summed up outside of the lock
+  return histogram->Snapshot();
+}
+
+std::vector<std::string> HttpLatencyRegistry::Origins() const {
+  std::vector<std::string> origins;
+  std::shared_lock guard(mutex_);
+  for (auto&& [origin, _] : hosts_) {
+    origins.push_back(origin);
+  }
+  std::sort(origins.begin(), origins.end());
+  return origins;
+}
+
+void HttpLatencyRegistry::Reset() {
+  // Clears the histograms in place, the map itself is only read
+  std::shared_lock guard(mutex_);
+  for (auto&& [_, histogram] : hosts_) {
+    histogram->Reset();
+  }
+}
+
+Histogram& HttpLatencyRegistry::GetHistogram(std::string_view origin) {
+  {
+    std::shared_lock guard(mutex_);
+    if (auto it = hosts_.find(origin); it != hosts_.end()) {
+      return *it->second;
+    }
+  }
+
+  // First request to the origin, another thread may have added it meanwhile
+  std::lock_guard guard(mutex_);
+  auto [it, inserted] = hosts_.try_emplace(std::string(origin));
+  if (inserted) {
+    it->second = std::make_unique<Histogram>();
+  }
+  return *it->second;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <magic/common/dictionary.h>
+#include <magic/common/histogram.h>
+#include <magic/common/time.h>
+#include <magic/concurrency/shared_mutex.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct HttpLatencySummary {
+  size_t Count = 0;
+  Duration Mean{};
+  Duration P50{};
+  Duration P90{};
+  Duration P99{};
+  Duration Max{};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Process-wide latencies of completed requests per origin, one Histogram
+// of nanoseconds each
+// Filled by every request made through Http and HttpClient
+// Recording takes a shared lock and a lookup without allocation, the
+// exclusive lock only for the first request to an origin
+
+class HttpLatencyRegistry final {
+ public:
+  static HttpLatencyRegistry& Instance();
+
+  // ~ Public Interface
+
+  // Origin of the url: scheme://host:port
+  void Record(std::string_view url, Duration latency);
+
+  // Empty summary if the origin has not been seen
+  HttpLatencySummary Summary(std::string_view url) const;
+
+  // Full distribution of the origin, for merging and export
+  HistogramSnapshot Snapshot(std::string_view url) const;
+
+  std::vector<std::string> Origins() const;
+
+  void Reset();
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  Histogram& GetHistogram(std::string_view origin);
+
+ private:
+  mutable SharedMutex mutex_;
+  // Histograms are never removed, Reset clears them in place
+  // Guarded by mutex_
+  std::unordered_map<std::string, std::unique_ptr<Histogram>, detail::StringHash,
+                     std::equal_to<>>
+      hosts_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -9,6 +9,7 @@
 #include <magic/net/http/status.h>
 #include <magic/net/http/response.h>
 #include <magic/net/http/error.h>
+#include <magic/net/http/transfer.h>
 
 namespace magic {
 
@@ -52,14 +53,8 @@ class HttpRequest final {
 
 
   Result<HttpResponse> Run() {
-    auto content = std::string();
-    auto header = std::string();
-
-    curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, detail::WriteFunction);
-    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, &content);
-
-    curl_easy_setopt(curl_, CURLOPT_HEADERFUNCTION, detail::WriteFunction);
-    curl_easy_setopt(curl_, CURLOPT_HEADERDATA, &header);
+    detail::ResponseBuffers response;
+    detail::SetupTransfer(curl_, &response);
 
     const auto result = curl_easy_perform(curl_);
 
@@ -67,32 +62,8 @@ class HttpRequest final {
       return Fail(curl::easy::make_error_code(result));
     }
 
-    int64_t response_code;
-    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &response_code);
-
-    double total_time;
-    curl_easy_getinfo(curl_, CURLINFO_TOTAL_TIME, &total_time);
-    auto elapsed = ToTimeSpan(total_time);
-
-    char* url_string{nullptr};
-    curl_easy_getinfo(curl_, CURLINFO_EFFECTIVE_URL, &url_string);
-
-    // Metrics
-
-    double downloaded, uploaded, average_download_speed, average_upload_speed;
-    curl_easy_getinfo(curl_, CURLINFO_SIZE_DOWNLOAD, &downloaded);
-    curl_easy_getinfo(curl_, CURLINFO_SIZE_UPLOAD, &uploaded);
-    curl_easy_getinfo(curl_, CURLINFO_SPEED_DOWNLOAD, &average_download_speed);
-    curl_easy_getinfo(curl_, CURLINFO_SPEED_UPLOAD, &average_upload_speed);
-
-    auto metrics = HttpRequestMetrics{.DownloadBytes = downloaded,
-                                      .UploadBytes = uploaded,
-                                      .AverageDownloadSpeed = average_download_speed,
-                                      .AverageUploadSpeed = average_upload_speed,
-                                      .Duration = elapsed};
-
-    return Ok(HttpResponse{HttpStatus::FromStatusCode(response_code), HttpHeader::Parse(header),
-                           std::move(metrics), std::string(url_string), std::move(content)});
+    return Ok(detail::CollectResponse(curl_, std::move(response.header),
+                                      std::move(response.content)));
   }
 
  private:
@@ -39,7 +39,34 @@ class HttpRequestBuilder final {
     return *this;
   }
 
+  // Per-request timeouts, see HttpTimeouts
+  // An expired timeout fails Run with CURLE_OPERATION_TIMEDOUT
+
+  HttpRequestBuilder& SetConnectTimeout(Duration timeout) {
+    timeouts_.Connect = timeout;
+    return *this;
+  }
+
+  HttpRequestBuilder& SetTimeout(Duration timeout) {
+    timeouts_.Total = timeout;
+    return *this;
+  }
+
+  // Aborts the transfer once it stays below bytes_per_second for the window
+  HttpRequestBuilder& SetLowSpeedLimit(size_t bytes_per_second, Duration window) {
+    timeouts_.LowSpeedLimit = bytes_per_second;
+    timeouts_.LowSpeedTime = window;
+    return *this;
+  }
+
+  HttpRequestBuilder& SetTimeouts(HttpTimeouts timeouts) {
+    timeouts_ = timeouts;
+    return *this;
+  }
+
   HttpRequest Build() {
+    detail::ApplyTimeouts(curl_, timeouts_);
+
     auto curl = std::exchange(curl_, nullptr);
 
     return Ok(HttpRequest(curl));
@@ -73,6 +100,7 @@ class HttpRequestBuilder final {
   CURLcode result_;
   std::string url_;
   std::string content_;
+  HttpTimeouts timeouts_;
 };
 
 }  // namespace magic
\ No newline at end of file
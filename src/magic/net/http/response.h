@@ -12,6 +12,16 @@ struct HttpRequestMetrics {
   double AverageDownloadSpeed;
   double AverageUploadSpeed;
   TimeSpan Duration;
+
+  // Phases of the transfer, each measured from the start of the request
+  // (as reported by curl), so every phase includes the previous ones
+  TimeSpan NameLookup;     // DNS resolved
+  TimeSpan Connect;        // TCP connected
+  TimeSpan AppConnect;     // TLS handshake done, zero for plain HTTP
+  TimeSpan PreTransfer;    // Ready to send the request
+  TimeSpan StartTransfer;  // First response byte, time to first byte
+  TimeSpan Redirect;       // Spent in redirects before the final request
+  int64_t RedirectCount;
 };
 
 class HttpResponse final {
@@ -37,6 +47,15 @@ class HttpResponse final {
     return header_;
   }
 
+  const HttpRequestMetrics& GetMetrics() const {
+    return metrics_;
+  }
+
+  // Url of the final request, after redirects
+  const std::string& GetUrl() const {
+    return url_;
+  }
+
   const std::string& GetContent() const {
     return content_;
   }
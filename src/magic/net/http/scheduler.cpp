@@ -0,0 +1,318 @@
+#include <magic/net/http/scheduler.h>
+#include <magic/net/http/curl_pool.h>
+
+#include <magic/common/random.h>
+#include <magic/executors/inline.h>
+#include <magic/futures/after.h>
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct HttpRequestScheduler::Host {
+  static const size_t kWindow = 128;
+  static const size_t kMinSamples = 16;
+
+  explicit Host(size_t permits) : semaphore(permits) {
+  }
+
+  void Record(Duration latency) {
+    std::lock_guard guard(mutex);
+    if (latencies.size() < kWindow) {
+      latencies.push_back(latency.count());
+    } else {
+      latencies[next] = latency.count();
+    }
+    next = (next + 1) % kWindow;
+  }
+
+  // Quantile over the last kWindow successful requests
+  Duration Quantile(double quantile, Duration fallback) {
+    std::vector<double> samples;
+    {
+      std::lock_guard guard(mutex);
+      if (latencies.size() < kMinSamples) {
+        return fallback;
+      }
+      samples = latencies;
+    }
+    const auto index = static_cast<size_t>(quantile * (samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return Duration(samples[index]);
+  }
+
+  futures::AsyncSemaphore semaphore;
+
+  std::mutex mutex;
+  std::vector<double> latencies;  // Guarded by mutex
+  size_t next = 0;                // Guarded by mutex
+};
+
+//////////////////////////////////////////////////////////////////////
+
+struct HttpRequestScheduler::Call {
+  Call(std::string u, Host& h, Promise<HttpResponse> p)
+      : url(std::move(u)), host(h), promise(std::move(p)) {
+  }
+
+  const std::string url;
+  Host& host;
+
+  std::mutex mutex;
+  std::optional<Promise<HttpResponse>> promise;  // Empty once completed
+  size_t round = 0;       // Attempt number, a retry starts the next round
+  size_t in_flight = 0;   // Copies of the current round
+  bool hedged = false;    // The current round has sent its backup copy
+  size_t hedge_timer = 0; // Round + 1 of the armed hedge timer, 0 if detached
+  std::vector<uint64_t> calls;
+  std::optional<Result<HttpResponse>> last_failure;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+bool IsSuccess(const Result<HttpResponse>& result) {
+  return result.IsOk() && static_cast<int>(result->GetStatus().Value) < 500;
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+HttpRequestScheduler::HttpRequestScheduler(HttpSchedulerOptions options, HttpClient& client)
+    : options_(options), client_(client) {
+}
+
+HttpRequestScheduler::~HttpRequestScheduler() {
+  outstanding_.Wait();
+}
+
+Future<HttpResponse> HttpRequestScheduler::Get(std::string url) {
+  return Get(GetInlineExecutor(), std::move(url));
+}
+
+Future<HttpResponse> HttpRequestScheduler::Get(IExecutor& executor, std::string url) {
+  auto [f, p] = MakeContractVia<HttpResponse>(executor);
+
+  auto& host = GetHost(url);
+  auto call = std::make_shared<Call>(std::move(url), host, std::move(p));
+
+  requests_.fetch_add(1, std::memory_order::relaxed);
+  outstanding_.Add();
+  StartAttempt(std::move(call));
+
+  return std::move(f);
+}
+
+std::vector<Future<HttpResponse>> HttpRequestScheduler::FanOut(
+    IExecutor& executor, const std::vector<std::string>& urls) {
+  std::vector<Future<HttpResponse>> responses;
+  responses.reserve(urls.size());
+  for (auto&& url : urls) {
+    responses.push_back(Get(executor, url));
+  }
+  return responses;
+}
+
+Duration HttpRequestScheduler::HedgeDelay(std::string_view url) {
+  return GetHost(url).Quantile(options_.HedgeQuantile, options_.DefaultHedgeDelay);
+}
+
+HttpSchedulerMetrics HttpRequestScheduler::GetMetrics() const {
+  return {.Requests = requests_.load(),
+          .Hedges = hedges_.load(),
+          .HedgeWins = hedge_wins_.load(),
+          .Retries = retries_.load(),
+          .Failures = failures_.load()};
+}
+
+HistogramSnapshot HttpRequestScheduler::GetLatency() const {
+  return latency_.Snapshot();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+HttpRequestScheduler::Host& HttpRequestScheduler::GetHost(std::string_view url) {
+  const auto origin = std::string(detail::OriginOf(url));
+
+  std::lock_guard guard(mutex_);
+  auto& host = hosts_[origin];
+  if (!host) {
+    host = std::make_unique<Host>(options_.MaxInFlightPerHost);
+  }
+  return *host;
+}
+
+void HttpRequestScheduler::StartAttempt(std::shared_ptr<Call> call) {
+  size_t round;
+  {
+    std::lock_guard guard(call->mutex);
+    round = call->round;
+    call->hedged = false;
+  }
+
+  Send(call, /*hedge=*/false);
+  if (options_.Hedging) {
+    ScheduleHedge(std::move(call), round);
+  }
+}
+
+void HttpRequestScheduler::Send(std::shared_ptr<Call> call, bool hedge) {
+  {
+    std::lock_guard guard(call->mutex);
+    ++call->in_flight;
+  }
+  outstanding_.Add();
+
+  auto& semaphore = call->host.semaphore;
+  semaphore.Acquire().Subscribe([this, call, hedge](Result<Unit>) mutable {
+    {
+      std::lock_guard guard(call->mutex);
+      if (!call->promise) {
+        // Completed while waiting for the permit
+        --call->in_flight;
+        call->host.semaphore.Release();
+        outstanding_.Done();
+        return;
+      }
+    }
+
+    const auto started = Clock::now();
+    auto [id, response] = client_.StartGet(GetInlineExecutor(), call->url);
+    {
+      std::lock_guard guard(call->mutex);
+      call->calls.push_back(id);
+    }
+
+    std::move(response).Subscribe(
+        [this, call, id, hedge, started](Result<HttpResponse> result) mutable {
+          OnResult(std::move(call), id, hedge, started, std::move(result));
+        });
+  });
+}
+
+void HttpRequestScheduler::ScheduleHedge(std::shared_ptr<Call> call, size_t round) {
+  const auto delay = call->host.Quantile(options_.HedgeQuantile, options_.DefaultHedgeDelay);
+
+  {
+    std::lock_guard guard(call->mutex);
+    call->hedge_timer = round + 1;
+  }
+  outstanding_.Add();
+
+  futures::After(delay).Subscribe([this, call = std::move(call), round](Result<Unit>) mutable {
+    bool send = false;
+    {
+      std::lock_guard guard(call->mutex);
+      if (call->hedge_timer != round + 1) {
+        // Detached by DetachHedgeTimer, the scheduler may be gone already
+        return;
+      }
+      call->hedge_timer = 0;
+      // The first copy has not completed yet
+      if (call->promise && !call->hedged && call->in_flight > 0) {
+        call->hedged = true;
+        send = true;
+      }
+    }
+    if (send) {
+      hedges_.fetch_add(1, std::memory_order::relaxed);
+      Send(std::move(call), /*hedge=*/true);
+    }
+    outstanding_.Done();
+  });
+}
+
+void HttpRequestScheduler::OnResult(std::shared_ptr<Call> call, uint64_t id, bool hedge,
+                                    Timestamp started, Result<HttpResponse> result) {
+  call->host.semaphore.Release();
+
+  const bool success = IsSuccess(result);
+  std::optional<Promise<HttpResponse>> promise;
+  std::vector<uint64_t> losers;
+  bool retry = false;
+  bool detached = false;
+
+  {
+    std::lock_guard guard(call->mutex);
+    --call->in_flight;
+    std::erase(call->calls, id);
+
+    if (!call->promise) {
+      // Lost the race or cancelled
+    } else if (success) {
+      promise = std::exchange(call->promise, std::nullopt);
+      losers.swap(call->calls);
+      detached = DetachHedgeTimer(*call);
+    } else {
+      call->last_failure.emplace(std::move(result));
+      if (call->in_flight > 0) {
+        // The other copy may still succeed
+      } else if (call->round + 1 < options_.MaxAttempts) {
+        ++call->round;
+        retry = true;
+        detached = DetachHedgeTimer(*call);
+      } else {
+        promise = std::exchange(call->promise, std::nullopt);
+        result = std::move(*call->last_failure);
+        detached = DetachHedgeTimer(*call);
+      }
+    }
+  }
+
+  if (detached) {
+    outstanding_.Done();  // Hedge timer
+  }
+
+  if (retry) {
+    retries_.fetch_add(1, std::memory_order::relaxed);
+    outstanding_.Add();
+    futures::After(Backoff(call->round - 1))
+        .Subscribe([this, call = std::move(call)](Result<Unit>) mutable {
+          StartAttempt(std::move(call));
+          outstanding_.Done();
+        });
+  }
+
+  if (promise) {
+    if (success) {
+      const auto latency = Clock::now() - started;
+      call->host.Record(latency);
+      latency_.Record(latency);
+      if (hedge) {
+        hedge_wins_.fetch_add(1, std::memory_order::relaxed);
+      }
+      for (auto loser : losers) {
+        client_.Cancel(loser);
+      }
+    } else {
+      failures_.fetch_add(1, std::memory_order::relaxed);
+    }
+    std::move(*promise).Set(std::move(result));
+    outstanding_.Done();  // Call
+  }
+
+  outstanding_.Done();  // Copy
+}
+
+// Context: call->mutex is locked
+// A pending hedge timer stops referring to the scheduler, so that
+// the destructor does not wait for hedge delays of completed calls
+bool HttpRequestScheduler::DetachHedgeTimer(Call& call) {
+  return std::exchange(call.hedge_timer, 0) != 0;
+}
+
+Duration HttpRequestScheduler::Backoff(size_t retry) const {
+  const auto cap = std::min(options_.MaxBackoff.count(),
+                            options_.BaseBackoff.count() * std::pow(2.0, retry));
+  return Duration(cap * Random::NextDouble());
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <magic/common/histogram.h>
+#include <magic/common/time.h>
+#include <magic/concurrency/blocking_wait_group.h>
+#include <magic/futures/semaphore.h>
+#include <magic/net/http/client.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+struct HttpSchedulerOptions {
+  // Requests in flight per origin, hedges and retries included
+  size_t MaxInFlightPerHost = 8;
+
+  // A backup copy is sent when the first one has not completed within
+  // the HedgeQuantile latency of the origin, the first success wins
+  bool Hedging = true;
+  double HedgeQuantile = 0.95;
+  // Until the origin has enough samples
+  Duration DefaultHedgeDelay = std::chrono::milliseconds(50);
+
+  // Transport errors and 5xx responses are retried with full jitter:
+  // a uniform delay in [0, min(MaxBackoff, BaseBackoff * 2^retry))
+  size_t MaxAttempts = 3;
+  Duration BaseBackoff = std::chrono::milliseconds(20);
+  Duration MaxBackoff = std::chrono::seconds(1);
+};
+
+struct HttpSchedulerMetrics {
+  size_t Requests;
+  size_t Hedges;
+  size_t HedgeWins;
+  size_t Retries;
+  size_t Failures;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Client-side request scheduler on top of HttpClient
+// - Per-origin concurrency limit through an AsyncSemaphore: excess requests
+//   wait for a permit without holding a thread
+// - Hedged requests: the losing copy is cancelled as soon as one succeeds
+// - Retries with jittered exponential backoff
+
+// Usage:
+// HttpRequestScheduler scheduler{{.MaxInFlightPerHost = 4}};
+// auto responses = scheduler.FanOut(pool, replica_urls);
+
+class HttpRequestScheduler final {
+  struct Host;
+  struct Call;
+
+ public:
+  explicit HttpRequestScheduler(HttpSchedulerOptions options = {},
+                                HttpClient& client = HttpClient::Default());
+  ~HttpRequestScheduler();
+
+  // Non-copyable
+  HttpRequestScheduler(const HttpRequestScheduler&) = delete;
+  HttpRequestScheduler& operator=(const HttpRequestScheduler&) = delete;
+
+  // ~ Public Interface
+
+  Future<HttpResponse> Get(IExecutor& executor, std::string url);
+  Future<HttpResponse> Get(std::string url);
+
+  // One future per url, in the same order
+  std::vector<Future<HttpResponse>> FanOut(IExecutor& executor,
+                                           const std::vector<std::string>& urls);
+
+  // Current hedge delay of the origin of the url
+  Duration HedgeDelay(std::string_view url);
+
+  HttpSchedulerMetrics GetMetrics() const;
+
+  // Nanoseconds from sending the winning copy to its successful response
+  HistogramSnapshot GetLatency() const;
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  Host& GetHost(std::string_view url);
+
+  void StartAttempt(std::shared_ptr<Call> call);
+  void Send(std::shared_ptr<Call> call, bool hedge);
+  void ScheduleHedge(std::shared_ptr<Call> call, size_t attempt);
+  void OnResult(std::shared_ptr<Call> call, uint64_t id, bool hedge, Timestamp started,
+                Result<HttpResponse> result);
+
+  static bool DetachHedgeTimer(Call& call);
+  Duration Backoff(size_t retry) const;
+
+ private:
+  const HttpSchedulerOptions options_;
+  HttpClient& client_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::unique_ptr<Host>> hosts_;  // Guarded by mutex_
+
+  std::atomic<size_t> requests_ = 0;
+  std::atomic<size_t> hedges_ = 0;
+  std::atomic<size_t> hedge_wins_ = 0;
+  std::atomic<size_t> retries_ = 0;
+  std::atomic<size_t> failures_ = 0;
+  Histogram latency_;
+
+  // Calls, copies in flight and armed timers, all of them refer to the scheduler
+  // The destructor waits on it, so Done is the last access of a callback
+  BlockingWaitGroup outstanding_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,286 @@
+#include <magic/net/http/server.h>
+
+#include <magic/common/result/make.h>
+#include <magic/fibers/api.h>
+
+#include <fmt/core.h>
+
+#include <charconv>
+#include <iterator>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+const size_t kReadChunk = 16 * 1024;
+const size_t kMaxHeaderSize = 64 * 1024;
+const size_t kMaxBodySize = 16 * 1024 * 1024;
+
+enum class ParseStatus {
+  Complete,
+  Incomplete,
+  Malformed,
+  TooLarge,
+  Unsupported,
+};
+
+std::string_view TrimBlanks(std::string_view s) {
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+// Parses one request from the front of the buffer
+// On success size is the number of bytes the request occupies
+ParseStatus ParseRequest(std::string_view buffer, HttpServerRequest& request, size_t& size) {
+  const auto header_end = buffer.find("\r\n\r\n");
+  if (header_end == std::string_view::npos) {
+    return buffer.size() > kMaxHeaderSize ? ParseStatus::TooLarge : ParseStatus::Incomplete;
+  }
+
+  auto head = buffer.substr(0, header_end + 2);
+
+  // Request line
+  auto line_end = head.find("\r\n");
+  auto line = head.substr(0, line_end);
+  head.remove_prefix(line_end + 2);
+
+  const auto method_end = line.find(' ');
+  const auto target_end = line.find(' ', method_end + 1);
+  if (method_end == std::string_view::npos || target_end == std::string_view::npos) {
+    return ParseStatus::Malformed;
+  }
+  request.Method = line.substr(0, method_end);
+  request.Target = line.substr(method_end + 1, target_end - method_end - 1);
+  request.Version = line.substr(target_end + 1);
+  if (!request.Version.starts_with("HTTP/1.")) {
+    return ParseStatus::Malformed;
+  }
+
+  // Fields
+  request.Headers.clear();
+  while (!head.empty()) {
+    line_end = head.find("\r\n");
+    line = head.substr(0, line_end);
+    head.remove_prefix(line_end + 2);
+
+    const auto colon = line.find(':');
+    if (colon == std::string_view::npos || colon == 0) {
+      return ParseStatus::Malformed;
+    }
+    request.Headers.emplace_back(line.substr(0, colon), TrimBlanks(line.substr(colon + 1)));
+  }
+
+  if (!request.Header("Transfer-Encoding").empty()) {
+    return ParseStatus::Unsupported;
+  }
+
+  size_t content_length = 0;
+  if (auto value = request.Header("Content-Length"); !value.empty()) {
+    auto [_, ec] = std::from_chars(value.data(), value.data() + value.size(), content_length);
+    if (ec != std::errc{}) {
+      return ParseStatus::Malformed;
+    }
+    if (content_length > kMaxBodySize) {
+      return ParseStatus::TooLarge;
+    }
+  }
+
+  const auto body_begin = header_end + 4;
+  if (buffer.size() < body_begin + content_length) {
+    return ParseStatus::Incomplete;
+  }
+
+  request.Body = buffer.substr(body_begin, content_length);
+  size = body_begin + content_length;
+  return ParseStatus::Complete;
+}
+
+bool IsKeepAlive(const HttpServerRequest& request) {
+  const auto connection = request.Header("Connection");
+  if (request.Version == "HTTP/1.0") {
+    return detail::EqualsIgnoreCase(connection, "keep-alive");
+  }
+  return !detail::EqualsIgnoreCase(connection, "close");
+}
+
+void AppendResponse(std::string& out, const HttpServerResponse& response, bool keep_alive) {
+  fmt::format_to(std::back_inserter(out),
+                 "HTTP/1.1 {}\r\nContent-Type: {}\r\nContent-Length: {}\r\n{}\r\n",
+                 HttpStatus{response.Status}.ToString(), response.ContentType,
+                 response.Body.size(), keep_alive ? "" : "Connection: close\r\n");
+  out.append(response.Body);
+}
+
+HttpServerResponse ErrorResponse(HttpStatus::Code status) {
+  return {.Status = status, .ContentType = "text/plain", .Body = HttpStatus{status}.ToString()};
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+std::string_view HttpServerRequest::Header(std::string_view name) const {
+  for (auto&& [key, value] : Headers) {
+    if (detail::EqualsIgnoreCase(key, name)) {
+      return value;
+    }
+  }
+  return {};
+}
+
+//////////////////////////////////////////////////////////////////////
+
+HttpServer::HttpServer(IExecutor& scheduler, HttpHandler handler)
+    : scheduler_(scheduler), handler_(std::move(handler)) {
+}
+
+HttpServer::~HttpServer() {
+  Stop();
+}
+
+Status HttpServer::Start(std::string_view host, uint16_t port) {
+  auto status = acceptor_.Listen(host, port);
+  if (status.HasError()) {
+    return status;
+  }
+
+  started_ = true;
+  fibers_.Add();
+  Go(scheduler_, [this] {
+    AcceptLoop();
+    fibers_.Done();
+  });
+  return Ok();
+}
+
+void HttpServer::Stop() {
+  if (!started_) {
+    return;
+  }
+  {
+    std::lock_guard guard(mutex_);
+    if (stopping_) {
+      return;
+    }
+    stopping_ = true;
+    for (auto socket : connections_) {
+      socket->Shutdown();
+    }
+  }
+  acceptor_.Shutdown();
+
+  fibers_.Wait();
+  acceptor_.Close();
+}
+
+size_t HttpServer::ActiveConnections() const {
+  std::lock_guard guard(mutex_);
+  return connections_.size();
+}
+
+void HttpServer::AcceptLoop() {
+  while (true) {
+    auto socket = acceptor_.Accept();
+    if (socket.HasError()) {
+      return;  // Shutdown
+    }
+
+    fibers_.Add();
+    Go(scheduler_, [this, socket = std::move(*socket)]() mutable {
+      if (Track(&socket)) {
+        Serve(socket);
+        Untrack(&socket);
+      }
+      socket.Close();
+      // Last access to the server
+      fibers_.Done();
+    });
+  }
+}
+
+void HttpServer::Serve(net::Socket& socket) {
+  std::string in;
+  std::string out;
+  size_t filled = 0;
+  HttpServerRequest request;
+
+  bool keep_alive = true;
+  while (keep_alive) {
+    // Handle every complete request in the buffer
+    size_t consumed = 0;
+    while (keep_alive) {
+      size_t size = 0;
+      const auto status =
+          ParseRequest(std::string_view(in.data() + consumed, filled - consumed), request, size);
+
+      if (status == ParseStatus::Incomplete) {
+        break;
+      }
+      if (status != ParseStatus::Complete) {
+        const auto code = status == ParseStatus::TooLarge      ? HttpStatus::Code::PayloadTooLarge
+                          : status == ParseStatus::Unsupported ? HttpStatus::Code::NotImplemented
+                                                               : HttpStatus::Code::BadRequest;
+        AppendResponse(out, ErrorResponse(code), false);
+        keep_alive = false;
+        break;
+      }
+
+      keep_alive = IsKeepAlive(request);
+      try {
+        AppendResponse(out, handler_(request), keep_alive);
+      } catch (...) {
+        AppendResponse(out, ErrorResponse(HttpStatus::Code::InternalServerError), keep_alive);
+      }
+      consumed += size;
+    }
+
+    if (!out.empty()) {
+      if (socket.WriteAll(out).HasError()) {
+        return;
+      }
+      out.clear();
+    }
+    if (!keep_alive) {
+      socket.ShutdownWrite();
+      return;
+    }
+
+    // Keep the partial request at the front
+    in.erase(0, consumed);
+    filled -= consumed;
+
+    if (in.size() < filled + kReadChunk) {
+      in.resize(filled + kReadChunk);
+    }
+    auto bytes = socket.ReadSome(in.data() + filled, in.size() - filled);
+    if (bytes.HasError() || *bytes == 0) {
+      return;
+    }
+    filled += *bytes;
+  }
+}
+
+bool HttpServer::Track(net::Socket* socket) {
+  std::lock_guard guard(mutex_);
+  if (stopping_) {
+    return false;
+  }
+  connections_.insert(socket);
+  return true;
+}
+
+void HttpServer::Untrack(net::Socket* socket) {
+  std::lock_guard guard(mutex_);
+  connections_.erase(socket);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
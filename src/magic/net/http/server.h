@@ -0,0 +1,107 @@
+#pragma once
+
+#include <magic/concurrency/blocking_wait_group.h>
+#include <magic/executors/executor.h>
+#include <magic/net/http/header.h>
+#include <magic/net/http/status.h>
+#include <magic/net/socket.h>
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Parsed request, views into the connection buffer valid during the handler call
+struct HttpServerRequest {
+  std::string_view Method;
+  std::string_view Target;
+  std::string_view Version;
+  std::vector<HttpHeader::Entry> Headers;
+  std::string_view Body;
+
+  // Value of the first field with the name (case-insensitive), empty if there is none
+  std::string_view Header(std::string_view name) const;
+};
+
+struct HttpServerResponse {
+  HttpStatus::Code Status = HttpStatus::Code::OK;
+  std::string ContentType = "text/plain";
+  std::string Body;
+};
+
+using HttpHandler = std::function<HttpServerResponse(const HttpServerRequest&)>;
+
+//////////////////////////////////////////////////////////////////////
+
+// HTTP/1.1 server on fibers
+// Every connection is served by its own fiber, socket I/O parks the fiber
+// in the reactor instead of blocking a scheduler thread
+
+// Keep-alive and pipelining: all complete requests in the read buffer are
+// handled in order and their responses go out in a single write
+// Request bodies are supported with Content-Length only
+
+// Usage:
+// ThreadPool scheduler{4};
+// HttpServer server{scheduler, [](const HttpServerRequest& request) {
+//   return HttpServerResponse{.Body = "Hello"};
+// }};
+// server.Start("127.0.0.1", 8080).ThrowIfError();
+
+class HttpServer final {
+ public:
+  HttpServer(IExecutor& scheduler, HttpHandler handler);
+  ~HttpServer();
+
+  // Non-copyable
+  HttpServer(const HttpServer&) = delete;
+  HttpServer& operator=(const HttpServer&) = delete;
+
+  // ~ Public Interface
+
+  // Port 0 picks an ephemeral port, see Port()
+  Status Start(std::string_view host, uint16_t port);
+
+  uint16_t Port() const {
+    return acceptor_.Port();
+  }
+
+  // Closes the listener and every open connection, waits for the fibers
+  // Context: thread outside of the scheduler
+  void Stop();
+
+  size_t ActiveConnections() const;
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  void AcceptLoop();
+  void Serve(net::Socket& socket);
+
+  bool Track(net::Socket* socket);
+  void Untrack(net::Socket* socket);
+
+ private:
+  IExecutor& scheduler_;
+  HttpHandler handler_;
+
+  net::Acceptor acceptor_;
+  // Done is the last step of every fiber, Stop waits on it before the
+  // server may be destroyed
+  BlockingWaitGroup fibers_;
+
+  mutable std::mutex mutex_;
+  std::unordered_set<net::Socket*> connections_;  // Guarded by mutex_
+  bool stopping_ = false;                          // Guarded by mutex_
+  bool started_ = false;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
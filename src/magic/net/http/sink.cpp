@@ -0,0 +1,77 @@
+#include <magic/net/http/sink.h>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+FileSink::FileSink(const std::string& path)
+    : file_(path, std::ios::binary | std::ios::trunc) {
+}
+
+bool FileSink::Write(std::string_view chunk) {
+  file_.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+  return file_.good();
+}
+
+void FileSink::Close(std::error_code) {
+  file_.close();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+bool BodyChannel::Write(std::string_view chunk) {
+  std::unique_lock lock(mutex_);
+  // A chunk larger than the capacity still passes through an empty channel
+  while (!cancelled_ && buffered_ > 0 && buffered_ + chunk.size() > capacity_) {
+    not_full_.wait(lock);
+  }
+  if (cancelled_) {
+    return false;
+  }
+
+  chunks_.emplace_back(chunk);
+  buffered_ += chunk.size();
+  not_empty_.notify_one();
+  return true;
+}
+
+void BodyChannel::Close(std::error_code error) {
+  std::lock_guard guard(mutex_);
+  closed_ = true;
+  error_ = error;
+  not_empty_.notify_all();
+}
+
+std::optional<std::string> BodyChannel::Take() {
+  std::unique_lock lock(mutex_);
+  while (chunks_.empty()) {
+    if (closed_ || cancelled_) {
+      return std::nullopt;
+    }
+    not_empty_.wait(lock);
+  }
+
+  auto chunk = std::move(chunks_.front());
+  chunks_.pop_front();
+  buffered_ -= chunk.size();
+  not_full_.notify_one();
+  return chunk;
+}
+
+void BodyChannel::Cancel() {
+  std::lock_guard guard(mutex_);
+  cancelled_ = true;
+  chunks_.clear();
+  buffered_ = 0;
+  not_full_.notify_all();
+  not_empty_.notify_all();
+}
+
+std::error_code BodyChannel::Error() const {
+  std::lock_guard guard(mutex_);
+  return error_;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <magic/coroutine/processor.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Receives a response body as a sequence of chunks
+// Chunks are views into the transfer buffer, valid during the call only
+
+struct IBodySink {
+  virtual ~IBodySink() = default;
+
+  // Returning false aborts the transfer
+  virtual bool Write(std::string_view chunk) = 0;
+
+  // Called once after the last chunk, error is set if the transfer failed
+  virtual void Close(std::error_code /*error*/) {
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
+class CallbackSink final : public IBodySink {
+ public:
+  using Callback = std::function<bool(std::string_view)>;
+
+  explicit CallbackSink(Callback callback) : callback_(std::move(callback)) {
+  }
+
+  bool Write(std::string_view chunk) override {
+    return callback_(chunk);
+  }
+
+ private:
+  Callback callback_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Resumes the processor coroutine with every chunk on the transfer thread
+
+class ProcessorSink final : public IBodySink {
+ public:
+  explicit ProcessorSink(Processor<std::string_view>& processor) : processor_(processor) {
+  }
+
+  bool Write(std::string_view chunk) override {
+    processor_.Send(chunk);
+    return true;
+  }
+
+  void Close(std::error_code) override {
+    processor_.Close();
+  }
+
+ private:
+  Processor<std::string_view>& processor_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Writes the body to a file, the file is created or truncated
+
+class FileSink final : public IBodySink {
+ public:
+  explicit FileSink(const std::string& path);
+
+  bool IsOpen() const {
+    return file_.is_open();
+  }
+
+  bool Write(std::string_view chunk) override;
+  void Close(std::error_code error) override;
+
+ private:
+  std::ofstream file_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Bounded channel between the transfer and a consumer thread
+// When the consumer falls behind the transfer blocks in Write, stops reading
+// the socket and TCP flow control throttles the server
+
+// Usage:
+// BodyChannel channel{1 << 20};
+// std::thread downloader([&] { Http::Download(url, channel); });
+// while (auto chunk = channel.Take()) { ... }
+
+class BodyChannel final : public IBodySink {
+ public:
+  explicit BodyChannel(size_t capacity_bytes = kDefaultCapacity) : capacity_(capacity_bytes) {
+  }
+
+  // ~ Producer
+
+  // Blocks while the buffered bytes exceed the capacity
+  bool Write(std::string_view chunk) override;
+  void Close(std::error_code error) override;
+
+  // ~ Consumer
+
+  // Returns std::nullopt after the last chunk
+  std::optional<std::string> Take();
+
+  // Aborts the transfer, buffered chunks are dropped
+  void Cancel();
+
+  // Transfer error, valid after Take has returned std::nullopt
+  std::error_code Error() const;
+
+ private:
+  static const size_t kDefaultCapacity = 1 << 20;
+
+  const size_t capacity_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<std::string> chunks_;
+  size_t buffered_ = 0;
+  bool closed_ = false;
+  bool cancelled_ = false;
+  std::error_code error_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
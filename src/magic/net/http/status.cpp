@@ -18,8 +18,12 @@ std::string HttpStatus::ToString() const {
       return "404 Not Found";
     case Code::Conflict:
       return "409 Conflict";
+    case Code::PayloadTooLarge:
+      return "413 Payload Too Large";
     case Code::InternalServerError:
       return "500 Internal Server Error";
+    case Code::NotImplemented:
+      return "501 Not Implemented";
     case Code::BadGateway:
       return "502 Bad Gateway";
     case Code::ServiceUnavailable:
@@ -15,7 +15,9 @@ struct HttpStatus {
     BadRequest = 400,
     NotFound = 404,
     Conflict = 409,
+    PayloadTooLarge = 413,
     InternalServerError = 500,
+    NotImplemented = 501,
     BadGateway = 502,
     ServiceUnavailable = 503,
     GatewayTimeout = 504,
@@ -0,0 +1,151 @@
+#include <magic/net/http/transfer.h>
+#include <magic/net/http/request.h>
+#include <magic/net/http/latency.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <optional>
+#include <string_view>
+
+namespace magic::detail {
+
+//////////////////////////////////////////////////////////////////////
+
+// Upper bound for the reservation, the header is not trusted
+static const size_t kMaxContentReserve = 64 << 20;
+
+// Content-Length of the final response, if the line carries it
+static std::optional<size_t> ParseContentLength(std::string_view line) {
+  static const std::string_view kName = "content-length:";
+  if (line.size() <= kName.size()) {
+    return std::nullopt;
+  }
+  for (size_t index = 0; index < kName.size(); ++index) {
+    if (std::tolower(static_cast<unsigned char>(line[index])) != kName[index]) {
+      return std::nullopt;
+    }
+  }
+
+  auto value = line.substr(kName.size());
+  while (!value.empty() && value.front() == ' ') {
+    value.remove_prefix(1);
+  }
+  size_t length = 0;
+  auto [_, ec] = std::from_chars(value.data(), value.data() + value.size(), length);
+  if (ec != std::errc{}) {
+    return std::nullopt;
+  }
+  return length;
+}
+
+static size_t HeaderFunction(char* ptr, size_t size, size_t nmemb, ResponseBuffers* response) {
+  const size_t real_size = size * nmemb;
+  response->header.append(ptr, real_size);
+
+  if (auto length = ParseContentLength({ptr, real_size})) {
+    response->content.reserve(std::min(*length, kMaxContentReserve));
+  }
+  return real_size;
+}
+
+// Zero disables the curl timeout, round up to stay enabled
+static long ToCurlMillis(Duration timeout) {
+  return std::max<long>(1, std::ceil(timeout.count() * 1000));
+}
+
+static size_t SinkFunction(char* ptr, size_t size, size_t nmemb, IBodySink* sink) {
+  const size_t real_size = size * nmemb;
+  // Any other value aborts the transfer with CURLE_WRITE_ERROR
+  return sink->Write({ptr, real_size}) ? real_size : 0;
+}
+
+void SetupTransfer(CURL* curl, ResponseBuffers* response) {
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, detail::WriteFunction);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response->content);
+
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderFunction);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, response);
+}
+
+void SetupStreamingTransfer(CURL* curl, std::string* header, IBodySink* sink) {
+  curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, SinkFunction);
+  curl_easy_setopt(curl, CURLOPT_WRITEDATA, sink);
+
+  curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, detail::WriteFunction);
+  curl_easy_setopt(curl, CURLOPT_HEADERDATA, header);
+}
+
+void ApplyTimeouts(CURL* curl, const HttpTimeouts& timeouts) {
+  // Timeouts must not rely on signals in a multi-threaded process
+  curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+
+  if (timeouts.Connect) {
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, ToCurlMillis(*timeouts.Connect));
+  }
+  if (timeouts.Total) {
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, ToCurlMillis(*timeouts.Total));
+  }
+  if (timeouts.LowSpeedLimit > 0) {
+    // Curl measures the window in whole seconds
+    const auto seconds = std::max<long>(1, std::ceil(timeouts.LowSpeedTime.count()));
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, static_cast<long>(timeouts.LowSpeedLimit));
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, seconds);
+  }
+}
+
+HttpResponse CollectResponse(CURL* curl, std::string header, std::string content) {
+  int64_t response_code;
+  curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+
+  double total_time;
+  curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &total_time);
+  auto elapsed = ToTimeSpan(total_time);
+
+  char* url_string{nullptr};
+  curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &url_string);
+  auto effective_url = std::string(url_string);
+
+  // Metrics
+
+  double downloaded, uploaded, average_download_speed, average_upload_speed;
+  curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD, &downloaded);
+  curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD, &uploaded);
+  curl_easy_getinfo(curl, CURLINFO_SPEED_DOWNLOAD, &average_download_speed);
+  curl_easy_getinfo(curl, CURLINFO_SPEED_UPLOAD, &average_upload_speed);
+
+  double name_lookup, connect, app_connect, pre_transfer, start_transfer, redirect;
+  curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &name_lookup);
+  curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &connect);
+  curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME, &app_connect);
+  curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME, &pre_transfer);
+  curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &start_transfer);
+  curl_easy_getinfo(curl, CURLINFO_REDIRECT_TIME, &redirect);
+
+  long redirect_count = 0;
+  curl_easy_getinfo(curl, CURLINFO_REDIRECT_COUNT, &redirect_count);
+
+  auto metrics = HttpRequestMetrics{.DownloadBytes = downloaded,
+                                    .UploadBytes = uploaded,
+                                    .AverageDownloadSpeed = average_download_speed,
+                                    .AverageUploadSpeed = average_upload_speed,
+                                    .Duration = elapsed,
+                                    .NameLookup = ToTimeSpan(name_lookup),
+                                    .Connect = ToTimeSpan(connect),
+                                    .AppConnect = ToTimeSpan(app_connect),
+                                    .PreTransfer = ToTimeSpan(pre_transfer),
+                                    .StartTransfer = ToTimeSpan(start_transfer),
+                                    .Redirect = ToTimeSpan(redirect),
+                                    .RedirectCount = redirect_count};
+
+  HttpLatencyRegistry::Instance().Record(effective_url, elapsed.Value);
+
+  return HttpResponse{HttpStatus::FromStatusCode(response_code),
+                      HttpHeader::Parse(std::move(header)), std::move(metrics), effective_url,
+                      std::move(content)};
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::detail
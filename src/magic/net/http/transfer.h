@@ -0,0 +1,57 @@
+#pragma once
+
+#include <magic/net/http/response.h>
+#include <magic/net/http/sink.h>
+
+#include <curl/curl.h>
+
+#include <optional>
+#include <string>
+
+namespace magic {
+
+//////////////////////////////////////////////////////////////////////
+
+// Expired timeouts fail the request with CURLE_OPERATION_TIMEDOUT
+struct HttpTimeouts {
+  // TCP and TLS handshakes, DNS included
+  std::optional<Duration> Connect;
+  // The whole request, the body included
+  std::optional<Duration> Total;
+  // Aborts a transfer slower than LowSpeedLimit bytes per second for
+  // LowSpeedTime (rounded up to seconds), disabled when zero
+  size_t LowSpeedLimit = 0;
+  Duration LowSpeedTime = std::chrono::seconds(10);
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic
+
+namespace magic::detail {
+
+//////////////////////////////////////////////////////////////////////
+
+// Shared by the blocking (Http) and the event-driven (HttpClient) paths
+
+struct ResponseBuffers {
+  std::string header;
+  // Reserved from Content-Length once the headers arrive
+  std::string content;
+};
+
+// Points the response callbacks of the handle to the buffers
+void SetupTransfer(CURL* curl, ResponseBuffers* response);
+
+// Delivers the body to the sink chunk by chunk, only the header is buffered
+void SetupStreamingTransfer(CURL* curl, std::string* header, IBodySink* sink);
+
+void ApplyTimeouts(CURL* curl, const HttpTimeouts& timeouts);
+
+// Builds the response of a completed transfer
+// Records the latency in HttpLatencyRegistry
+HttpResponse CollectResponse(CURL* curl, std::string header, std::string content);
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::detail
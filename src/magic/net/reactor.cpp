@@ -0,0 +1,249 @@
+#include <magic/net/reactor.h>
+
+#include <magic/fibers/api.h>
+
+#include <wheels/core/assert.hpp>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace magic::net {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+const uintptr_t kIdle = 0;
+const uintptr_t kReady = 1;
+
+const size_t kMaxEvents = 256;
+
+std::atomic<uintptr_t>& Slot(Reactor::IoState* state, Reactor::Direction direction) {
+  return direction == Reactor::Direction::Read ? state->read : state->write;
+}
+
+class IoAwaiter final : public IMaybeSuspendAwaiter {
+ public:
+  explicit IoAwaiter(std::atomic<uintptr_t>& slot) : slot_(slot) {
+  }
+
+  bool AwaitSuspend(FiberHandle handle) override {
+    handle_ = handle;
+
+    auto state = slot_.load(std::memory_order::acquire);
+    while (true) {
+      if (state == kReady) {
+        // The edge arrived before parking, consume it and retry the syscall
+        if (slot_.compare_exchange_weak(state, kIdle, std::memory_order::acq_rel)) {
+          return true;
+        }
+        continue;
+      }
+      WHEELS_ASSERT(state == kIdle, "Another fiber waits in the same direction");
+      if (slot_.compare_exchange_weak(state, ToSlot(), std::memory_order::acq_rel)) {
+        return false;
+      }
+    }
+  }
+
+  void Wake() {
+    handle_.Schedule();
+  }
+
+  uintptr_t ToSlot() {
+    return reinterpret_cast<uintptr_t>(this);
+  }
+
+ private:
+  std::atomic<uintptr_t>& slot_;
+  FiberHandle handle_;
+};
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+Reactor::Reactor() {
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  wakeup_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  WHEELS_VERIFY(epoll_fd_ >= 0 && wakeup_fd_ >= 0, "Failed to create reactor descriptors");
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.ptr = nullptr;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wakeup_fd_, &event);
+
+  loop_ = std::thread([this] {
+    EventLoop();
+  });
+}
+
+Reactor::~Reactor() {
+  stop_.store(true);
+  Wakeup();
+  loop_.join();
+
+  close(wakeup_fd_);
+  close(epoll_fd_);
+}
+
+Reactor& Reactor::Instance() {
+  static Reactor reactor;
+  return reactor;
+}
+
+Reactor::IoState* Reactor::Register(int fd) {
+  auto state = AllocateState();
+  state->fd = fd;
+
+  epoll_event event{};
+  event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+  event.data.ptr = state;
+  const auto result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  WHEELS_VERIFY(result == 0, "Failed to register descriptor in epoll");
+
+  return state;
+}
+
+void Reactor::Unregister(IoState* state) {
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, state->fd, nullptr);
+  ReleaseState(state);
+}
+
+void Reactor::Wait(IoState* state, Direction direction, std::optional<Timestamp> deadline) {
+  std::optional<TimerKey> timer;
+  if (deadline) {
+    if (Clock::now() >= *deadline) {
+      return;
+    }
+    timer = AddTimer(*deadline, state, direction);
+  }
+
+  IoAwaiter awaiter(Slot(state, direction));
+  self::Suspend(awaiter);
+
+  if (timer) {
+    CancelTimer(*timer);
+  }
+}
+
+void Reactor::Wakeup() {
+  uint64_t one = 1;
+  [[maybe_unused]] auto written = write(wakeup_fd_, &one, sizeof(one));
+}
+
+Reactor::TimerKey Reactor::AddTimer(Timestamp deadline, IoState* state, Direction direction) {
+  bool earliest = false;
+  TimerKey key;
+  {
+    std::lock_guard guard(timers_mutex_);
+    key = {deadline, next_timer_id_++};
+    auto [it, _] = timers_.emplace(key, Timer{state, direction});
+    earliest = (it == timers_.begin());
+  }
+  if (earliest) {
+    // The event loop sleeps with a later (or no) timeout
+    Wakeup();
+  }
+  return key;
+}
+
+void Reactor::CancelTimer(const TimerKey& key) {
+  std::lock_guard guard(timers_mutex_);
+  timers_.erase(key);
+}
+
+int Reactor::FireExpiredTimers() {
+  std::vector<Timer> expired;
+  int timeout = -1;
+  {
+    std::lock_guard guard(timers_mutex_);
+    const auto now = Clock::now();
+    while (!timers_.empty() && timers_.begin()->first.first <= now) {
+      expired.push_back(timers_.begin()->second);
+      timers_.erase(timers_.begin());
+    }
+    if (!timers_.empty()) {
+      const auto delay = timers_.begin()->first.first - now;
+      // Round up, waking early would only spin
+      timeout = static_cast<int>(
+          std::chrono::ceil<std::chrono::milliseconds>(delay).count());
+    }
+  }
+
+  for (auto [state, direction] : expired) {
+    Notify(state, direction);
+  }
+  return timeout;
+}
+
+void Reactor::Notify(IoState* state, Direction direction) {
+  auto& slot = Slot(state, direction);
+
+  auto current = slot.load(std::memory_order::acquire);
+  while (true) {
+    if (current == kReady) {
+      return;
+    }
+    if (current == kIdle) {
+      if (slot.compare_exchange_weak(current, kReady, std::memory_order::acq_rel)) {
+        return;
+      }
+      continue;
+    }
+    // Parked waiter
+    if (slot.compare_exchange_weak(current, kIdle, std::memory_order::acq_rel)) {
+      reinterpret_cast<IoAwaiter*>(current)->Wake();
+      return;
+    }
+  }
+}
+
+void Reactor::EventLoop() {
+  epoll_event events[kMaxEvents];
+
+  while (!stop_.load()) {
+    const int timeout = FireExpiredTimers();
+    const int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout);
+
+    for (int index = 0; index < count; ++index) {
+      auto state = static_cast<IoState*>(events[index].data.ptr);
+      if (state == nullptr) {
+        uint64_t value;
+        [[maybe_unused]] auto read_bytes = read(wakeup_fd_, &value, sizeof(value));
+        continue;
+      }
+
+      const auto flags = events[index].events;
+      if (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+        Notify(state, Direction::Read);
+      }
+      if (flags & (EPOLLOUT | EPOLLHUP | EPOLLERR)) {
+        Notify(state, Direction::Write);
+      }
+    }
+  }
+}
+
+Reactor::IoState* Reactor::AllocateState() {
+  std::lock_guard guard(pool_mutex_);
+  if (!free_list_.empty()) {
+    auto state = free_list_.back();
+    free_list_.pop_back();
+    return state;
+  }
+  return &states_.emplace_back();
+}
+
+void Reactor::ReleaseState(IoState* state) {
+  state->read.store(kIdle, std::memory_order::relaxed);
+  state->write.store(kIdle, std::memory_order::relaxed);
+
+  std::lock_guard guard(pool_mutex_);
+  free_list_.push_back(state);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::net
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <magic/common/time.h>
+#include <magic/fibers/core/awaiter.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace magic::net {
+
+//////////////////////////////////////////////////////////////////////
+
+// Readiness notifications for non-blocking descriptors
+
+// A single epoll thread watches every registered descriptor in edge-triggered
+// mode and reschedules the fibers parked on it, so a fiber waiting for I/O
+// holds no worker thread of its scheduler
+
+// Each direction of a descriptor is a tiny state machine:
+// Idle -> Ready (edge arrived, nobody waits) or Idle -> Waiter (fiber parked)
+// An edge that arrives before the fiber parks is remembered as Ready,
+// the fiber then retries the syscall instead of suspending
+
+// Deadlines: an expired timer kicks the direction like an edge would,
+// the woken fiber compares the clock with its own deadline, so a late or
+// misdirected kick is just another spurious wakeup
+
+class Reactor final {
+ public:
+  enum class Direction { Read, Write };
+
+  struct IoState;
+
+  Reactor();
+  ~Reactor();
+
+  // Non-copyable
+  Reactor(const Reactor&) = delete;
+  Reactor& operator=(const Reactor&) = delete;
+
+  // ~ Public Interface
+
+  // Process-wide reactor, started on first use
+  static Reactor& Instance();
+
+  // The descriptor must be non-blocking
+  IoState* Register(int fd);
+
+  // Context: no fiber waits on the state, the descriptor is still open
+  void Unregister(IoState* state);
+
+  // Context: fiber
+  // Suspends until the descriptor may be ready for the direction or the deadline
+  // has passed, wakeups can be spurious: the caller retries the syscall
+  void Wait(IoState* state, Direction direction,
+            std::optional<Timestamp> deadline = std::nullopt);
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  using TimerKey = std::pair<Timestamp, uint64_t>;
+  using Timer = std::pair<IoState*, Direction>;
+
+  void EventLoop();
+  void Notify(IoState* state, Direction direction);
+  void Wakeup();
+
+  TimerKey AddTimer(Timestamp deadline, IoState* state, Direction direction);
+  void CancelTimer(const TimerKey& key);
+  // Returns the epoll_wait timeout in milliseconds
+  int FireExpiredTimers();
+
+  IoState* AllocateState();
+  void ReleaseState(IoState* state);
+
+ private:
+  int epoll_fd_;
+  int wakeup_fd_;
+  std::atomic<bool> stop_ = false;
+
+  // States are pooled and never freed: the event loop may still hold
+  // an event for a descriptor that has just been unregistered,
+  // a stale event only causes a spurious wakeup of the next owner
+  std::mutex pool_mutex_;
+  std::deque<IoState> states_;       // Guarded by pool_mutex_
+  std::vector<IoState*> free_list_;  // Guarded by pool_mutex_
+
+  std::mutex timers_mutex_;
+  std::map<TimerKey, Timer> timers_;  // Guarded by timers_mutex_
+  uint64_t next_timer_id_ = 0;        // Guarded by timers_mutex_
+
+  std::thread loop_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+struct Reactor::IoState {
+  // 0 - Idle, 1 - Ready, otherwise a pointer to the parked waiter
+  std::atomic<uintptr_t> read = 0;
+  std::atomic<uintptr_t> write = 0;
+  int fd = -1;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::net
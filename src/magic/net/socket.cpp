@@ -0,0 +1,308 @@
+#include <magic/net/socket.h>
+
+#include <magic/common/result/make.h>
+#include <magic/fibers/api.h>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <string>
+#include <utility>
+
+namespace magic::net {
+
+//////////////////////////////////////////////////////////////////////
+
+namespace {
+
+std::error_code LastError() {
+  return std::error_code(errno, std::system_category());
+}
+
+std::error_code TimedOut() {
+  return std::make_error_code(std::errc::timed_out);
+}
+
+bool WouldBlock() {
+  return errno == EAGAIN || errno == EWOULDBLOCK;
+}
+
+void SetNonBlocking(int fd) {
+  const int flags = fcntl(fd, F_GETFL, 0);
+  fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+void SetNoDelay(int fd) {
+  const int one = 1;
+  ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+bool ParseAddress(std::string_view host, uint16_t port, sockaddr_in& address) {
+  address = sockaddr_in{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  return ::inet_pton(AF_INET, std::string(host).c_str(), &address.sin_addr) == 1;
+}
+
+// Skips the written bytes, returns the remaining part of the array
+std::span<iovec> Advance(std::span<iovec> buffers, size_t bytes) {
+  while (!buffers.empty() && bytes >= buffers.front().iov_len) {
+    bytes -= buffers.front().iov_len;
+    buffers = buffers.subspan(1);
+  }
+  if (!buffers.empty()) {
+    buffers.front().iov_base = static_cast<char*>(buffers.front().iov_base) + bytes;
+    buffers.front().iov_len -= bytes;
+  }
+  return buffers;
+}
+
+}  // namespace
+
+//////////////////////////////////////////////////////////////////////
+
+Socket::Socket(int fd) : fd_(fd) {
+  SetNonBlocking(fd_);
+  io_ = Reactor::Instance().Register(fd_);
+}
+
+Socket::~Socket() {
+  Close();
+}
+
+Socket::Socket(Socket&& that)
+    : fd_(std::exchange(that.fd_, -1)),
+      io_(std::exchange(that.io_, nullptr)),
+      read_timeout_(that.read_timeout_),
+      write_timeout_(that.write_timeout_) {
+}
+
+Socket& Socket::operator=(Socket&& that) {
+  if (this != &that) {
+    Close();
+    fd_ = std::exchange(that.fd_, -1);
+    io_ = std::exchange(that.io_, nullptr);
+    read_timeout_ = that.read_timeout_;
+    write_timeout_ = that.write_timeout_;
+  }
+  return *this;
+}
+
+Result<Socket> Socket::Connect(std::string_view host, uint16_t port,
+                               std::optional<Duration> timeout) {
+  sockaddr_in address;
+  if (!ParseAddress(host, port, address)) {
+    return Fail(std::make_error_code(std::errc::invalid_argument));
+  }
+
+  const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return Fail(LastError());
+  }
+  SetNoDelay(fd);
+  auto socket = Socket(fd);
+
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+    if (errno != EINPROGRESS) {
+      return Fail(LastError());
+    }
+
+    // Writable once the handshake has completed or failed
+    const auto deadline = DeadlineAfter(timeout);
+    int error = 0;
+    while (true) {
+      if (!socket.WaitReady(Reactor::Direction::Write, deadline)) {
+        return Fail(TimedOut());
+      }
+      pollfd request{.fd = fd, .events = POLLOUT, .revents = 0};
+      if (::poll(&request, 1, 0) > 0) {
+        break;
+      }
+    }
+
+    socklen_t length = sizeof(error);
+    ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length);
+    if (error != 0) {
+      return Fail(std::error_code(error, std::system_category()));
+    }
+  }
+
+  return Result<Socket>::Ok(std::move(socket));
+}
+
+Result<size_t> Socket::ReadSome(char* buffer, size_t size) {
+  const iovec single{.iov_base = buffer, .iov_len = size};
+  return ReadV({&single, 1});
+}
+
+Result<size_t> Socket::ReadV(std::span<const iovec> buffers) {
+  const auto deadline = DeadlineAfter(read_timeout_);
+  const int count = static_cast<int>(std::min<size_t>(buffers.size(), IOV_MAX));
+
+  while (true) {
+    const auto bytes = ::readv(fd_, buffers.data(), count);
+    if (bytes >= 0) {
+      return Ok(static_cast<size_t>(bytes));
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (!WouldBlock()) {
+      return Fail(LastError());
+    }
+    if (!WaitReady(Reactor::Direction::Read, deadline)) {
+      return Fail(TimedOut());
+    }
+  }
+}
+
+Status Socket::WriteAll(std::string_view data) {
+  iovec single{.iov_base = const_cast<char*>(data.data()), .iov_len = data.size()};
+  return WriteV({&single, 1});
+}
+
+Status Socket::WriteV(std::span<iovec> buffers) {
+  const auto deadline = DeadlineAfter(write_timeout_);
+
+  // Skip empty leading buffers
+  buffers = Advance(buffers, 0);
+  while (!buffers.empty()) {
+    msghdr message{};
+    message.msg_iov = buffers.data();
+    message.msg_iovlen = std::min<size_t>(buffers.size(), IOV_MAX);
+
+    const auto bytes = ::sendmsg(fd_, &message, MSG_NOSIGNAL);
+    if (bytes >= 0) {
+      buffers = Advance(buffers, bytes);
+      continue;
+    }
+    if (errno == EINTR) {
+      continue;
+    }
+    if (!WouldBlock()) {
+      return Fail(LastError());
+    }
+    if (!WaitReady(Reactor::Direction::Write, deadline)) {
+      return Fail(TimedOut());
+    }
+  }
+  return Ok();
+}
+
+void Socket::ShutdownWrite() {
+  ::shutdown(fd_, SHUT_WR);
+}
+
+void Socket::Shutdown() {
+  ::shutdown(fd_, SHUT_RDWR);
+}
+
+void Socket::Close() {
+  if (fd_ < 0) {
+    return;
+  }
+  Reactor::Instance().Unregister(io_);
+  ::close(fd_);
+  fd_ = -1;
+  io_ = nullptr;
+}
+
+std::optional<Timestamp> Socket::DeadlineAfter(std::optional<Duration> timeout) {
+  if (!timeout) {
+    return std::nullopt;
+  }
+  return Clock::now() + std::chrono::duration_cast<Clock::duration>(*timeout);
+}
+
+bool Socket::WaitReady(Reactor::Direction direction, std::optional<Timestamp> deadline) {
+  if (self::IsFiber()) {
+    Reactor::Instance().Wait(io_, direction, deadline);
+  } else {
+    int timeout_ms = -1;
+    if (deadline) {
+      const auto left = std::chrono::ceil<std::chrono::milliseconds>(*deadline - Clock::now());
+      timeout_ms = static_cast<int>(std::max<int64_t>(left.count(), 0));
+    }
+    pollfd request{};
+    request.fd = fd_;
+    request.events = (direction == Reactor::Direction::Read) ? POLLIN : POLLOUT;
+    ::poll(&request, 1, timeout_ms);
+  }
+  return !deadline || Clock::now() < *deadline;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+Acceptor::~Acceptor() {
+  Close();
+}
+
+Status Acceptor::Listen(std::string_view host, uint16_t port, int backlog) {
+  sockaddr_in address;
+  if (!ParseAddress(host, port, address)) {
+    return Fail(std::make_error_code(std::errc::invalid_argument));
+  }
+
+  const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return Fail(LastError());
+  }
+
+  const int one = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+      ::listen(fd, backlog) != 0) {
+    auto error = LastError();
+    ::close(fd);
+    return Fail(error);
+  }
+
+  socklen_t length = sizeof(address);
+  ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+  port_ = ntohs(address.sin_port);
+
+  listener_ = Socket(fd);
+  return Ok();
+}
+
+Result<Socket> Acceptor::Accept() {
+  const auto deadline = Socket::DeadlineAfter(listener_.read_timeout_);
+
+  while (true) {
+    const int fd = ::accept4(listener_.Fd(), nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd >= 0) {
+      SetNoDelay(fd);
+      return Result<Socket>::Ok(Socket(fd));
+    }
+    if (errno == EINTR || errno == ECONNABORTED) {
+      continue;
+    }
+    if (!WouldBlock()) {
+      return Fail(LastError());
+    }
+    if (!listener_.WaitReady(Reactor::Direction::Read, deadline)) {
+      return Fail(TimedOut());
+    }
+  }
+}
+
+void Acceptor::Shutdown() {
+  listener_.Shutdown();
+}
+
+void Acceptor::Close() {
+  listener_.Close();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::net
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <magic/common/result.h>
+#include <magic/common/time.h>
+#include <magic/net/reactor.h>
+
+#include <sys/uio.h>
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace magic::net {
+
+//////////////////////////////////////////////////////////////////////
+
+// Non-blocking TCP socket
+// In a fiber I/O suspends the fiber until the reactor reports readiness,
+// outside of fibers it blocks the calling thread in poll
+
+// One reader and one writer may use a socket concurrently
+// Operations that outlive their timeout fail with std::errc::timed_out
+
+// Usage:
+// auto socket = net::Socket::Connect("127.0.0.1", 8080).ValueOrThrow();
+// socket.SetReadTimeout(5s);
+// socket.WriteAll("ping").ThrowIfError();
+// auto bytes = socket.ReadSome(buffer, sizeof(buffer));
+
+class Socket final {
+  friend class Acceptor;
+
+ public:
+  Socket() = default;
+  // Takes ownership of a connected descriptor
+  explicit Socket(int fd);
+  ~Socket();
+
+  // Non-copyable
+  Socket(const Socket&) = delete;
+  Socket& operator=(const Socket&) = delete;
+
+  // Movable
+  Socket(Socket&& that);
+  Socket& operator=(Socket&& that);
+
+  // ~ Public Interface
+
+  // Connects to an IPv4 address
+  static Result<Socket> Connect(std::string_view host, uint16_t port,
+                                std::optional<Duration> timeout = std::nullopt);
+
+  // Reads at least one byte, zero means the peer has closed the connection
+  Result<size_t> ReadSome(char* buffer, size_t size);
+
+  // Scatter read: fills the buffers in order, at least one byte
+  Result<size_t> ReadV(std::span<const iovec> buffers);
+
+  // Writes the whole buffer
+  Status WriteAll(std::string_view data);
+
+  // Gather write of all the buffers, the array is consumed in place
+  Status WriteV(std::span<iovec> buffers);
+
+  // Applies to every following operation, std::nullopt disables the timeout
+  void SetReadTimeout(std::optional<Duration> timeout) {
+    read_timeout_ = timeout;
+  }
+
+  void SetWriteTimeout(std::optional<Duration> timeout) {
+    write_timeout_ = timeout;
+  }
+
+  // Sends FIN, pending reads of the peer observe the end of stream
+  void ShutdownWrite();
+
+  // Wakes up blocked readers and writers of the socket with errors,
+  // the descriptor stays open until Close
+  void Shutdown();
+
+  void Close();
+
+  bool IsValid() const {
+    return fd_ >= 0;
+  }
+
+  int Fd() const {
+    return fd_;
+  }
+
+  //////////////////////////////////////////////////////////////////////
+
+ private:
+  static std::optional<Timestamp> DeadlineAfter(std::optional<Duration> timeout);
+
+  // Returns false once the deadline has passed
+  bool WaitReady(Reactor::Direction direction, std::optional<Timestamp> deadline);
+
+ private:
+  int fd_ = -1;
+  Reactor::IoState* io_ = nullptr;
+
+  std::optional<Duration> read_timeout_;
+  std::optional<Duration> write_timeout_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Listening TCP socket
+
+class Acceptor final {
+ public:
+  Acceptor() = default;
+  ~Acceptor();
+
+  // Non-copyable
+  Acceptor(const Acceptor&) = delete;
+  Acceptor& operator=(const Acceptor&) = delete;
+
+  // ~ Public Interface
+
+  // Port 0 picks an ephemeral port, see Port()
+  Status Listen(std::string_view host, uint16_t port, int backlog = 1024);
+
+  // Fails after Shutdown or when the timeout expires
+  Result<Socket> Accept();
+
+  void SetAcceptTimeout(std::optional<Duration> timeout) {
+    listener_.SetReadTimeout(timeout);
+  }
+
+  uint16_t Port() const {
+    return port_;
+  }
+
+  // Wakes up a blocked Accept, new connections are refused
+  void Shutdown();
+
+  void Close();
+
+ private:
+  Socket listener_;
+  uint16_t port_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+}  // namespace magic::net
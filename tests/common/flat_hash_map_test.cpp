@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <magic/common/dictionary.h>
+#include <magic/common/flat_hash_map.h>
+#include <magic/common/hash.h>
+
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+using StringMap = FlatHashMap<std::string, std::string, detail::StringHash>;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(HashBytes, Lengths) {
+  // Every length branch, no collisions between prefixes of one string
+  const std::string text(200, 'x');
+  std::set<uint64_t> hashes;
+  for (size_t length = 0; length <= text.size(); ++length) {
+    hashes.insert(HashBytes(text.data(), length));
+  }
+  ASSERT_EQ(hashes.size(), text.size() + 1);
+
+  ASSERT_EQ(HashString("key"), HashString(std::string("key")));
+  ASSERT_NE(HashString("key1"), HashString("key2"));
+  ASSERT_NE(HashBytes("key", 3, 1), HashBytes("key", 3, 2));
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(FlatHashMap, JustWorks) {
+  StringMap map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.find("missing"), map.end());
+
+  map["key"] = "value";
+  ASSERT_TRUE(map.insert({"other", "1"}).second);
+  ASSERT_FALSE(map.insert({"other", "2"}).second);
+  ASSERT_EQ(map.size(), 2);
+
+  ASSERT_EQ(map.at("key"), "value");
+  ASSERT_EQ(map.at("other"), "1");
+  ASSERT_THROW(map.at("missing"), std::out_of_range);
+
+  map.insert_or_assign("other", "2");
+  ASSERT_EQ(map["other"], "2");
+}
+
+TEST(FlatHashMap, HeterogeneousLookup) {
+  StringMap map = {{"content-type", "text/plain"}};
+
+  const std::string_view key = "content-type";
+  ASSERT_TRUE(map.contains(key));
+  ASSERT_EQ(map.count("content-type"), 1);
+  ASSERT_EQ(map.find(key)->second, "text/plain");
+
+  // Converted to std::string only on insertion
+  map[std::string_view{"new"}] = "value";
+  ASSERT_EQ(map.at(std::string_view{"new"}), "value");
+}
+
+TEST(FlatHashMap, Grows) {
+  FlatHashMap<int, int> map;
+  for (int index = 0; index < 100'000; ++index) {
+    map[index] = index * 2;
+  }
+  ASSERT_EQ(map.size(), 100'000);
+  ASSERT_LE(map.size(), map.capacity() / 8 * 7);
+  for (int index = 0; index < 100'000; ++index) {
+    ASSERT_EQ(map.at(index), index * 2);
+  }
+  ASSERT_FALSE(map.contains(-1));
+}
+
+TEST(FlatHashMap, EraseAndReuse) {
+  FlatHashMap<int, int> map;
+  map.reserve(64);
+  const size_t capacity = map.capacity();
+
+  // Churn through tombstones without growing
+  for (int round = 0; round < 100; ++round) {
+    for (int index = 0; index < 40; ++index) {
+      map[round * 1000 + index] = index;
+    }
+    for (int index = 0; index < 40; ++index) {
+      ASSERT_EQ(map.erase(round * 1000 + index), 1);
+    }
+  }
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(map.capacity(), capacity);
+  ASSERT_EQ(map.erase(42), 0);
+}
+
+TEST(FlatHashMap, EraseIterator) {
+  FlatHashMap<int, int> map;
+  for (int index = 0; index < 1000; ++index) {
+    map[index] = index;
+  }
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 2 == 0) {
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  ASSERT_EQ(map.size(), 500);
+  for (auto&& [key, value] : map) {
+    ASSERT_EQ(key % 2, 1);
+    ASSERT_EQ(key, value);
+  }
+}
+
+TEST(FlatHashMap, MatchesUnorderedMap) {
+  StringMap map;
+  std::unordered_map<std::string, std::string> expected;
+
+  std::mt19937 random{42};
+  for (size_t step = 0; step < 200'000; ++step) {
+    const auto key = std::to_string(random() % 5000);
+    switch (random() % 4) {
+      case 0:
+        ASSERT_EQ(map.erase(key), expected.erase(key));
+        break;
+      case 1:
+        ASSERT_EQ(map.insert({key, key}).second, expected.insert({key, key}).second);
+        break;
+      default:
+        ASSERT_EQ(map.contains(key), expected.contains(key));
+    }
+  }
+
+  ASSERT_EQ(map.size(), expected.size());
+  size_t iterated = 0;
+  for (auto&& [key, value] : map) {
+    ASSERT_EQ(expected.at(key), value);
+    ++iterated;
+  }
+  ASSERT_EQ(iterated, expected.size());
+}
+
+TEST(FlatHashMap, MoveOnlyValues) {
+  FlatHashMap<int, std::unique_ptr<int>> map;
+  for (int index = 0; index < 100; ++index) {
+    map.try_emplace(index, std::make_unique<int>(index));
+  }
+  ASSERT_EQ(*map.at(99), 99);
+
+  auto moved = std::move(map);
+  ASSERT_EQ(moved.size(), 100);
+  ASSERT_TRUE(map.empty());
+}
+
+TEST(FlatHashMap, Copy) {
+  StringMap map = {{"a", "1"}, {"b", "2"}};
+  StringMap copy = map;
+  copy["c"] = "3";
+
+  ASSERT_EQ(map.size(), 2);
+  ASSERT_EQ(copy.size(), 3);
+  ASSERT_EQ(copy.at("a"), "1");
+
+  map = copy;
+  ASSERT_EQ(map.size(), 3);
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_FALSE(map.contains("a"));
+}
+
+TEST(FlatHashMap, ConstIteration) {
+  const StringMap map = {{"a", "1"}, {"b", "2"}};
+  size_t total = 0;
+  for (StringMap::const_iterator it = map.begin(); it != map.end(); ++it) {
+    total += it->second.size();
+  }
+  ASSERT_EQ(total, 2);
+  ASSERT_EQ(map.find("a")->second, "1");
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <magic/common/histogram.h>
+#include <magic/common/time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(Histogram, Buckets) {
+  // Exact below 2^7, at most 1/128 wide above, monotonic and gapless
+  uint64_t previous_highest = 0;
+  for (size_t index = 1; index < detail::kHistogramBuckets; ++index) {
+    const uint64_t highest = detail::HistogramBucketHighest(index);
+    const uint64_t lowest = previous_highest + 1;
+    ASSERT_EQ(detail::HistogramBucketIndex(lowest), index);
+    ASSERT_EQ(detail::HistogramBucketIndex(highest), index);
+    ASSERT_LE(highest - lowest, lowest / 128);
+    previous_highest = highest;
+  }
+  ASSERT_EQ(previous_highest, std::numeric_limits<uint64_t>::max());
+}
+
+TEST(Histogram, JustWorks) {
+  Histogram histogram;
+  ASSERT_EQ(histogram.Snapshot().Count(), 0);
+  ASSERT_EQ(histogram.Snapshot().Percentile(99), 0);
+
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.Record(value);
+  }
+
+  const auto snapshot = histogram.Snapshot();
+  ASSERT_EQ(snapshot.Count(), 1000);
+  ASSERT_EQ(snapshot.Min(), 1);
+  ASSERT_EQ(snapshot.Max(), 1000);
+  ASSERT_DOUBLE_EQ(snapshot.Mean(), 500.5);
+  ASSERT_EQ(snapshot.Percentile(0), 1);
+  ASSERT_EQ(snapshot.Percentile(100), 1000);
+  ASSERT_NEAR(snapshot.Percentile(50), 500, 500 / 128);
+  ASSERT_NEAR(snapshot.Percentile(99), 990, 990 / 128);
+}
+
+TEST(Histogram, Precision) {
+  Histogram histogram;
+  std::vector<uint64_t> values;
+  std::mt19937_64 random{42};
+  std::lognormal_distribution<double> latency{13, 1.5};
+  for (size_t step = 0; step < 100'000; ++step) {
+    values.push_back(static_cast<uint64_t>(latency(random)));
+    histogram.Record(values.back());
+  }
+  std::sort(values.begin(), values.end());
+
+  const auto snapshot = histogram.Snapshot();
+  for (double percentile : {1.0, 25.0, 50.0, 90.0, 99.0, 99.9}) {
+    const auto rank = static_cast<size_t>(std::ceil(percentile / 100 * values.size()));
+    const double expected = values[rank - 1];
+    ASSERT_NEAR(snapshot.Percentile(percentile), expected, expected / 128) << percentile;
+  }
+}
+
+TEST(Histogram, Durations) {
+  Histogram histogram;
+  histogram.Record(std::chrono::milliseconds(3));
+  histogram.Record(Duration(0.5));
+  histogram.Record(std::chrono::nanoseconds(-1));
+
+  const auto snapshot = histogram.Snapshot();
+  ASSERT_EQ(snapshot.Min(), 0);
+  ASSERT_EQ(snapshot.Max(), 500'000'000);
+  ASSERT_EQ(snapshot.Sum(), 503'000'000);
+}
+
+TEST(Histogram, Concurrent) {
+  static const size_t kThreads = 8;
+  static const size_t kRecords = 100'000;
+
+  Histogram histogram{4};
+  std::vector<std::thread> threads;
+  for (size_t thread = 0; thread < kThreads; ++thread) {
+    threads.emplace_back([&, thread] {
+      for (size_t index = 0; index < kRecords; ++index) {
+        histogram.Record(thread * 1000 + index % 1000);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto snapshot = histogram.Snapshot();
+  ASSERT_EQ(snapshot.Count(), kThreads * kRecords);
+  ASSERT_EQ(snapshot.Min(), 0);
+  ASSERT_EQ(snapshot.Max(), 7999);
+
+  histogram.Reset();
+  ASSERT_EQ(histogram.Snapshot().Count(), 0);
+}
+
+TEST(Histogram, SnapshotWhileRecording) {
+  Histogram histogram{1};
+  std::atomic<bool> stop = false;
+
+  std::thread recorder([&] {
+    for (uint64_t value = 1; !stop.load(); value = value % 1'000'000 + 1) {
+      histogram.Record(value);
+    }
+  });
+
+  for (size_t step = 0; step < 10'000; ++step) {
+    const auto snapshot = histogram.Snapshot();
+    if (snapshot.Count() == 0) {
+      continue;
+    }
+    ASSERT_LE(snapshot.Min(), snapshot.Max());
+    ASSERT_LE(snapshot.Min(), snapshot.Percentile(0));
+    ASSERT_LE(snapshot.Percentile(99), snapshot.Max());
+  }
+
+  stop.store(true);
+  recorder.join();
+}
+
+TEST(Histogram, Merge) {
+  Histogram first;
+  Histogram second;
+  for (uint64_t value = 1; value <= 100; ++value) {
+    first.Record(value);
+    second.Record(value * 1000, 2);
+  }
+
+  auto merged = first.Snapshot();
+  merged.Merge(second.Snapshot());
+  ASSERT_EQ(merged.Count(), 300);
+  ASSERT_EQ(merged.Min(), 1);
+  ASSERT_EQ(merged.Max(), 100'000);
+  ASSERT_EQ(merged.Percentile(33), 99);
+  ASSERT_NEAR(merged.Percentile(34), 2000, 2000 / 128);
+}
+
+TEST(Histogram, Export) {
+  Histogram histogram;
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.Record(value);
+  }
+  const auto snapshot = histogram.Snapshot();
+
+  ASSERT_EQ(snapshot.ToString(),
+            "count=1000 min=1 mean=500.5 p50=501 p90=903 p99=991 p99.9=1000 max=1000");
+  ASSERT_EQ(snapshot.ToJson(),
+            "{\"count\":1000,\"min\":1,\"mean\":500.5,\"p50\":501,\"p90\":903,\"p99\":991,"
+            "\"p99.9\":1000,\"max\":1000}");
+}
+
+TEST(HistogramTimer, JustWorks) {
+  Histogram histogram;
+  {
+    HistogramTimer timer{histogram};
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  const auto snapshot = histogram.Snapshot();
+  ASSERT_EQ(snapshot.Count(), 1);
+  ASSERT_GE(snapshot.Min(), 9'000'000);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <magic/common/generators/data_generator.h>
+#include <magic/common/generators/random_generator.h>
+#include <magic/common/generators/wyrand.h>
+#include <magic/common/generators/xoshiro.h>
+#include <magic/common/random.h>
+
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(Xoshiro256StarStar, ReferenceOutput) {
+  Xoshiro256StarStar engine{std::array<uint64_t, 4>{1, 2, 3, 4}};
+  ASSERT_EQ(engine(), 11520);
+  ASSERT_EQ(engine(), 0);
+  ASSERT_EQ(engine(), 1509978240);
+  ASSERT_EQ(engine(), 1215971899390074240);
+  ASSERT_EQ(engine(), 1216172134540287360);
+}
+
+TEST(WyRand, ReferenceOutput) {
+  WyRand engine{42};
+  ASSERT_EQ(engine(), 0xae4a7cbfdda9b434);
+  ASSERT_EQ(engine(), 0xe9cc09d33d38d9d2);
+  ASSERT_EQ(engine(), 0xcb5756512b93433a);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(RandomGenerator, Bounds) {
+  RandomGenerator generator{42};
+  for (size_t step = 0; step < 100'000; ++step) {
+    const uint32_t value = generator.Next(10u, 20u);
+    ASSERT_GE(value, 10);
+    ASSERT_LE(value, 20);
+    ASSERT_LE(generator.Next(uint64_t{5}), 5);
+    const double uniform = generator.NextDouble();
+    ASSERT_GE(uniform, 0.0);
+    ASSERT_LT(uniform, 1.0);
+  }
+
+  ASSERT_EQ(generator.Next(7u, 7u), 7);
+  // Full ranges do not overflow the range width
+  generator.Next(0u, std::numeric_limits<uint32_t>::max());
+  generator.Next(uint64_t{0}, std::numeric_limits<uint64_t>::max());
+}
+
+TEST(RandomGenerator, Uniform) {
+  // Every bucket within 5% of the expected count
+  RandomGenerator generator{7};
+  std::vector<size_t> buckets(13);
+  const size_t kSamples = 1'300'000;
+  for (size_t step = 0; step < kSamples; ++step) {
+    ++buckets[generator.Next(12u)];
+  }
+  for (auto count : buckets) {
+    ASSERT_NEAR(count, kSamples / buckets.size(), kSamples / buckets.size() / 20);
+  }
+}
+
+TEST(Random, JustWorks) {
+  for (size_t step = 0; step < 1000; ++step) {
+    ASSERT_LE(Random::Next(100), 100);
+    const auto value = Random::Next(1, 3);
+    ASSERT_TRUE(value >= 1 && value <= 3);
+  }
+  ASSERT_NE(Random::NextInt64(), Random::NextInt64());
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(DataGenerator, Letters) {
+  // Covers the vector loop, whole words and the tail
+  std::string data(1003, '\0');
+  DataGenerator generator{data.size()};
+  size_t total = 0;
+  while (generator.HasNext()) {
+    total += generator.NextChunk(data.data() + total, 100);
+  }
+  ASSERT_EQ(total, data.size());
+
+  std::array<size_t, 26> counts{};
+  for (char ch : data) {
+    ASSERT_TRUE(ch >= 'A' && ch <= 'Z');
+    ++counts[ch - 'A'];
+  }
+  for (auto count : counts) {
+    ASSERT_GT(count, 0);
+  }
+}
+
+TEST(DataGenerator, Fill) {
+  // Vector and scalar paths produce the same letters
+  std::string data(1003, '\0');
+  DataGenerator generator{0};
+  generator.Fill(data);
+
+  WyRand random{42};
+  uint64_t word = 0;
+  for (size_t index = 0; index < data.size(); ++index) {
+    if (index % 8 == 0) {
+      word = random();
+    }
+    const char expected = 'A' + ((word >> (index % 8 * 8) & 0xff) * 26 >> 8);
+    ASSERT_EQ(data[index], expected) << index;
+  }
+}
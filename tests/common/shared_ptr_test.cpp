@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 
 #include <magic/common/shared_ptr.h>
+#include <magic/common/stopwatch.h>
+
+#include <twist/test/race.hpp>
 
 #include <fmt/core.h>
 #include <chrono>
@@ -230,7 +233,6 @@ TEST(SharedPtr, Atomic_JustWorks) {
 
   auto sp3 = MakeShared<TestObject>(9);
 
-  return ;
   bool success = asp.CompareExchangeWeak(sp1, sp3);
   ASSERT_TRUE(success);
 
@@ -243,4 +245,80 @@ TEST(SharedPtr, Atomic_JustWorks) {
 
   auto sp6 = asp.Load();
   ASSERT_EQ(sp6->value, sp3->value);
-}
\ No newline at end of file
+}
+
+TEST(SharedPtr, Atomic_Exchange) {
+  {
+    AtomicSharedPtr<TestObject> asp(MakeShared<TestObject>(1));
+
+    auto old = asp.Exchange(MakeShared<TestObject>(2));
+    ASSERT_EQ(old->value, 1);
+    ASSERT_EQ(asp.Load()->value, 2);
+
+    auto expected = asp.Load();
+    ASSERT_TRUE(asp.CompareExchange(expected, MakeShared<TestObject>(3)));
+    ASSERT_FALSE(asp.CompareExchange(old, MakeShared<TestObject>(4)));
+    ASSERT_EQ(old->value, 3);
+
+    asp.Store({});
+    ASSERT_FALSE(asp.Load());
+  }
+  ASSERT_TRUE(TestObject::LiveObjectCount() == 0);
+}
+
+TEST(SharedPtr, Atomic_ManyLoads) {
+  {
+    AtomicSharedPtr<TestObject> asp(MakeShared<TestObject>(5));
+
+    // Exceeds the stamp range, forces refills
+    for (size_t index = 0; index < 1'000'000; ++index) {
+      auto sp = asp.Load();
+      ASSERT_EQ(sp->value, 5);
+    }
+  }
+  ASSERT_TRUE(TestObject::LiveObjectCount() == 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void AtomicStressTest(size_t readers, size_t writers, Duration duration) {
+  {
+    AtomicSharedPtr<TestObject> asp(MakeShared<TestObject>(0));
+    std::atomic<int> version{0};
+
+    Stopwatch stopwatch;
+    twist::test::Race race;
+
+    for (size_t index = 0; index < readers; ++index) {
+      race.Add([&] {
+        int last_seen = 0;
+        while (stopwatch.Elapsed() < duration) {
+          auto sp = asp.Load();
+          ASSERT_GE(sp->value, last_seen);
+          last_seen = sp->value;
+        }
+      });
+    }
+
+    for (size_t index = 0; index < writers; ++index) {
+      race.Add([&] {
+        while (stopwatch.Elapsed() < duration) {
+          auto expected = asp.Load();
+          auto desired = MakeShared<TestObject>(expected->value + 1);
+          if (asp.CompareExchange(expected, desired)) {
+            version.fetch_add(1);
+          }
+        }
+      });
+    }
+
+    race.Run();
+
+    ASSERT_EQ(asp.Load()->value, version.load());
+  }
+  ASSERT_TRUE(TestObject::LiveObjectCount() == 0);
+}
+
+TEST(SharedPtr, Atomic_Stress) {
+  AtomicStressTest(/*readers=*/4, /*writers=*/2, 3s);
+}
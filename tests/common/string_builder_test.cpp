@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <magic/common/string_builder.h>
+
+#include <string>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+static std::string Join(const std::vector<iovec>& vectors) {
+  std::string result;
+  for (const auto& vector : vectors) {
+    result.append(static_cast<const char*>(vector.iov_base), vector.iov_len);
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(StringBuilder, Append) {
+  StringBuilder builder;
+  ASSERT_TRUE(builder.IsEmpty());
+
+  builder << "status: " << 200 << ' ' << std::string("OK") << ' ' << 1.5;
+  builder.Append("!", 1);
+  ASSERT_EQ(builder.View(), "status: 200 OK 1.5!");
+  ASSERT_EQ(builder.Size(), 19);
+  ASSERT_EQ(builder.ToString(), "status: 200 OK 1.5!");
+}
+
+TEST(StringBuilder, GrowsPastInlineBuffer) {
+  StringBuilder builder;
+  std::string expected;
+  for (size_t index = 0; index < 1000; ++index) {
+    builder << index << ',';
+    expected += std::to_string(index) + ',';
+  }
+  ASSERT_EQ(builder.View(), expected);
+
+  // A single append larger than the doubled capacity
+  const std::string large(10'000, 'x');
+  builder.Append(large);
+  expected += large;
+  ASSERT_EQ(builder.View(), expected);
+}
+
+TEST(StringBuilder, AppendFormat) {
+  StringBuilder builder;
+  builder.AppendFormat("{}-{:04}", "id", 7);
+  ASSERT_EQ(builder.View(), "id-0007");
+
+  // Does not fit into the free space: formatted again after growing
+  builder.AppendFormat("{:>500}", "end");
+  ASSERT_EQ(builder.Size(), 507);
+  ASSERT_TRUE(builder.View().ends_with(" end"));
+}
+
+TEST(StringBuilder, Release) {
+  StringBuilder builder;
+  builder << "short";
+  ASSERT_EQ(builder.Release(), "short");
+  ASSERT_TRUE(builder.IsEmpty());
+
+  const std::string large(1000, 'y');
+  builder << large;
+  const char* data = builder.View().data();
+  auto released = builder.Release();
+  ASSERT_EQ(released, large);
+  // Moved out of the heap buffer
+  ASSERT_EQ(released.data(), data);
+
+  // Usable afterwards
+  builder << "again";
+  ASSERT_EQ(builder.View(), "again");
+}
+
+TEST(StringBuilder, Reserve) {
+  StringBuilder builder;
+  builder.Reserve(4096);
+  builder << "head";
+  const char* data = builder.View().data();
+  builder << std::string(4000, 'z');
+  ASSERT_EQ(builder.View().data(), data);
+}
+
+TEST(StringBuilder, ExternalParts) {
+  const std::string body(100'000, 'b');
+
+  StringBuilder builder;
+  builder << "HTTP/1.1 200 OK\r\n\r\n";
+  builder.AppendExternal(body);
+  builder << "trailer";
+
+  const auto vectors = builder.Iovecs();
+  ASSERT_EQ(vectors.size(), 3);
+  // Referenced, not copied
+  ASSERT_EQ(vectors[1].iov_base, body.data());
+
+  const auto expected = "HTTP/1.1 200 OK\r\n\r\n" + body + "trailer";
+  ASSERT_EQ(Join(vectors), expected);
+  ASSERT_EQ(builder.Size(), expected.size());
+  ASSERT_EQ(builder.ToString(), expected);
+  ASSERT_EQ(builder.Release(), expected);
+}
+
+TEST(StringBuilder, Clear) {
+  StringBuilder builder;
+  builder << std::string(1000, 'c');
+  builder.Clear();
+  ASSERT_TRUE(builder.IsEmpty());
+  ASSERT_TRUE(builder.Iovecs().empty());
+}
@@ -10,6 +10,12 @@ TEST(StringReader, Empty) {
   auto reader = StringReader(source);
   ASSERT_TRUE(reader.IsEmpty());
   ASSERT_FALSE(reader.HasNext());
+
+  // A default string_view has no data pointer at all
+  auto null_reader = StringReader(std::string_view{});
+  ASSERT_TRUE(null_reader.ReadUntil('x').empty());
+  null_reader.SkipUntil('x').SkipAfter('x').SkipSpaces();
+  ASSERT_TRUE(null_reader.IsEmpty());
 }
 
 TEST(StringReader, Next) {
@@ -208,4 +214,59 @@ TEST(StringReader, ParseHttpHeader) {
   ASSERT_EQ(reader.SkipOne().SkipSpaces().ReadToEndLine(), "Express");
   ASSERT_EQ(reader.SkipSpaces().ReadUntil(':'), "Content-Type");
   ASSERT_EQ(reader.SkipOne().SkipSpaces().ReadToEndLine(), "application/json; charset=utf-8");
-}
\ No newline at end of file
+}
+
+TEST(StringReader, ReadDoubleStopsAtView) {
+  // The digits after the view must not be parsed
+  const auto source = std::string("1.25999");
+  auto reader = StringReader(std::string_view(source).substr(0, 4));
+
+  ASSERT_DOUBLE_EQ(reader.ReadDouble(), 1.25);
+  ASSERT_TRUE(reader.IsEmpty());
+}
+
+TEST(StringReader, ReadDoubleFormats) {
+  const auto source = std::string("-0.5 1e3 7,25 x");
+  auto reader = StringReader(source);
+
+  ASSERT_DOUBLE_EQ(reader.ReadDouble(), -0.5);
+  ASSERT_DOUBLE_EQ(reader.SkipSpaces().ReadDouble(), 1000.0);
+  // The fraction after a comma is skipped
+  ASSERT_DOUBLE_EQ(reader.SkipSpaces().ReadDouble(), 7.0);
+  ASSERT_TRUE(reader.Next(' '));
+  ASSERT_THROW(reader.SkipSpaces().ReadDouble(), std::invalid_argument);
+}
+
+TEST(StringReader, ReadDoubleSign) {
+  // Like std::stod
+  ASSERT_DOUBLE_EQ(StringReader("+2.5").ReadDouble(), 2.5);
+  ASSERT_DOUBLE_EQ(StringReader("+.5").ReadDouble(), 0.5);
+  ASSERT_THROW(StringReader("+-1").ReadDouble(), std::invalid_argument);
+  ASSERT_THROW(StringReader("++1").ReadDouble(), std::invalid_argument);
+  ASSERT_THROW(StringReader("+").ReadDouble(), std::invalid_argument);
+}
+
+TEST(StringReader, ReadDoubleOutOfRange) {
+  ASSERT_THROW(StringReader("1e400").ReadDouble(), std::out_of_range);
+  ASSERT_THROW(StringReader("-1e400").ReadDouble(), std::out_of_range);
+  ASSERT_DOUBLE_EQ(StringReader("1e300").ReadDouble(), 1e300);
+}
+
+TEST(StringReader, LongRuns) {
+  // Runs crossing every vector width and tail length
+  for (size_t length = 0; length < 100; ++length) {
+    const auto spaces = std::string(length, ' ') + "\t\r\n\v\f" + "x";
+    ASSERT_EQ(StringReader(spaces).SkipSpaces().Length(), 1);
+
+    const auto digits = std::string(length, '7') + "/";
+    ASSERT_EQ(StringReader(digits).SkipDigits().Length(), 1);
+
+    const auto text = std::string(length, 'a') + ":b";
+    auto reader = StringReader(text);
+    ASSERT_EQ(reader.ReadUntil(':').size(), length);
+    ASSERT_EQ(reader.SkipAfter(':').ReadOne(), 'b');
+
+    // Not found: everything is consumed
+    ASSERT_TRUE(StringReader(std::string_view(text).substr(0, length)).SkipUntil(':').IsEmpty());
+  }
+}
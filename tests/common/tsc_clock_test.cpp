@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/common/tsc_clock.h>
+
+#include <thread>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(TscClock, Monotonic) {
+  auto previous = TscClock::now();
+  for (size_t step = 0; step < 100'000; ++step) {
+    const auto now = TscClock::now();
+    ASSERT_GE(now, previous);
+    previous = now;
+  }
+}
+
+TEST(TscClock, AgreesWithSteadyClock) {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+
+  // Aligned to the steady_clock epoch
+  const auto steady = duration_cast<nanoseconds>(Clock::now().time_since_epoch());
+  const auto tsc = TscClock::now().time_since_epoch();
+  ASSERT_LT(std::chrono::abs(tsc - steady), 1ms);
+
+  // Rate within 0.5%
+  const auto steady_start = Clock::now();
+  const auto tsc_start = TscClock::now();
+  const auto ticks_start = TscClock::Ticks();
+  std::this_thread::sleep_for(100ms);
+  const auto ticks_elapsed = TscClock::TicksToDuration(TscClock::Ticks() - ticks_start);
+  const auto tsc_elapsed = TscClock::now() - tsc_start;
+  const auto steady_elapsed = duration_cast<nanoseconds>(Clock::now() - steady_start);
+
+  ASSERT_NEAR(tsc_elapsed.count(), steady_elapsed.count(), steady_elapsed.count() / 200);
+  ASSERT_NEAR(ticks_elapsed.count(), steady_elapsed.count(), steady_elapsed.count() / 200);
+}
+
+TEST(TscClock, Frequency) {
+  if (!TscClock::IsReliable()) {
+    GTEST_SKIP() << "No invariant TSC, steady_clock fallback";
+  }
+  ASSERT_GT(TscClock::TicksPerSecond(), 1e8);
+  ASSERT_LT(TscClock::TicksPerSecond(), 1e10);
+
+#if defined(__x86_64__)
+  const auto start = detail::ReadTscFenced();
+  ASSERT_GT(detail::ReadTscp(), start);
+#endif
+}
+
+TEST(TscStopwatch, JustWorks) {
+  TscStopwatch stopwatch;
+  std::this_thread::sleep_for(20ms);
+  ASSERT_GE(stopwatch.Elapsed(), 19ms);
+  ASSERT_LT(stopwatch.Elapsed(), 1s);
+
+  stopwatch.Reset();
+  ASSERT_LT(stopwatch.ElapsedMs(), 10);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+
+#include <magic/concurrency/blocking_wait_group.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(BlockingWaitGroup, JustWorks) {
+  BlockingWaitGroup group;
+  group.Wait();
+
+  std::atomic<size_t> done = 0;
+  std::vector<std::thread> threads;
+  group.Add(4);
+  for (size_t index = 0; index < 4; ++index) {
+    threads.emplace_back([&] {
+      ++done;
+      group.Done();
+    });
+  }
+  group.Wait();
+  ASSERT_EQ(done.load(), 4);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(BlockingWaitGroup, DestroyAfterWait) {
+  // The owner is freed as soon as Wait returns, racing Done calls must not
+  // touch it afterwards (run under ASan / TSan)
+  for (size_t round = 0; round < 1000; ++round) {
+    auto group = std::make_unique<BlockingWaitGroup>();
+    group->Add(2);
+    std::thread first([raw = group.get()] {
+      raw->Done();
+    });
+    std::thread second([raw = group.get()] {
+      raw->Done();
+    });
+    group->Wait();
+    group.reset();
+    first.join();
+    second.join();
+  }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <magic/concurrency/concurrent_hash_map.h>
+#include <magic/common/random.h>
+#include <magic/common/stopwatch.h>
+
+#include <twist/test/race.hpp>
+
+#include <fmt/core.h>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(ConcurrentHashMap, JustWorks) {
+  ConcurrentDictionary map;
+
+  ASSERT_TRUE(map.IsEmpty());
+  ASSERT_TRUE(map.Insert("key", "value"));
+  ASSERT_FALSE(map.Insert("key", "other"));
+
+  ASSERT_EQ(map.Size(), 1);
+  ASSERT_EQ(map.Find(std::string_view{"key"}), "other");
+  ASSERT_TRUE(map.Contains("key"));
+  ASSERT_FALSE(map.Find(std::string_view{"missing"}));
+
+  ASSERT_TRUE(map.Erase(std::string_view{"key"}));
+  ASSERT_FALSE(map.Erase(std::string_view{"key"}));
+  ASSERT_TRUE(map.IsEmpty());
+}
+
+TEST(ConcurrentHashMap, Collisions) {
+  ConcurrentHashMap<int, int> map;
+
+  // Same bucket in the initial table
+  for (int key = 0; key < 10; ++key) {
+    map.Insert(key * 64, key);
+  }
+  for (int key = 0; key < 10; ++key) {
+    ASSERT_EQ(map.Find(key * 64), key);
+  }
+
+  map.Erase(5 * 64);
+  map.Insert(3 * 64, 42);
+
+  ASSERT_FALSE(map.Contains(5 * 64));
+  ASSERT_EQ(map.Find(3 * 64), 42);
+  ASSERT_EQ(map.Find(9 * 64), 9);
+  ASSERT_EQ(map.Size(), 9);
+}
+
+TEST(ConcurrentHashMap, Resize) {
+  ConcurrentHashMap<int, int> map;
+  const auto initial_buckets = map.BucketCount();
+
+  static const int kCount = 100'000;
+
+  for (int key = 0; key < kCount; ++key) {
+    map.Insert(key, key * 2);
+    // Readers observe every element at any point of the migration
+    ASSERT_EQ(map.Find(key / 2), key / 2 * 2);
+  }
+
+  ASSERT_GT(map.BucketCount(), initial_buckets);
+  ASSERT_EQ(map.Size(), kCount);
+
+  for (int key = 0; key < kCount; ++key) {
+    ASSERT_EQ(map.Find(key), key * 2);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+void StressTest(size_t threads, size_t key_range, Duration duration) {
+  ConcurrentHashMap<size_t, size_t> map;
+
+  Stopwatch stopwatch;
+  twist::test::Race race;
+  std::atomic<size_t> ops{0};
+
+  for (size_t thread = 0; thread < threads; ++thread) {
+    race.Add([&, thread] {
+      // Keys equal to thread modulo threads are owned by this thread
+      size_t key = thread;
+      while (stopwatch.Elapsed() < duration && key < key_range) {
+        // Transient key
+        const auto transient = key_range + key;
+        ASSERT_TRUE(map.Insert(transient, transient));
+        ASSERT_EQ(map.Find(transient), transient);
+        ASSERT_TRUE(map.Erase(transient));
+        ASSERT_FALSE(map.Contains(transient));
+
+        // Persistent key, makes the map grow
+        ASSERT_TRUE(map.Insert(key, key));
+
+        auto other = Random::Next(key_range);
+        if (auto value = map.Find(other)) {
+          ASSERT_EQ(*value, other);
+        }
+
+        key += threads;
+        ops.fetch_add(1);
+      }
+    });
+  }
+
+  race.Run();
+
+  fmt::println("Operations: {}, size: {}, buckets: {}", ops.load(), map.Size(), map.BucketCount());
+  ASSERT_EQ(map.Size(), ops.load());
+}
+
+TEST(ConcurrentHashMap, Stress) {
+  StressTest(4, 1'000'000, 3s);
+}
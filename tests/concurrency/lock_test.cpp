@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include <magic/concurrency/adaptive_lock.h>
+#include <magic/concurrency/mcs_lock.h>
+#include <magic/concurrency/spinlock.h>
+#include <magic/concurrency/ticket_lock.h>
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+static const size_t kThreads = 4;
+static const size_t kIterations = 20'000;
+
+template <typename F>
+void RunContenders(F&& routine) {
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < kThreads; ++index) {
+    threads.emplace_back(routine);
+  }
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+}
+
+template <typename Lock>
+void TestMutualExclusion() {
+  Lock lock;
+  size_t counter = 0;
+
+  RunContenders([&] {
+    for (size_t index = 0; index < kIterations; ++index) {
+      std::lock_guard guard(lock);
+      ++counter;
+    }
+  });
+
+  ASSERT_EQ(counter, kThreads * kIterations);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(Locks, SpinLock) {
+  TestMutualExclusion<SpinLock>();
+}
+
+TEST(Locks, TicketLock) {
+  TestMutualExclusion<TicketLock>();
+}
+
+TEST(Locks, AdaptiveLock) {
+  TestMutualExclusion<AdaptiveLock>();
+}
+
+TEST(Locks, MCSLock) {
+  MCSLock lock;
+  size_t counter = 0;
+
+  RunContenders([&] {
+    for (size_t index = 0; index < kIterations; ++index) {
+      MCSLock::Guard guard(lock);
+      ++counter;
+    }
+  });
+
+  ASSERT_EQ(counter, kThreads * kIterations);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(Locks, TryLock) {
+  TicketLock ticket;
+  ASSERT_TRUE(ticket.TryLock());
+  ASSERT_FALSE(ticket.TryLock());
+  ticket.Unlock();
+  ASSERT_TRUE(ticket.TryLock());
+  ticket.Unlock();
+
+  AdaptiveLock adaptive;
+  ASSERT_TRUE(adaptive.TryLock());
+  ASSERT_FALSE(adaptive.TryLock());
+  adaptive.Unlock();
+
+  MCSLock mcs;
+  MCSLock::Node first, second;
+  ASSERT_TRUE(mcs.TryLock(first));
+  ASSERT_FALSE(mcs.TryLock(second));
+  mcs.Unlock(first);
+  ASSERT_TRUE(mcs.TryLock(second));
+  mcs.Unlock(second);
+}
+
+// Parked waiters must be woken up
+TEST(Locks, AdaptiveLockParks) {
+  AdaptiveLock lock{/*spin_budget=*/0};
+  size_t counter = 0;
+
+  lock.Lock();
+  std::thread waiter([&] {
+    std::lock_guard guard(lock);
+    ++counter;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ++counter;
+  lock.Unlock();
+  waiter.join();
+
+  ASSERT_EQ(counter, 2);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <magic/concurrency/seqlock.h>
+#include <magic/fibers/core/metrics.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(SeqLock, JustWorks) {
+  SeqLock<AllocatorMetrics> metrics;
+  ASSERT_EQ(metrics.Load().total_allocate, 0);
+
+  metrics.Update([](AllocatorMetrics& m) {
+    ++m.total_allocate;
+    m.total_allocate_bytes += 42;
+  });
+
+  auto snapshot = metrics.Load();
+  ASSERT_EQ(snapshot.total_allocate, 1);
+  ASSERT_EQ(snapshot.total_allocate_bytes, 42);
+
+  metrics.Store(AllocatorMetrics{});
+  ASSERT_EQ(metrics.Load().total_allocate_bytes, 0);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Odd size, not a multiple of the word size
+struct Snapshot {
+  uint32_t values[5];
+  uint8_t tag;
+};
+
+TEST(SeqLock, NoTornReads) {
+  static const size_t kReaders = 3;
+  static const uint32_t kWrites = 100'000;
+
+  SeqLock<Snapshot> lock;
+  std::atomic<bool> stop = false;
+
+  std::vector<std::thread> readers;
+  for (size_t index = 0; index < kReaders; ++index) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        auto snapshot = lock.Load();
+        for (auto value : snapshot.values) {
+          ASSERT_EQ(value, snapshot.values[0]);
+        }
+        ASSERT_EQ(snapshot.tag, uint8_t(snapshot.values[0]));
+      }
+    });
+  }
+
+  std::thread writer([&] {
+    for (uint32_t write = 1; write <= kWrites; ++write) {
+      lock.Update([write](Snapshot& snapshot) {
+        for (auto& value : snapshot.values) {
+          value = write;
+        }
+        snapshot.tag = uint8_t(write);
+      });
+    }
+    stop.store(true);
+  });
+
+  writer.join();
+  for (auto&& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(lock.Load().values[4], kWrites);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(SeqLock, ConcurrentWriters) {
+  static const size_t kWriters = 4;
+  static const size_t kIncrements = 20'000;
+
+  SeqLock<AllocatorMetrics> metrics;
+
+  std::vector<std::thread> writers;
+  for (size_t index = 0; index < kWriters; ++index) {
+    writers.emplace_back([&] {
+      for (size_t index = 0; index < kIncrements; ++index) {
+        metrics.Update([](AllocatorMetrics& m) {
+          ++m.release_count;
+        });
+      }
+    });
+  }
+  for (auto&& writer : writers) {
+    writer.join();
+  }
+
+  ASSERT_EQ(metrics.Load().release_count, kWriters * kIncrements);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <magic/concurrency/sharded_counter.h>
+#include <magic/concurrency/atomic_counter.h>
+#include <magic/executors/execute.h>
+#include <magic/executors/thread_pool.h>
+
+#include <thread>
+#include <vector>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(ShardedCounter, JustWorks) {
+  ShardedCounter counter;
+  ASSERT_EQ(counter.Sum(), 0);
+
+  counter.Increment();
+  counter.Add(10);
+  counter.Decrement();
+
+  ASSERT_EQ(counter.Sum(), 10);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(ShardedCounter, ManyThreads) {
+  static const size_t kThreads = 8;
+  static const size_t kIncrements = 100'000;
+
+  ShardedCounter counter{4};
+
+  std::vector<std::thread> threads;
+  for (size_t index = 0; index < kThreads; ++index) {
+    threads.emplace_back([&counter] {
+      for (size_t index = 0; index < kIncrements; ++index) {
+        counter.Increment();
+      }
+    });
+  }
+
+  for (auto&& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(counter.Sum(), kThreads * kIncrements);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(AtomicCounter, WaitZero) {
+  AtomicCounter counter;
+  ASSERT_TRUE(counter.IsZero());
+
+  counter.Add(2);
+  ASSERT_FALSE(counter.IsZero());
+
+  std::thread worker([&counter] {
+    std::this_thread::sleep_for(100ms);
+    counter.Done();
+    counter.Done();
+  });
+
+  counter.WaitZero();
+  ASSERT_TRUE(counter.IsZero());
+
+  worker.join();
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Tasks submit more tasks from different worker threads,
+// WaitIdle must not observe a transient zero in between
+
+void Spawn(ThreadPool& pool, std::atomic<size_t>& done, size_t depth) {
+  Execute(pool, [&pool, &done, depth] {
+    if (depth > 0) {
+      Spawn(pool, done, depth - 1);
+      Spawn(pool, done, depth - 1);
+    }
+    done.fetch_add(1);
+  });
+}
+
+TEST(AtomicCounter, ThreadPoolNestedWork) {
+  static const size_t kDepth = 12;
+
+  ThreadPool pool{4};
+
+  for (size_t round = 0; round < 10; ++round) {
+    std::atomic<size_t> done = 0;
+    Spawn(pool, done, kDepth);
+
+    pool.WaitIdle();
+    ASSERT_EQ(done.load(), (1u << (kDepth + 1)) - 1);
+  }
+
+  pool.Stop();
+}
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <magic/concurrency/shared_mutex.h>
+
+#include <fmt/core.h>
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(SharedMutex, JustWorks) {
+  SharedMutex mutex;
+
+  {
+    std::shared_lock first(mutex);
+    std::shared_lock second(mutex);
+  }
+
+  {
+    std::lock_guard guard(mutex);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(SharedMutex, WriterWaitsForReaders) {
+  SharedMutex mutex;
+  std::atomic<bool> written = false;
+
+  mutex.LockShared();
+
+  std::thread writer([&] {
+    std::lock_guard guard(mutex);
+    written.store(true);
+  });
+
+  std::this_thread::sleep_for(100ms);
+  ASSERT_FALSE(written.load());
+
+  mutex.UnlockShared();
+  writer.join();
+  ASSERT_TRUE(written.load());
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(SharedMutex, Stress) {
+  static const size_t kReaders = 4;
+  static const size_t kWrites = 10'000;
+
+  SharedMutex mutex;
+  // Invariant: first == second
+  size_t first = 0;
+  size_t second = 0;
+
+  std::atomic<bool> stop = false;
+  std::atomic<size_t> reads = 0;
+
+  std::vector<std::thread> readers;
+  for (size_t index = 0; index < kReaders; ++index) {
+    readers.emplace_back([&] {
+      while (!stop.load()) {
+        std::shared_lock lock(mutex);
+        ASSERT_EQ(first, second);
+        reads.fetch_add(1, std::memory_order::relaxed);
+      }
+    });
+  }
+
+  std::thread writer([&] {
+    for (size_t write = 0; write < kWrites; ++write) {
+      std::lock_guard guard(mutex);
+      ++first;
+      ++second;
+    }
+    stop.store(true);
+  });
+
+  writer.join();
+  for (auto&& reader : readers) {
+    reader.join();
+  }
+
+  ASSERT_EQ(first, kWrites);
+  fmt::println("Reads: {}", reads.load());
+}
@@ -342,4 +342,33 @@ TEST(ThreadPool, Race) {
 
   ASSERT_EQ(round_counter.load(), rounds);
   ASSERT_LE(shared_value.load(), rounds);
-}
\ No newline at end of file
+}
+//////////////////////////////////////////////////////////////////////
+
+TEST(ThreadPool, Metrics) {
+  ThreadPool pool{2};
+  Histogram task_times;
+  pool.RecordTaskTimes(&task_times);
+
+  for (size_t it = 0; it < 4; ++it) {
+    Execute(pool, [&]() {
+      std::this_thread::sleep_for(50ms);
+    });
+  }
+  for (size_t it = 0; it < 1000; ++it) {
+    Execute(pool, []() {});
+  }
+
+  pool.WaitIdle();
+  const auto metrics = pool.GetMetrics();
+  pool.Stop();
+
+  ASSERT_EQ(metrics.CompletedTasks, 1004);
+  ASSERT_GE(metrics.BusyTime, 190ms);
+  ASSERT_LT(metrics.BusyTime, 1s);
+
+  const auto snapshot = task_times.Snapshot();
+  ASSERT_EQ(snapshot.Count(), 1004);
+  ASSERT_GE(snapshot.Max(), 50'000'000);
+  ASSERT_LT(snapshot.Percentile(50), 1'000'000);
+}
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <magic/concurrency/atomic_counter.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/fibers/api.h>
+#include <magic/filesystem/async_io.h>
+#include <magic/filesystem/file.h>
+#include <magic/futures/get.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+class AsyncIoTest : public ::testing::TestWithParam<AsyncIo::Backend> {};
+
+INSTANTIATE_TEST_SUITE_P(Backends, AsyncIoTest,
+                         ::testing::Values(AsyncIo::Backend::IoUring,
+                                           AsyncIo::Backend::ThreadPool),
+                         [](const auto& info) {
+                           return info.param == AsyncIo::Backend::IoUring ? "IoUring"
+                                                                          : "ThreadPool";
+                         });
+
+static bool Skip(AsyncIo::Backend backend) {
+  return backend == AsyncIo::Backend::IoUring &&
+         AsyncIo::DefaultBackend() != AsyncIo::Backend::IoUring;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST_P(AsyncIoTest, WriteThenRead) {
+  if (Skip(GetParam())) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  AsyncIo io{GetParam()};
+
+  auto file = AsyncFile::Open("async_io_rw.bin", AsyncFile::Mode::Create, io).ValueOrThrow();
+
+  const std::string text = "Hello, io_uring";
+  ASSERT_EQ(file.WriteAt(0, text).ValueOrThrow(), text.size());
+  ASSERT_EQ(file.WriteAt(text.size(), text).ValueOrThrow(), text.size());
+  file.Sync().ThrowIfError();
+
+  std::string buffer(64, '\0');
+  auto bytes = file.ReadAt(text.size(), buffer).ValueOrThrow();
+  // Short read at the end of the file
+  ASSERT_EQ(bytes, text.size());
+  ASSERT_EQ(buffer.substr(0, bytes), text);
+
+  ASSERT_EQ(file.ReadAt(1000, buffer).ValueOrThrow(), 0);
+  ASSERT_EQ(io.InFlight(), 0);
+}
+
+TEST_P(AsyncIoTest, ManyConcurrentReads) {
+  if (Skip(GetParam())) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  // More operations than the queue depth
+  AsyncIo io{GetParam(), 8};
+
+  std::vector<char> content(1 << 20);
+  std::iota(content.begin(), content.end(), 0);
+  File::WriteAllText("async_io_many.bin", {content.data(), content.size()}).ThrowIfError();
+
+  auto file = AsyncFile::Open("async_io_many.bin", AsyncFile::Mode::Read, io).ValueOrThrow();
+
+  const size_t kBlock = 4096;
+  std::vector<std::vector<char>> buffers(content.size() / kBlock, std::vector<char>(kBlock));
+  std::vector<Future<size_t>> reads;
+  for (size_t index = 0; index < buffers.size(); ++index) {
+    reads.push_back(file.ReadAtAsync(index * kBlock, buffers[index]));
+  }
+
+  for (size_t index = 0; index < reads.size(); ++index) {
+    ASSERT_EQ(futures::WaitValue(std::move(reads[index])), kBlock);
+    ASSERT_TRUE(std::equal(buffers[index].begin(), buffers[index].end(),
+                           content.begin() + index * kBlock));
+  }
+}
+
+TEST_P(AsyncIoTest, Errors) {
+  if (Skip(GetParam())) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  AsyncIo io{GetParam()};
+
+  ASSERT_TRUE(AsyncFile::Open("async_io_missing.bin", AsyncFile::Mode::Read, io).HasError());
+
+  // Not opened for writing
+  File::WriteAllText("async_io_ro.bin", "data").ThrowIfError();
+  auto file = AsyncFile::Open("async_io_ro.bin", AsyncFile::Mode::Read, io).ValueOrThrow();
+  auto result = file.WriteAt(0, std::string_view{"x"});
+  ASSERT_TRUE(result.HasError());
+  ASSERT_EQ(result.Error().ErrorCode(), std::errc::bad_file_descriptor);
+}
+
+TEST_P(AsyncIoTest, FibersSuspend) {
+  if (Skip(GetParam())) {
+    GTEST_SKIP() << "io_uring is not available";
+  }
+  AsyncIo io{GetParam()};
+
+  std::string content(64 * 1024, 'f');
+  File::WriteAllText("async_io_fibers.bin", content).ThrowIfError();
+  auto file = AsyncFile::Open("async_io_fibers.bin", AsyncFile::Mode::Read, io).ValueOrThrow();
+
+  ThreadPool scheduler{1};
+  std::atomic<size_t> total = 0;
+  // Parked fibers do not count as pool work, WaitIdle is not enough
+  AtomicCounter fibers;
+  for (size_t index = 0; index < 16; ++index) {
+    fibers.Add();
+    Go(scheduler, [&, index] {
+      std::string buffer(4096, '\0');
+      total.fetch_add(file.ReadAt(index * 4096, buffer).ValueOrThrow());
+      fibers.Done();
+    });
+  }
+  fibers.WaitZero();
+  scheduler.Stop();
+
+  ASSERT_EQ(total.load(), content.size());
+}
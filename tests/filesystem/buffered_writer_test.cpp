@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "../test_helper.h"
+
+#include <magic/filesystem/buffered_writer.h>
+#include <magic/filesystem/file.h>
+
+#include <string>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+static std::string MakeText(size_t size) {
+  std::string text;
+  for (size_t index = 0; text.size() < size; ++index) {
+    text += std::to_string(index) + ',';
+  }
+  text.resize(size);
+  return text;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(BufferedWriter, SmallAndLargeWrites) {
+  auto writer = BufferedWriter::Open("writer_mixed.txt", {.BufferSize = 64}).ValueOrThrow();
+
+  std::string expected;
+  // Fits, tops up the buffer, bypasses the buffer
+  for (size_t size : {10, 40, 30, 200, 5, 64, 63, 1000}) {
+    auto piece = MakeText(size);
+    writer.Write(piece).ThrowIfError();
+    expected += piece;
+  }
+  writer.WriteLine("line").ThrowIfError();
+  expected += "line\n";
+
+  ASSERT_EQ(writer.BytesWritten(), expected.size());
+  writer.Close().ThrowIfError();
+  ASSERT_EQ(ReadText("writer_mixed.txt"), expected);
+}
+
+TEST(BufferedWriter, FlushMakesDataVisible) {
+  auto writer = BufferedWriter::Open("writer_flush.txt").ValueOrThrow();
+  writer.Write("buffered").ThrowIfError();
+  ASSERT_EQ(ReadText("writer_flush.txt"), "");
+
+  writer.Flush().ThrowIfError();
+  ASSERT_EQ(ReadText("writer_flush.txt"), "buffered");
+}
+
+TEST(BufferedWriter, Append) {
+  File::WriteAllText("writer_append.txt", "head\n").ThrowIfError();
+  {
+    auto writer = BufferedWriter::Open("writer_append.txt", {.Append = true}).ValueOrThrow();
+    writer.WriteLine("tail").ThrowIfError();
+    // Closed by the destructor
+  }
+  File::AppendAllText("writer_append.txt", "more").ThrowIfError();
+
+  ASSERT_EQ(ReadText("writer_append.txt"), "head\ntail\nmore");
+}
+
+TEST(BufferedWriter, Preallocate) {
+  auto writer =
+      BufferedWriter::Open("writer_prealloc.txt", {.Preallocate = 1 << 20}).ValueOrThrow();
+  writer.Write("small").ThrowIfError();
+  writer.Close().ThrowIfError();
+
+  // The reservation does not change the size
+  ASSERT_EQ(ReadText("writer_prealloc.txt"), "small");
+}
+
+TEST(BufferedWriter, Direct) {
+  auto writer = BufferedWriter::Open("writer_direct.txt", {.BufferSize = 8192, .Direct = true});
+  if (writer.HasError()) {
+    GTEST_SKIP() << "O_DIRECT is not supported here";
+  }
+
+  std::string expected;
+  for (size_t size : {100, 5000, 20000, 3}) {
+    auto piece = MakeText(size);
+    writer->Write(piece).ThrowIfError();
+    expected += piece;
+  }
+
+  // The padded tail block is truncated away and rewritten later
+  writer->Sync().ThrowIfError();
+  ASSERT_EQ(ReadText("writer_direct.txt"), expected);
+
+  writer->WriteLine("after sync").ThrowIfError();
+  expected += "after sync\n";
+  writer->Close().ThrowIfError();
+  ASSERT_EQ(ReadText("writer_direct.txt"), expected);
+}
+
+TEST(BufferedWriter, Errors) {
+  ASSERT_TRUE(BufferedWriter::Open("missing_directory/file.txt").HasError());
+  ASSERT_TRUE(BufferedWriter::Open("writer_bad.txt", {.Append = true, .Direct = true}).HasError());
+}
+
+TEST(BufferedWriter, WriteAllLinesRoundTrip) {
+  File::TextLines lines;
+  for (size_t index = 0; index < 100'000; ++index) {
+    lines.push_back(MakeText(index % 50));
+  }
+  File::WriteAllLines("writer_lines.txt", lines).ThrowIfError();
+  ASSERT_EQ(File::ReadAllLines("writer_lines.txt").ValueOrThrow(), lines);
+}
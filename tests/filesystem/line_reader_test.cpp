@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <magic/filesystem/file.h>
+#include <magic/filesystem/line_reader.h>
+
+#include <string>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> ReadWithReader(std::string_view path, size_t buffer_size) {
+  auto reader = LineReader::Open(path, buffer_size).ValueOrThrow();
+  std::vector<std::string> lines;
+  for (std::string_view line : reader.Lines()) {
+    lines.emplace_back(line);
+  }
+  reader.GetStatus().ThrowIfError();
+  return lines;
+}
+
+static std::vector<std::string> ReadWithStream(std::string_view path, size_t block_size) {
+  auto stream = LineStream::Open(path, block_size, /*queue_depth=*/2).ValueOrThrow();
+  std::vector<std::string> lines;
+  for (std::string_view line : stream->Lines()) {
+    lines.emplace_back(line);
+  }
+  stream->GetStatus().ThrowIfError();
+  return lines;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(LineReader, MatchesReadAllLines) {
+  std::string text;
+  for (size_t index = 0; index < 10'000; ++index) {
+    text += std::string(index % 37, 'a' + index % 26) + '\n';
+  }
+  File::WriteAllText("line_reader.txt", text).ThrowIfError();
+  const auto expected = File::ReadAllLines("line_reader.txt").ValueOrThrow();
+
+  // Tiny buffers make lines cross every buffer boundary
+  for (size_t buffer_size : {1, 7, 64, 4096, 1 << 20}) {
+    ASSERT_EQ(ReadWithReader("line_reader.txt", buffer_size), expected) << buffer_size;
+    ASSERT_EQ(ReadWithStream("line_reader.txt", buffer_size), expected) << buffer_size;
+  }
+}
+
+TEST(LineReader, Edges) {
+  const std::vector<std::pair<std::string, std::vector<std::string>>> cases = {
+      {"", {}},
+      {"\n", {""}},
+      {"no newline", {"no newline"}},
+      {"a\n\nb", {"a", "", "b"}},
+      {"a\nb\n", {"a", "b"}},
+  };
+  for (const auto& [text, expected] : cases) {
+    File::WriteAllText("line_reader_edges.txt", text).ThrowIfError();
+    ASSERT_EQ(ReadWithReader("line_reader_edges.txt", 2), expected) << text;
+    ASSERT_EQ(ReadWithStream("line_reader_edges.txt", 2), expected) << text;
+  }
+}
+
+TEST(LineReader, LineLongerThanBuffer) {
+  const std::string line(100'000, 'x');
+  File::WriteAllText("line_reader_long.txt", "a\n" + line + "\nb\n").ThrowIfError();
+
+  const std::vector<std::string> expected = {"a", line, "b"};
+  ASSERT_EQ(ReadWithReader("line_reader_long.txt", 16), expected);
+  ASSERT_EQ(ReadWithStream("line_reader_long.txt", 16), expected);
+}
+
+TEST(LineReader, Generator) {
+  File::WriteAllText("line_reader_generator.txt", "one\ntwo\nthree\n").ThrowIfError();
+  auto reader = LineReader::Open("line_reader_generator.txt", 4).ValueOrThrow();
+
+  auto lines = GenerateLines(reader);
+  std::vector<std::string> received;
+  while (auto line = lines.Receive()) {
+    received.emplace_back(*line);
+  }
+  ASSERT_EQ(received, (std::vector<std::string>{"one", "two", "three"}));
+}
+
+TEST(LineReader, OpenMissingFile) {
+  ASSERT_TRUE(LineReader::Open("line_reader_missing.txt").HasError());
+  ASSERT_TRUE(LineStream::Open("line_reader_missing.txt").HasError());
+}
+
+TEST(LineStream, StopEarly) {
+  std::string text;
+  for (size_t index = 0; index < 100'000; ++index) {
+    text += std::to_string(index) + '\n';
+  }
+  File::WriteAllText("line_stream_stop.txt", text).ThrowIfError();
+
+  // The reader thread is blocked on the full queue and must be released
+  auto stream = LineStream::Open("line_stream_stop.txt", 64, 1).ValueOrThrow();
+  ASSERT_EQ(*stream->ReadLine(), "0");
+  ASSERT_EQ(*stream->ReadLine(), "1");
+}
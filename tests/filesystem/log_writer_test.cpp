@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include "../test_helper.h"
+
+#include <magic/concurrency/atomic_counter.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/fibers/api.h>
+#include <magic/filesystem/file.h>
+#include <magic/filesystem/log_writer.h>
+#include <magic/futures/get.h>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(File, WriteAllTextAtomic) {
+  File::WriteAllTextAtomic("atomic.txt", "first").ThrowIfError();
+  ASSERT_EQ(ReadText("atomic.txt"), "first");
+
+  File::WriteAllTextAtomic("atomic.txt", "second").ThrowIfError();
+  ASSERT_EQ(ReadText("atomic.txt"), "second");
+
+  // No temporary files are left behind
+  for (const auto& entry : std::filesystem::directory_iterator(".")) {
+    ASSERT_EQ(entry.path().filename().string().find("atomic.txt.tmp"), std::string::npos);
+  }
+}
+
+TEST(File, WriteAllTextAtomicKeepsPermissions) {
+  namespace fs = std::filesystem;
+
+  File::WriteAllText("atomic_secret.txt", "first").ThrowIfError();
+  fs::permissions("atomic_secret.txt", fs::perms::owner_read | fs::perms::owner_write);
+
+  File::WriteAllTextAtomic("atomic_secret.txt", "second").ThrowIfError();
+  ASSERT_EQ(ReadText("atomic_secret.txt"), "second");
+  ASSERT_EQ(fs::status("atomic_secret.txt").permissions(),
+            fs::perms::owner_read | fs::perms::owner_write);
+}
+
+TEST(File, WriteAllTextAtomicMissingDirectory) {
+  auto status = File::WriteAllTextAtomic("missing_directory/atomic.txt", "text");
+  ASSERT_TRUE(status.HasError());
+  ASSERT_EQ(status.Error().ErrorCode(), std::errc::no_such_file_or_directory);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(LogWriter, AppendReturnsEndOffset) {
+  File::WriteAllText("log_offsets.log", "head\n").ThrowIfError();
+
+  auto log = LogWriter::Open("log_offsets.log").ValueOrThrow();
+  ASSERT_EQ(log->Size(), 5);
+  ASSERT_EQ(log->Append("one\n").ValueOrThrow(), 9);
+  ASSERT_EQ(log->Append("two\n").ValueOrThrow(), 13);
+  ASSERT_EQ(log->Commits(), 2);
+
+  // Durable records are in the file already
+  ASSERT_EQ(ReadText("log_offsets.log"), "head\none\ntwo\n");
+}
+
+TEST(LogWriter, EmptyRecord) {
+  File::WriteAllText("log_empty.log", "head\n").ThrowIfError();
+
+  auto log = LogWriter::Open("log_empty.log").ValueOrThrow();
+  // Completes on its own, without a non-empty record to carry it
+  ASSERT_EQ(log->Append("").ValueOrThrow(), 5);
+  ASSERT_EQ(log->Commits(), 0);
+
+  ASSERT_EQ(log->Append("one\n").ValueOrThrow(), 9);
+  ASSERT_EQ(log->Append("").ValueOrThrow(), 9);
+  ASSERT_EQ(log->Commits(), 1);
+}
+
+TEST(LogWriter, GroupCommit) {
+  std::filesystem::remove("log_group.log");
+  auto log = LogWriter::Open("log_group.log").ValueOrThrow();
+
+  // Queued faster than a single fdatasync completes
+  std::vector<Future<uint64_t>> futures;
+  for (size_t index = 0; index < 1000; ++index) {
+    futures.push_back(log->AppendAsync(std::to_string(index) + '\n'));
+  }
+
+  uint64_t previous = 0;
+  for (auto& future : futures) {
+    const uint64_t end = futures::WaitValue(std::move(future));
+    ASSERT_GT(end, previous);
+    previous = end;
+  }
+  ASSERT_EQ(previous, log->Size());
+  ASSERT_LT(log->Commits(), 1000);
+}
+
+TEST(LogWriter, ConcurrentThreads) {
+  const size_t kThreads = 8;
+  const size_t kRecords = 200;
+
+  std::filesystem::remove("log_threads.log");
+  {
+    auto log = LogWriter::Open("log_threads.log").ValueOrThrow();
+
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < kThreads; ++thread) {
+      threads.emplace_back([&, thread] {
+        for (size_t index = 0; index < kRecords; ++index) {
+          log->Append(fmt::format("{}:{}\n", thread, index)).ThrowIfError();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    ASSERT_LE(log->Commits(), kThreads * kRecords);
+  }
+
+  // Whole records, each thread in its own order
+  auto lines = File::ReadAllLines("log_threads.log").ValueOrThrow();
+  ASSERT_EQ(lines.size(), kThreads * kRecords);
+  std::vector<size_t> next(kThreads, 0);
+  for (const auto& line : lines) {
+    const size_t colon = line.find(':');
+    const size_t thread = std::stoul(line.substr(0, colon));
+    ASSERT_EQ(std::stoul(line.substr(colon + 1)), next[thread]++);
+  }
+}
+
+TEST(LogWriter, FibersSuspend) {
+  std::filesystem::remove("log_fibers.log");
+  auto log = LogWriter::Open("log_fibers.log").ValueOrThrow();
+
+  ThreadPool scheduler{1};
+  // Parked fibers do not count as pool work, WaitIdle is not enough
+  AtomicCounter fibers;
+  for (size_t index = 0; index < 100; ++index) {
+    fibers.Add();
+    Go(scheduler, [&] {
+      log->Append("fiber\n").ThrowIfError();
+      fibers.Done();
+    });
+  }
+  fibers.WaitZero();
+  scheduler.Stop();
+
+  // All fibers were parked on the first commits
+  ASSERT_EQ(log->Size(), 600);
+  ASSERT_LT(log->Commits(), 100);
+}
+
+TEST(LogWriter, DestructorCommitsQueuedRecords) {
+  std::filesystem::remove("log_close.log");
+  std::vector<Future<uint64_t>> futures;
+  {
+    auto log = LogWriter::Open("log_close.log", {.CommitDelay = std::chrono::seconds(10)})
+                   .ValueOrThrow();
+    for (size_t index = 0; index < 10; ++index) {
+      futures.push_back(log->AppendAsync("record\n"));
+    }
+    futures.push_back(log->AppendAsync(""));
+  }
+  for (auto& future : futures) {
+    ASSERT_TRUE(futures::WaitResult(std::move(future)).IsOk());
+  }
+  ASSERT_EQ(ReadText("log_close.log").size(), 70);
+}
+
+TEST(LogWriter, OpenMissingDirectory) {
+  auto log = LogWriter::Open("missing_directory/log.log");
+  ASSERT_TRUE(log.HasError());
+}
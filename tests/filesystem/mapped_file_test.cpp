@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include <magic/filesystem/file.h>
+#include <magic/filesystem/mapped_file.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+static std::vector<std::string> MappedLines(std::string_view path) {
+  auto file = MappedFile::Open(path).ValueOrThrow();
+  std::vector<std::string> lines;
+  for (auto line : file.Lines()) {
+    lines.emplace_back(line);
+  }
+  return lines;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(MappedFile, MissingFile) {
+  auto file = MappedFile::Open("mapped_missing.txt");
+  ASSERT_TRUE(file.HasError());
+  ASSERT_EQ(file.Error().ErrorCode(), std::errc::no_such_file_or_directory);
+}
+
+TEST(MappedFile, EmptyFile) {
+  File::WriteAllText("mapped_empty.txt", "").ThrowIfError();
+
+  auto file = MappedFile::Open("mapped_empty.txt").ValueOrThrow();
+  ASSERT_TRUE(file.IsEmpty());
+  ASSERT_EQ(file.Lines().begin(), file.Lines().end());
+}
+
+TEST(MappedFile, View) {
+  File::WriteAllText("mapped_view.txt", "Hello, mapping").ThrowIfError();
+
+  auto file = MappedFile::Open("mapped_view.txt", MappedFile::Access::Random).ValueOrThrow();
+  ASSERT_EQ(file.View(), "Hello, mapping");
+  ASSERT_EQ(file.Size(), 14);
+
+  file.Advise(MappedFile::Access::Normal);
+  file.WillNeed(3, 100);
+
+  auto moved = std::move(file);
+  ASSERT_EQ(moved.View(), "Hello, mapping");
+  ASSERT_TRUE(file.IsEmpty());
+}
+
+// Same lines as std::getline
+TEST(MappedFile, LinesMatchReadAllLines) {
+  const std::vector<std::string> texts = {
+      "single", "trailing\n", "a\nb\nc", "\n\nempty\n\n", "crlf\r\nkept\r\n", "\n",
+  };
+
+  for (auto&& text : texts) {
+    File::WriteAllText("mapped_lines.txt", text).ThrowIfError();
+    ASSERT_EQ(MappedLines("mapped_lines.txt"), File::ReadAllLines("mapped_lines.txt").ValueOrThrow())
+        << "text: " << text;
+  }
+}
+
+TEST(MappedFile, ManyLines) {
+  File::TextLines expected;
+  for (size_t index = 0; index < 100'000; ++index) {
+    expected.push_back(std::string(index % 97, 'x') + std::to_string(index));
+  }
+  File::WriteAllLines("mapped_many.txt", expected).ThrowIfError();
+
+  ASSERT_EQ(MappedLines("mapped_many.txt"), expected);
+}
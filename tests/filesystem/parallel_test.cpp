@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <magic/executors/thread_pool.h>
+#include <magic/filesystem/file.h>
+#include <magic/filesystem/parallel.h>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+static File::TextLines MakeLines(size_t count) {
+  File::TextLines lines;
+  for (size_t index = 0; index < count; ++index) {
+    lines.push_back(std::string(index % 31, 'x') + std::to_string(index));
+  }
+  return lines;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(SplitAtLines, ChunksAreLineAligned) {
+  std::string text;
+  for (auto&& line : MakeLines(1000)) {
+    text += line + '\n';
+  }
+
+  for (size_t chunks : {1, 2, 3, 7, 64, 5000}) {
+    auto parts = SplitAtLines(text, chunks);
+    ASSERT_LE(parts.size(), chunks);
+
+    std::string joined;
+    for (size_t index = 0; index < parts.size(); ++index) {
+      ASSERT_FALSE(parts[index].empty());
+      ASSERT_EQ(parts[index].back(), '\n');
+      joined += parts[index];
+    }
+    ASSERT_EQ(joined, text);
+  }
+}
+
+TEST(SplitAtLines, EdgeCases) {
+  ASSERT_TRUE(SplitAtLines("", 4).empty());
+
+  // A single long line cannot be split
+  auto parts = SplitAtLines("no line breaks at all", 4);
+  ASSERT_EQ(parts.size(), 1);
+
+  // The last chunk may end without a line break
+  parts = SplitAtLines("a\nb\nc", 3);
+  ASSERT_EQ(parts.size(), 3);
+  ASSERT_EQ(parts.back(), "c");
+}
+
+TEST(MapReduceLines, MatchesSequentialRead) {
+  const auto expected = MakeLines(100'000);
+  File::WriteAllLines("parallel_lines.txt", expected).ThrowIfError();
+
+  ThreadPool pool{4};
+
+  struct Stats {
+    size_t lines = 0;
+    size_t bytes = 0;
+  };
+
+  auto stats = MapReduceLines<Stats>(
+                   "parallel_lines.txt", pool,
+                   [](Stats& stats, std::string_view line) {
+                     ++stats.lines;
+                     stats.bytes += line.size();
+                   },
+                   [](Stats& total, Stats partial) {
+                     total.lines += partial.lines;
+                     total.bytes += partial.bytes;
+                   },
+                   {.MaxChunks = 16, .MinChunkSize = 1024})
+                   .ValueOrThrow();
+
+  ASSERT_EQ(stats.lines, expected.size());
+  ASSERT_EQ(stats.bytes, std::accumulate(expected.begin(), expected.end(), size_t{0},
+                                         [](size_t sum, const std::string& line) {
+                                           return sum + line.size();
+                                         }));
+  pool.Stop();
+}
+
+TEST(MapReduceLines, ReducesInFileOrder) {
+  const auto expected = MakeLines(10'000);
+  File::WriteAllLines("parallel_order.txt", expected).ThrowIfError();
+
+  ThreadPool pool{4};
+  auto lines = MapReduceLines<File::TextLines>(
+                   "parallel_order.txt", pool,
+                   [](File::TextLines& lines, std::string_view line) {
+                     lines.emplace_back(line);
+                   },
+                   [](File::TextLines& total, File::TextLines partial) {
+                     total.insert(total.end(), partial.begin(), partial.end());
+                   },
+                   {.MaxChunks = 32, .MinChunkSize = 1})
+                   .ValueOrThrow();
+
+  ASSERT_EQ(lines, expected);
+  pool.Stop();
+}
+
+TEST(MapReduceLines, Errors) {
+  ThreadPool pool{2};
+
+  auto missing = MapReduceLines<size_t>(
+      "parallel_missing.txt", pool, [](size_t&, std::string_view) {}, [](size_t&, size_t) {});
+  ASSERT_TRUE(missing.HasError());
+
+  File::WriteAllLines("parallel_throw.txt", MakeLines(1000)).ThrowIfError();
+  auto status = ParallelForEachLine(
+      "parallel_throw.txt", pool,
+      [](std::string_view line) {
+        if (line.ends_with("x999")) {
+          throw std::runtime_error("bad line");
+        }
+      },
+      {.MinChunkSize = 64});
+  ASSERT_TRUE(status.HasError());
+
+  pool.Stop();
+}
+
+TEST(ParallelForEachLine, VisitsEveryLine) {
+  File::WriteAllLines("parallel_each.txt", MakeLines(50'000)).ThrowIfError();
+
+  ThreadPool pool{4};
+  std::atomic<size_t> lines = 0;
+  ParallelForEachLine("parallel_each.txt", pool,
+                      [&lines](std::string_view) {
+                        lines.fetch_add(1, std::memory_order::relaxed);
+                      },
+                      {.MinChunkSize = 4096})
+      .ThrowIfError();
+
+  ASSERT_EQ(lines.load(), 50'000);
+  pool.Stop();
+}
@@ -9,9 +9,12 @@
 #include <magic/executors/manual.h>
 #include <magic/executors/thread_pool.h>
 
+#include <magic/futures/after.h>
 #include <magic/futures/core/future.h>
 #include <magic/futures/execute.h>
 #include <magic/futures/get.h>
+#include <magic/futures/latency.h>
+#include <magic/futures/semaphore.h>
 
 //////////////////////////////////////////////////////////////////////
 
@@ -529,4 +532,111 @@ TEST(Futures, AsyncThen) {
   pool2.Stop();
 
   ASSERT_EQ(value, 4);
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// Timers
+
+TEST(Futures, After) {
+  Stopwatch stopwatch;
+  auto f = futures::After(50ms);
+  ASSERT_FALSE(f.IsReady());
+
+  futures::WaitValue(std::move(f));
+  ASSERT_GE(stopwatch.Elapsed(), 50ms);
+}
+
+TEST(Futures, AfterOrdering) {
+  std::mutex mutex;
+  std::vector<int> fired;
+
+  auto [f, p] = MakeContract<Unit>();
+  for (int delay : {30, 10, 20}) {
+    futures::After(std::chrono::milliseconds(delay)).Subscribe([&, delay](Result<Unit>) {
+      std::lock_guard guard(mutex);
+      fired.push_back(delay);
+    });
+  }
+  futures::WaitValue(futures::After(60ms));
+
+  std::lock_guard guard(mutex);
+  ASSERT_EQ(fired, (std::vector<int>{10, 20, 30}));
+}
+
+TEST(Futures, RecordLatency) {
+  Histogram latency;
+
+  futures::WaitValue(futures::RecordLatency(futures::After(20ms), latency));
+
+  auto [f, p] = MakeContract<int>();
+  auto timed = futures::RecordLatency(std::move(f), latency);
+  std::move(p).SetError(TimeoutError());
+  ASSERT_TRUE(futures::WaitResult(std::move(timed)).HasError());
+
+  const auto snapshot = latency.Snapshot();
+  ASSERT_EQ(snapshot.Count(), 2);
+  ASSERT_GE(snapshot.Max(), 20'000'000);
+  ASSERT_LT(snapshot.Min(), 20'000'000);
+}
+
+//////////////////////////////////////////////////////////////////////
+
+// AsyncSemaphore
+
+TEST(AsyncSemaphore, GrantsInFifoOrder) {
+  futures::AsyncSemaphore semaphore{1};
+
+  auto first = semaphore.Acquire();
+  ASSERT_TRUE(first.IsReady());
+
+  auto second = semaphore.Acquire();
+  auto third = semaphore.Acquire();
+  ASSERT_FALSE(second.IsReady());
+  ASSERT_EQ(semaphore.Waiters(), 2);
+
+  semaphore.Release();
+  ASSERT_TRUE(second.IsReady());
+  ASSERT_FALSE(third.IsReady());
+
+  semaphore.Release();
+  ASSERT_TRUE(third.IsReady());
+
+  semaphore.Release();
+  ASSERT_EQ(semaphore.Available(), 1);
+}
+
+TEST(AsyncSemaphore, LimitsConcurrency) {
+  static const size_t kPermits = 3;
+  static const size_t kTasks = 100;
+
+  auto pool = ThreadPool{4};
+  futures::AsyncSemaphore semaphore{kPermits};
+
+  std::atomic<size_t> running = 0;
+  std::atomic<size_t> max_running = 0;
+
+  std::vector<Future<int>> results;
+  for (size_t index = 0; index < kTasks; ++index) {
+    results.push_back(semaphore.Acquire().Via(pool).Then([&](Unit) {
+      const auto now = running.fetch_add(1) + 1;
+      auto max = max_running.load();
+      while (now > max && !max_running.compare_exchange_weak(max, now)) {
+      }
+      std::this_thread::sleep_for(100us);
+      running.fetch_sub(1);
+      semaphore.Release();
+      return 1;
+    }));
+  }
+
+  int done = 0;
+  for (auto&& f : results) {
+    done += futures::WaitValue(std::move(f));
+  }
+  pool.Stop();
+
+  ASSERT_EQ(done, kTasks);
+  ASSERT_LE(max_running.load(), kPermits);
+  ASSERT_EQ(semaphore.Available(), kPermits);
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <magic/net/http/curl_pool.h>
+
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(CurlHandlePool, OriginOf) {
+  ASSERT_EQ(detail::OriginOf("http://example.com/path?q=1"), "http://example.com");
+  ASSERT_EQ(detail::OriginOf("https://example.com:8443"), "https://example.com:8443");
+  ASSERT_EQ(detail::OriginOf("192.168.1.2:3000/api/books"), "192.168.1.2:3000");
+  ASSERT_EQ(detail::OriginOf("http://host?query"), "http://host");
+}
+
+TEST(CurlHandlePool, ReusesHandlesPerOrigin) {
+  CurlHandlePool pool;
+
+  CURL* first = nullptr;
+  {
+    auto handle = pool.Acquire("http://a.test/one");
+    first = handle.Get();
+    ASSERT_NE(first, nullptr);
+  }
+  ASSERT_EQ(pool.IdleCount(), 1);
+
+  {
+    auto same_origin = pool.Acquire("http://a.test/two");
+    ASSERT_EQ(same_origin.Get(), first);
+
+    auto other_origin = pool.Acquire("http://b.test/");
+    ASSERT_NE(other_origin.Get(), first);
+  }
+
+  auto metrics = pool.GetMetrics();
+  ASSERT_EQ(metrics.Hits, 1);
+  ASSERT_EQ(metrics.Misses, 2);
+  ASSERT_EQ(pool.IdleCount(), 2);
+}
+
+TEST(CurlHandlePool, BoundsIdleHandles) {
+  CurlHandlePool pool;
+
+  {
+    std::vector<CurlHandlePool::Handle> handles;
+    for (size_t index = 0; index < 20; ++index) {
+      handles.push_back(pool.Acquire("http://a.test/"));
+    }
+  }
+
+  ASSERT_EQ(pool.IdleCount(), 16);
+  ASSERT_EQ(pool.GetMetrics().Evictions, 4);
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <magic/futures/get.h>
+#include <magic/net/http/client.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+// Listening socket that never accepts: connections complete in the kernel
+// backlog and requests hang until the client gives up on them
+class SilentListener final {
+ public:
+  SilentListener() : fd_(::socket(AF_INET, SOCK_STREAM, 0)) {
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ::bind(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+    ::listen(fd_, 128);
+
+    socklen_t length = sizeof(address);
+    ::getsockname(fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+  }
+
+  ~SilentListener() {
+    ::close(fd_);
+  }
+
+  std::string Url() const {
+    return "http://127.0.0.1:" + std::to_string(port_) + "/";
+  }
+
+ private:
+  int fd_;
+  uint16_t port_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(HttpClient, ConnectionRefused) {
+  HttpClient client;
+
+  // Port 1 is privileged and not listening
+  auto result = futures::WaitResult(client.Get("http://127.0.0.1:1/"));
+  ASSERT_TRUE(result.HasError());
+  ASSERT_EQ(client.InFlight(), 0);
+}
+
+TEST(HttpClient, ManyConcurrentFailures) {
+  HttpClient client;
+
+  std::vector<Future<HttpResponse>> responses;
+  for (size_t index = 0; index < 64; ++index) {
+    responses.push_back(client.PostJson("http://127.0.0.1:1/", "{}"));
+  }
+  for (auto&& f : responses) {
+    ASSERT_TRUE(futures::WaitResult(std::move(f)).HasError());
+  }
+  ASSERT_EQ(client.InFlight(), 0);
+}
+
+TEST(HttpClient, AbortsPendingOnShutdown) {
+  SilentListener listener;
+
+  std::vector<Future<HttpResponse>> responses;
+  {
+    HttpClient client;
+    for (size_t index = 0; index < 8; ++index) {
+      responses.push_back(client.Get(listener.Url()));
+    }
+    ASSERT_EQ(client.InFlight(), 8);
+  }
+
+  for (auto&& f : responses) {
+    ASSERT_TRUE(futures::WaitResult(std::move(f)).HasError());
+  }
+}
@@ -10,8 +10,8 @@
 #include <magic/fibers/api.h>
 
 #include <magic/net/http.h>
-#include <magic/net/core/format.h>
-#include <magic/net/core/header.h>
+#include <magic/net/http/format.h>
+#include <magic/net/http/header.h>
 
 //////////////////////////////////////////////////////////////////////
 
@@ -35,4 +35,63 @@ TEST(HttpHeader, JustWork) {
   ASSERT_EQ(header["Date"], "Mon, 17 Apr 2023 18:32:32 GMT");
   ASSERT_EQ(header["Connection"], "keep-alive");
   ASSERT_EQ(header["Keep-Alive"], "timeout=5");
-}
\ No newline at end of file
+}
+
+TEST(HttpHeader, CaseInsensitive) {
+  auto header = HttpHeader::Parse("HTTP/1.1 200 OK\r\ncontent-type: text/plain\r\n\r\n");
+
+  ASSERT_EQ(header["Content-Type"], "text/plain");
+  ASSERT_EQ(header["CONTENT-TYPE"], "text/plain");
+  ASSERT_TRUE(header.Contains("content-type"));
+  ASSERT_FALSE(header.Contains("Content-Length"));
+  ASSERT_EQ(header["Content-Length"], "");
+}
+
+TEST(HttpHeader, KeepsLastResponse) {
+  auto header = HttpHeader::Parse(
+      "HTTP/1.1 301 Moved Permanently\r\n"
+      "Location: https://example.com/\r\n"
+      "Content-Length: 0\r\n"
+      "\r\n"
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Length: 42\r\n"
+      "\r\n");
+
+  ASSERT_EQ(header.Size(), 1);
+  ASSERT_EQ(header["Content-Length"], "42");
+  ASSERT_FALSE(header.Find("Location").has_value());
+}
+
+TEST(HttpHeader, RepeatedField) {
+  auto header = HttpHeader::Parse(
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: text/plain\r\n"
+      "Content-Length: 2\r\n"
+      "content-type: application/json\r\n"
+      "\r\n");
+
+  // The later field overrides the earlier one
+  ASSERT_EQ(header["Content-Type"], "application/json");
+  ASSERT_EQ(header.Find("CONTENT-TYPE"), "application/json");
+  ASSERT_EQ(header["Content-Length"], "2");
+  ASSERT_EQ(header.Size(), 3);
+}
+
+TEST(HttpHeader, Iterate) {
+  auto header = HttpHeader::Parse(
+      "HTTP/1.1 200 OK\r\n"
+      "Set-Cookie: a=1\r\n"
+      "Set-Cookie: b=2\r\n"
+      "Empty:\r\n"
+      "\r\n");
+
+  std::vector<std::pair<std::string_view, std::string_view>> fields(header.begin(), header.end());
+  ASSERT_EQ(fields.size(), 3);
+  ASSERT_EQ(fields[1].first, "Set-Cookie");
+  ASSERT_EQ(fields[1].second, "b=2");
+  ASSERT_EQ(fields[2].second, "");
+
+  // Last match wins
+  ASSERT_EQ(header["set-cookie"], "b=2");
+  ASSERT_EQ(fmt::format("{}", header), "Set-Cookie: a=1\nSet-Cookie: b=2\nEmpty: \n");
+}
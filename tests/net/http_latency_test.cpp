@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../test_helper.h"
+
+#include <magic/executors/thread_pool.h>
+#include <magic/net/http.h>
+#include <magic/net/http/request_builder.h>
+#include <magic/net/http/server.h>
+
+#include <thread>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(HttpLatencyRegistry, Summary) {
+  auto& registry = HttpLatencyRegistry::Instance();
+  const std::string url = "http://summary.test:8080/path";
+  ASSERT_EQ(registry.Summary(url).Count, 0);
+
+  // 1ms .. 1000ms
+  for (size_t millis = 1; millis <= 1000; ++millis) {
+    registry.Record(url, std::chrono::milliseconds(millis));
+  }
+
+  auto summary = registry.Summary("http://summary.test:8080/other");
+  ASSERT_EQ(summary.Count, 1000);
+  ASSERT_NEAR(summary.Mean.count(), 0.5005, 1e-6);
+  ASSERT_NEAR(summary.Max.count(), 1.0, 1e-6);
+
+  // Relative error of a bucket is 1/128
+  ASSERT_NEAR(summary.P50.count(), 0.5, 0.5 / 128);
+  ASSERT_NEAR(summary.P90.count(), 0.9, 0.9 / 128);
+  ASSERT_NEAR(summary.P99.count(), 0.99, 0.99 / 128);
+  ASSERT_GE(summary.P50.count(), 0.5);
+
+  ASSERT_EQ(registry.Snapshot(url).Max(), 1'000'000'000);
+
+  registry.Reset();
+  ASSERT_EQ(registry.Summary(url).Count, 0);
+}
+
+TEST(HttpLatencyRegistry, RecordsPerOrigin) {
+  TestBackend backend([](const HttpServerRequest&) {
+    return HttpServerResponse{.Body = "ok"};
+  });
+
+  HttpLatencyRegistry::Instance().Reset();
+  for (size_t index = 0; index < 10; ++index) {
+    ASSERT_TRUE(Http::Get(backend.Url("/path/" + std::to_string(index))).IsOk());
+  }
+
+  auto summary = Http::GetLatency(backend.Url("/"));
+  ASSERT_EQ(summary.Count, 10);
+  ASSERT_GT(summary.Max, Duration::zero());
+  ASSERT_LE(summary.P50, summary.Max);
+
+  ASSERT_EQ(Http::GetLatency("http://127.0.0.1:1/").Count, 0);
+}
+
+TEST(HttpRequestMetrics, Breakdown) {
+  TestBackend backend([](const HttpServerRequest&) {
+    std::this_thread::sleep_for(20ms);
+    return HttpServerResponse{.Body = "ok"};
+  });
+
+  auto response = Http::Get(backend.Url("/slow"));
+  auto& metrics = response.GetMetrics();
+
+  ASSERT_EQ(response.GetUrl(), backend.Url("/slow"));
+  ASSERT_LE(metrics.NameLookup.Value, metrics.Connect.Value);
+  ASSERT_LE(metrics.Connect.Value, metrics.PreTransfer.Value);
+  ASSERT_LE(metrics.PreTransfer.Value, metrics.StartTransfer.Value);
+  ASSERT_LE(metrics.StartTransfer.Value, metrics.Duration.Value);
+  // The handler delay is time to first byte
+  ASSERT_GE(metrics.StartTransfer.Value, 20ms);
+  ASSERT_EQ(metrics.AppConnect.Value, Duration::zero());
+  ASSERT_EQ(metrics.RedirectCount, 0);
+}
+
+TEST(HttpRequestBuilder, TotalTimeout) {
+  TestBackend backend([](const HttpServerRequest&) {
+    std::this_thread::sleep_for(300ms);
+    return HttpServerResponse{.Body = "late"};
+  });
+
+  auto request = HttpRequestBuilder().Get(backend.Url("/stall")).SetTimeout(50ms).Build();
+  auto result = request.Run();
+
+  ASSERT_TRUE(result.HasError());
+  ASSERT_EQ(result.Error().ErrorCode(), curl::easy::make_error_code(CURLE_OPERATION_TIMEDOUT));
+}
+
+TEST(HttpRequestBuilder, ConnectTimeoutIsApplied) {
+  TestBackend backend([](const HttpServerRequest&) {
+    return HttpServerResponse{.Body = "ok"};
+  });
+
+  auto request = HttpRequestBuilder()
+                     .Get(backend.Url("/fast"))
+                     .SetConnectTimeout(1s)
+                     .SetTimeout(5s)
+                     .SetLowSpeedLimit(1, 1s)
+                     .Build();
+  auto result = request.Run();
+
+  ASSERT_TRUE(result.IsOk());
+  ASSERT_EQ(result->GetContent(), "ok");
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "../test_helper.h"
+
+#include <magic/common/stopwatch.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/futures/get.h>
+#include <magic/net/http/scheduler.h>
+#include <magic/net/http/server.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(HttpRequestScheduler, PerHostConcurrencyLimit) {
+  std::atomic<size_t> running = 0;
+  std::atomic<size_t> max_running = 0;
+
+  TestBackend backend([&](const HttpServerRequest&) {
+    const auto now = running.fetch_add(1) + 1;
+    auto max = max_running.load();
+    while (now > max && !max_running.compare_exchange_weak(max, now)) {
+    }
+    std::this_thread::sleep_for(5ms);
+    running.fetch_sub(1);
+    return HttpServerResponse{.Body = "ok"};
+  });
+
+  HttpRequestScheduler scheduler{{.MaxInFlightPerHost = 3, .Hedging = false}};
+
+  std::vector<std::string> urls(30, backend.Url("/replica"));
+  size_t ok = 0;
+  for (auto&& f : scheduler.FanOut(GetInlineExecutor(), urls)) {
+    ok += futures::WaitValue(std::move(f)).GetContent() == "ok";
+  }
+
+  ASSERT_EQ(ok, urls.size());
+  ASSERT_LE(max_running.load(), 3);
+  ASSERT_EQ(scheduler.GetMetrics().Requests, urls.size());
+
+  const auto latency = scheduler.GetLatency();
+  ASSERT_EQ(latency.Count(), urls.size());
+  ASSERT_GE(latency.Min(), 5'000'000);
+  ASSERT_LE(latency.Percentile(50), latency.Max());
+}
+
+TEST(HttpRequestScheduler, RetriesServerErrors) {
+  std::atomic<size_t> attempts = 0;
+
+  TestBackend backend([&](const HttpServerRequest&) {
+    if (attempts.fetch_add(1) < 2) {
+      return HttpServerResponse{.Status = HttpStatus::Code::ServiceUnavailable};
+    }
+    return HttpServerResponse{.Body = "recovered"};
+  });
+
+  HttpRequestScheduler scheduler{{.Hedging = false, .MaxAttempts = 3, .BaseBackoff = 1ms}};
+  auto response = futures::WaitValue(scheduler.Get(backend.Url("/flaky")));
+
+  ASSERT_EQ(response.GetContent(), "recovered");
+  ASSERT_EQ(attempts.load(), 3);
+  ASSERT_EQ(scheduler.GetMetrics().Retries, 2);
+}
+
+TEST(HttpRequestScheduler, GivesUpAfterMaxAttempts) {
+  TestBackend backend([](const HttpServerRequest&) {
+    return HttpServerResponse{.Status = HttpStatus::Code::InternalServerError};
+  });
+
+  HttpRequestScheduler scheduler{{.Hedging = false, .MaxAttempts = 2, .BaseBackoff = 1ms}};
+  auto response = futures::WaitValue(scheduler.Get(backend.Url("/broken")));
+
+  // The last response is returned as is
+  ASSERT_EQ(response.GetStatus(), HttpStatus::Code::InternalServerError);
+  ASSERT_EQ(scheduler.GetMetrics().Failures, 1);
+
+  // Transport errors surface as errors
+  auto refused = futures::WaitResult(scheduler.Get("http://127.0.0.1:1/"));
+  ASSERT_TRUE(refused.HasError());
+}
+
+TEST(HttpRequestScheduler, HedgeWinsOverSlowCopy) {
+  std::atomic<size_t> requests = 0;
+
+  TestBackend backend([&](const HttpServerRequest&) {
+    // The first copy stalls, the backup is fast
+    if (requests.fetch_add(1) == 0) {
+      std::this_thread::sleep_for(500ms);
+      return HttpServerResponse{.Body = "slow"};
+    }
+    return HttpServerResponse{.Body = "fast"};
+  });
+
+  HttpRequestScheduler scheduler{{.Hedging = true, .DefaultHedgeDelay = 20ms}};
+
+  Stopwatch stopwatch;
+  auto response = futures::WaitValue(scheduler.Get(backend.Url("/hedged")));
+
+  ASSERT_EQ(response.GetContent(), "fast");
+  ASSERT_LT(stopwatch.Elapsed(), 400ms);
+
+  auto metrics = scheduler.GetMetrics();
+  ASSERT_EQ(metrics.Hedges, 1);
+  ASSERT_EQ(metrics.HedgeWins, 1);
+}
+
+TEST(HttpRequestScheduler, HedgeDelayFollowsLatency) {
+  TestBackend backend([](const HttpServerRequest&) {
+    return HttpServerResponse{.Body = "ok"};
+  });
+
+  // Pending hedge timers of completed calls must not delay the destructor
+  HttpRequestScheduler scheduler{{.DefaultHedgeDelay = 10s}};
+  const auto url = backend.Url("/fast");
+  ASSERT_EQ(scheduler.HedgeDelay(url), 10s);
+
+  for (size_t index = 0; index < 32; ++index) {
+    futures::WaitValue(scheduler.Get(url));
+  }
+  ASSERT_LT(scheduler.HedgeDelay(url), 1s);
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <magic/executors/thread_pool.h>
+#include <magic/net/http.h>
+#include <magic/net/http/server.h>
+#include <magic/net/socket.h>
+
+#include <string>
+
+using namespace magic;
+
+//////////////////////////////////////////////////////////////////////
+
+static HttpServerResponse Echo(const HttpServerRequest& request) {
+  if (request.Target == "/missing") {
+    return {.Status = HttpStatus::Code::NotFound};
+  }
+  if (request.Target == "/throw") {
+    throw std::runtime_error("handler failure");
+  }
+  return {.Body = std::string(request.Method) + " " + std::string(request.Target) + " " +
+                  std::string(request.Body)};
+}
+
+static net::Socket Connect(uint16_t port) {
+  return net::Socket::Connect("127.0.0.1", port).ValueOrThrow();
+}
+
+// Reads until the peer closes the connection
+static std::string ReadToEnd(net::Socket& socket) {
+  std::string data;
+  char buffer[4096];
+  while (true) {
+    auto bytes = socket.ReadSome(buffer, sizeof(buffer));
+    if (bytes.HasError() || *bytes == 0) {
+      return data;
+    }
+    data.append(buffer, *bytes);
+  }
+}
+
+static size_t CountOf(std::string_view haystack, std::string_view needle) {
+  size_t count = 0;
+  for (auto pos = haystack.find(needle); pos != std::string_view::npos;
+       pos = haystack.find(needle, pos + 1)) {
+    ++count;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(HttpServer, CurlClient) {
+  ThreadPool scheduler{2};
+  HttpServer server{scheduler, Echo};
+  ASSERT_TRUE(server.Start("127.0.0.1", 0).IsOk());
+
+  const auto url = "http://127.0.0.1:" + std::to_string(server.Port());
+
+  auto response = Http::Get(url + "/hello");
+  ASSERT_TRUE(response.IsOk());
+  ASSERT_EQ(response.GetContent(), "GET /hello ");
+
+  auto posted = Http::PostJson(url + "/items", "{\"id\":1}");
+  ASSERT_EQ(posted.GetContent(), "POST /items {\"id\":1}");
+
+  auto missing = Http::Get(url + "/missing");
+  ASSERT_EQ(missing.GetStatus(), HttpStatus::Code::NotFound);
+
+  auto failed = Http::Get(url + "/throw");
+  ASSERT_EQ(failed.GetStatus(), HttpStatus::Code::InternalServerError);
+
+  server.Stop();
+  scheduler.Stop();
+}
+
+TEST(HttpServer, Pipelining) {
+  ThreadPool scheduler{2};
+  HttpServer server{scheduler, Echo};
+  ASSERT_TRUE(server.Start("127.0.0.1", 0).IsOk());
+
+  auto socket = Connect(server.Port());
+
+  std::string requests;
+  for (size_t index = 0; index < 10; ++index) {
+    requests += "GET /" + std::to_string(index) + " HTTP/1.1\r\nHost: test\r\n\r\n";
+  }
+  requests += "POST /last HTTP/1.1\r\nContent-Length: 4\r\nConnection: close\r\n\r\nbody";
+  ASSERT_TRUE(socket.WriteAll(requests).IsOk());
+
+  const auto responses = ReadToEnd(socket);
+  ASSERT_EQ(CountOf(responses, "HTTP/1.1 200 OK"), 11);
+  ASSERT_NE(responses.find("GET /0 "), std::string::npos);
+  ASSERT_NE(responses.find("GET /9 "), std::string::npos);
+  ASSERT_NE(responses.find("POST /last body"), std::string::npos);
+  ASSERT_EQ(CountOf(responses, "Connection: close"), 1);
+
+  server.Stop();
+  scheduler.Stop();
+}
+
+TEST(HttpServer, SplitRequest) {
+  ThreadPool scheduler{1};
+  HttpServer server{scheduler, Echo};
+  ASSERT_TRUE(server.Start("127.0.0.1", 0).IsOk());
+
+  auto socket = Connect(server.Port());
+  const std::string request = "POST /split HTTP/1.0\r\nContent-Length: 5\r\n\r\nhello";
+  for (char ch : request) {
+    ASSERT_TRUE(socket.WriteAll({&ch, 1}).IsOk());
+  }
+
+  // HTTP/1.0 closes the connection after the response
+  const auto response = ReadToEnd(socket);
+  ASSERT_NE(response.find("POST /split hello"), std::string::npos);
+
+  server.Stop();
+  scheduler.Stop();
+}
+
+TEST(HttpServer, MalformedRequest) {
+  ThreadPool scheduler{1};
+  HttpServer server{scheduler, Echo};
+  ASSERT_TRUE(server.Start("127.0.0.1", 0).IsOk());
+
+  auto socket = Connect(server.Port());
+  ASSERT_TRUE(socket.WriteAll("garbage\r\n\r\n").IsOk());
+  ASSERT_NE(ReadToEnd(socket).find("400"), std::string::npos);
+
+  auto chunked = Connect(server.Port());
+  ASSERT_TRUE(
+      chunked.WriteAll("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n0\r\n\r\n").IsOk());
+  ASSERT_NE(ReadToEnd(chunked).find("501"), std::string::npos);
+
+  server.Stop();
+  scheduler.Stop();
+}
+
+TEST(HttpServer, StopClosesIdleConnections) {
+  ThreadPool scheduler{2};
+  HttpServer server{scheduler, Echo};
+  ASSERT_TRUE(server.Start("127.0.0.1", 0).IsOk());
+
+  std::vector<net::Socket> clients;
+  for (size_t index = 0; index < 8; ++index) {
+    clients.push_back(Connect(server.Port()));
+    ASSERT_TRUE(clients.back().WriteAll("GET / HTTP/1.1\r\n\r\n").IsOk());
+  }
+
+  // Every connection has been served once and stays open
+  char buffer[256];
+  for (auto&& client : clients) {
+    ASSERT_GT(*client.ReadSome(buffer, sizeof(buffer)), 0);
+  }
+  ASSERT_EQ(server.ActiveConnections(), 8);
+
+  server.Stop();
+  ASSERT_EQ(server.ActiveConnections(), 0);
+  scheduler.Stop();
+}
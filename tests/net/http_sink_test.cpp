@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <magic/net/http.h>
+#include <magic/net/http/sink.h>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(BodyChannel, DeliversChunksInOrder) {
+  BodyChannel channel{16};
+
+  std::thread producer([&] {
+    for (size_t index = 0; index < 100; ++index) {
+      ASSERT_TRUE(channel.Write(std::to_string(index)));
+    }
+    channel.Close({});
+  });
+
+  std::string expected, received;
+  for (size_t index = 0; index < 100; ++index) {
+    expected += std::to_string(index);
+  }
+  while (auto chunk = channel.Take()) {
+    received += *chunk;
+  }
+  producer.join();
+
+  ASSERT_EQ(received, expected);
+  ASSERT_FALSE(channel.Error());
+}
+
+TEST(BodyChannel, Backpressure) {
+  BodyChannel channel{8};
+  std::atomic<size_t> written = 0;
+
+  std::thread producer([&] {
+    for (size_t index = 0; index < 4; ++index) {
+      channel.Write("abcd");
+      written.fetch_add(1);
+    }
+    channel.Close({});
+  });
+
+  // The producer stops once two chunks fill the capacity
+  while (written.load() < 2) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(50ms);
+  ASSERT_EQ(written.load(), 2);
+
+  size_t chunks = 0;
+  while (channel.Take()) {
+    ++chunks;
+  }
+  producer.join();
+
+  ASSERT_EQ(chunks, 4);
+}
+
+TEST(BodyChannel, OversizedChunk) {
+  BodyChannel channel{4};
+  ASSERT_TRUE(channel.Write("0123456789"));
+  ASSERT_EQ(*channel.Take(), "0123456789");
+}
+
+TEST(BodyChannel, CancelAbortsProducer) {
+  BodyChannel channel{4};
+  ASSERT_TRUE(channel.Write("abcd"));
+
+  std::thread producer([&] {
+    // Blocks until cancelled
+    ASSERT_FALSE(channel.Write("efgh"));
+  });
+
+  channel.Cancel();
+  producer.join();
+  ASSERT_FALSE(channel.Take().has_value());
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(CallbackSink, ForwardsChunks) {
+  size_t bytes = 0;
+  CallbackSink sink([&bytes](std::string_view chunk) {
+    bytes += chunk.size();
+    return bytes < 8;
+  });
+
+  ASSERT_TRUE(sink.Write("abc"));
+  ASSERT_FALSE(sink.Write("defgh"));
+  ASSERT_EQ(bytes, 8);
+}
+
+TEST(ProcessorSink, ResumesConsumer) {
+  std::string received;
+  Processor<std::string_view> processor([&received] {
+    while (auto chunk = Receive<std::string_view>()) {
+      received += *chunk;
+    }
+    received += "$";
+  });
+
+  ProcessorSink sink(processor);
+  sink.Write("hello ");
+  sink.Write("world");
+  sink.Close({});
+
+  ASSERT_EQ(received, "hello world$");
+}
+
+TEST(FileSink, WritesChunks) {
+  const std::string path = "http_sink_test.bin";
+  {
+    FileSink sink(path);
+    ASSERT_TRUE(sink.IsOpen());
+    sink.Write("first ");
+    sink.Write("second");
+    sink.Close({});
+  }
+
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream content;
+  content << file.rdbuf();
+  ASSERT_EQ(content.str(), "first second");
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(Http, DownloadReportsErrorToSink) {
+  BodyChannel channel;
+  // Port 1 is privileged and not listening
+  ASSERT_ANY_THROW(Http::Download("http://127.0.0.1:1/", channel));
+
+  ASSERT_FALSE(channel.Take().has_value());
+  ASSERT_TRUE(channel.Error());
+}
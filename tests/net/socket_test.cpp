@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <magic/common/stopwatch.h>
+#include <magic/concurrency/atomic_counter.h>
+#include <magic/executors/thread_pool.h>
+#include <magic/fibers/api.h>
+#include <magic/net/socket.h>
+
+#include <string>
+#include <vector>
+
+using namespace magic;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////////////////////////
+
+// Echoes every connection on its own fiber until the acceptor is shut down
+class EchoServer final {
+ public:
+  explicit EchoServer(IExecutor& scheduler) {
+    acceptor_.Listen("127.0.0.1", 0).ThrowIfError();
+    running_.Add();
+    Go(scheduler, [this] {
+      while (true) {
+        auto socket = acceptor_.Accept();
+        if (socket.HasError()) {
+          break;
+        }
+        running_.Add();
+        Go([this, socket = std::move(*socket)]() mutable {
+          char buffer[4096];
+          while (true) {
+            auto bytes = socket.ReadSome(buffer, sizeof(buffer));
+            if (bytes.HasError() || *bytes == 0) {
+              break;
+            }
+            if (socket.WriteAll({buffer, *bytes}).HasError()) {
+              break;
+            }
+          }
+          socket.Close();
+          running_.Done();
+        });
+      }
+      running_.Done();
+    });
+  }
+
+  ~EchoServer() {
+    acceptor_.Shutdown();
+    running_.WaitZero();
+  }
+
+  uint16_t Port() const {
+    return acceptor_.Port();
+  }
+
+ private:
+  net::Acceptor acceptor_;
+  AtomicCounter running_;
+};
+
+static std::string ReadExactly(net::Socket& socket, size_t size) {
+  std::string data(size, '\0');
+  size_t filled = 0;
+  while (filled < size) {
+    auto bytes = socket.ReadSome(data.data() + filled, size - filled);
+    if (bytes.HasError() || *bytes == 0) {
+      break;
+    }
+    filled += *bytes;
+  }
+  data.resize(filled);
+  return data;
+}
+
+//////////////////////////////////////////////////////////////////////
+
+TEST(Socket, EchoFromThread) {
+  ThreadPool scheduler{2};
+  {
+    EchoServer server{scheduler};
+
+    auto socket = net::Socket::Connect("127.0.0.1", server.Port()).ValueOrThrow();
+    ASSERT_TRUE(socket.WriteAll("hello").IsOk());
+    ASSERT_EQ(ReadExactly(socket, 5), "hello");
+    socket.ShutdownWrite();
+
+    char buffer[16];
+    ASSERT_EQ(*socket.ReadSome(buffer, sizeof(buffer)), 0);
+  }
+  scheduler.Stop();
+}
+
+TEST(Socket, ManyFiberClients) {
+  static const size_t kClients = 100;
+  static const size_t kRounds = 20;
+
+  ThreadPool scheduler{2};
+  {
+    EchoServer server{scheduler};
+    AtomicCounter clients;
+    std::atomic<size_t> echoed = 0;
+
+    for (size_t client = 0; client < kClients; ++client) {
+      clients.Add();
+      Go(scheduler, [&, client] {
+        auto socket = net::Socket::Connect("127.0.0.1", server.Port()).ValueOrThrow();
+        for (size_t round = 0; round < kRounds; ++round) {
+          const auto message = std::to_string(client) + ":" + std::to_string(round);
+          WHEELS_VERIFY(socket.WriteAll(message).IsOk(), "Write failed");
+          if (ReadExactly(socket, message.size()) == message) {
+            echoed.fetch_add(1);
+          }
+        }
+        socket.Close();
+        clients.Done();
+      });
+    }
+    clients.WaitZero();
+    ASSERT_EQ(echoed.load(), kClients * kRounds);
+  }
+  scheduler.Stop();
+}
+
+TEST(Socket, VectoredIo) {
+  ThreadPool scheduler{1};
+  {
+    EchoServer server{scheduler};
+    auto socket = net::Socket::Connect("127.0.0.1", server.Port()).ValueOrThrow();
+
+    std::string head = "head-", empty, tail = std::string(100'000, 'x');
+    iovec out[] = {{head.data(), head.size()}, {empty.data(), 0}, {tail.data(), tail.size()}};
+    ASSERT_TRUE(socket.WriteV(out).IsOk());
+
+    // Scatter the echo into two buffers
+    std::string first(5, '\0');
+    std::string second(tail.size(), '\0');
+    size_t filled = 0;
+    while (filled < first.size() + second.size()) {
+      std::vector<iovec> in;
+      if (filled < first.size()) {
+        in.push_back({first.data() + filled, first.size() - filled});
+        in.push_back({second.data(), second.size()});
+      } else {
+        const auto offset = filled - first.size();
+        in.push_back({second.data() + offset, second.size() - offset});
+      }
+      auto bytes = socket.ReadV(in);
+      ASSERT_TRUE(bytes.IsOk() && *bytes > 0);
+      filled += *bytes;
+    }
+
+    ASSERT_EQ(first, head);
+    ASSERT_EQ(second, tail);
+  }
+  scheduler.Stop();
+}
+
+TEST(Socket, ReadTimeout) {
+  ThreadPool scheduler{1};
+  {
+    EchoServer server{scheduler};
+
+    std::atomic<bool> timed_out = false;
+    AtomicCounter done;
+    done.Add();
+    Go(scheduler, [&] {
+      auto socket = net::Socket::Connect("127.0.0.1", server.Port()).ValueOrThrow();
+      socket.SetReadTimeout(50ms);
+
+      Stopwatch stopwatch;
+      char buffer[16];
+      auto bytes = socket.ReadSome(buffer, sizeof(buffer));
+      timed_out = bytes.HasError() &&
+                  bytes.ErrorCode() == std::make_error_code(std::errc::timed_out) &&
+                  stopwatch.Elapsed() >= 50ms;
+      done.Done();
+    });
+    done.WaitZero();
+
+    ASSERT_TRUE(timed_out.load());
+  }
+  scheduler.Stop();
+}
+
+TEST(Socket, AcceptTimeout) {
+  net::Acceptor acceptor;
+  ASSERT_TRUE(acceptor.Listen("127.0.0.1", 0).IsOk());
+  acceptor.SetAcceptTimeout(20ms);
+
+  auto socket = acceptor.Accept();
+  ASSERT_TRUE(socket.HasError());
+  ASSERT_EQ(socket.ErrorCode(), std::make_error_code(std::errc::timed_out));
+}
+
+TEST(Socket, ConnectRefused) {
+  auto socket = net::Socket::Connect("127.0.0.1", 1);
+  ASSERT_TRUE(socket.HasError());
+  ASSERT_TRUE(socket.ErrorCode() == std::errc::connection_refused);
+
+  ASSERT_TRUE(net::Socket::Connect("not an address", 80).HasError());
+}
@@ -4,7 +4,13 @@
 #include <fmt/chrono.h>
 
 #include <magic/common/stopwatch.h>
+#include <magic/executors/thread_pool.h>
 #include <magic/fibers/core/stack.h>
+#include <magic/filesystem/mapped_file.h>
+#include <magic/net/http/server.h>
+
+#include <string>
+#include <string_view>
 
 using namespace magic;
 using namespace std::string_literals;
@@ -49,4 +55,34 @@ struct NonDefaultConstructable {
   }
 
   int value{0};
-};
\ No newline at end of file
+};
+
+
+// Whole content of the file, through the page cache like any reader
+std::string ReadText(std::string_view path) {
+  return std::string(MappedFile::Open(path).ValueOrThrow().View());
+}
+
+// Loopback HTTP server on an ephemeral port
+// Handlers may block a scheduler thread to simulate slow backends,
+// the default pool is large enough for every test
+class TestBackend final {
+ public:
+  explicit TestBackend(HttpHandler handler, size_t threads = 16)
+      : scheduler_(threads), server_(scheduler_, std::move(handler)) {
+    server_.Start("127.0.0.1", 0).ThrowIfError();
+  }
+
+  ~TestBackend() {
+    server_.Stop();
+    scheduler_.Stop();
+  }
+
+  std::string Url(std::string_view path) const {
+    return "http://127.0.0.1:" + std::to_string(server_.Port()) + std::string(path);
+  }
+
+ private:
+  ThreadPool scheduler_;
+  HttpServer server_;
+};